@@ -5,6 +5,14 @@ public interface IPrintJob : IDisposable
     void Begin();
     void PrintPage(int pageNumber, Action<IGraphicsContext, int> renderPage);
 
+    /// <summary>
+    ///     Tells the job whether the queued render delegates may run concurrently for different pages (the
+    ///     document's content engine paints reentrantly). Backends that render one page at a time ignore it.
+    /// </summary>
+    void SetConcurrentPainting(bool supported)
+    {
+    }
+
     /// <summary>
     ///     Completes the job: renders/submits all queued pages and returns the outcome. Asynchronous
     ///     so backends that hand off to an external spooler (lpr/CUPS) or a UI print controller can
@@ -1,6 +1,7 @@
 // Copyright Kindel, LLC - http://www.kindel.com
 // Published under the MIT License at https://github.com/tig/winprint
 
+using System.Diagnostics;
 using System.Drawing;
 using System.Runtime.InteropServices;
 using libvt100;
@@ -27,7 +28,22 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
     // but text/plain resolves to the default CTE (TextMate); AnsiCte is selected for text/ansi.
     private static readonly string[] s_supportedContentTypes = ["text/plain", "text/ansi"];
 
+    private static readonly TimeSpan s_publishInterval = TimeSpan.FromMilliseconds(100);
+
+    // Guards the decoded lines/checkpoints and the layout shared by the reflow thread and PaintPage.
+    private readonly Lock _pagesLock = new();
+
+    // Guards the page decoder (_pageChunks, _pageDecoder, _pageScreen), which reads the file; held without
+    // _pagesLock so the reflow isn't blocked on disk reads made for a page being painted.
+    private readonly Lock _pageDecodeLock = new();
+
     private GraphicsSizeF _charSize;
+
+    // When streaming from a DocumentSource only checkpoints are kept; pages are re-decoded on demand.
+    private List<AnsiDecodeCheckpoint>? _checkpoints;
+
+    // Changes whenever checkpoints are replaced or dropped, so a page decode started from one is restarted.
+    private int _checkpointsVersion;
     private bool _disposed;
     private int _dpiY = 96;
     private float _lineHeight;
@@ -35,11 +51,25 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
     private int _linesPerPage;
     private int _minLineLen;
 
-    // The decoded screen (all lines, after libvt100 reflow/wrapping).
+    // Streaming: the decode PaintPage continues from page to page (null once the end of the file is reached).
+    private IEnumerator<byte[]>? _pageChunks;
+    private IAnsiDecoder? _pageDecoder;
+    private DynamicScreen? _pageScreen;
+    private int _pageVersion;
+
+    // The decoded screen (all lines, after libvt100 reflow/wrapping) of an in-memory document.
     private DynamicScreen? _screen;
 
     public override string[] SupportedContentTypes => s_supportedContentTypes;
 
+    public override bool SupportsDocumentSource => true;
+
+    /// <summary>
+    ///     Characters (in-memory document) or bytes (<see cref="ContentTypeEngineBase.DocumentSource" />) fed to
+    ///     the decoder at a time. Tests lower it to exercise checkpoints on small inputs.
+    /// </summary>
+    internal int DecodeChunkSize { get; set; } = 64 * 1024;
+
     public void Dispose()
     {
         Dispose(true);
@@ -55,7 +85,16 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
 
         if (disposing)
         {
-            _screen = null;
+            lock (_pagesLock)
+            {
+                _screen = null;
+                _checkpoints = null;
+            }
+
+            lock (_pageDecodeLock)
+            {
+                ResetPageDecoderLocked();
+            }
         }
 
         _disposed = true;
@@ -68,14 +107,17 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
     }
 
     /// <summary>
-    ///     Decodes the document into a <see cref="DynamicScreen" /> and returns the page count.
+    ///     Decodes the document into a <see cref="DynamicScreen" /> and returns the page count. Pages are
+    ///     published as they fill (see <see cref="ContentTypeEngineBase.PublishPages" />), so the first can be
+    ///     painted while the rest of a large capture is still being decoded. Decoding stops at the next chunk
+    ///     once <paramref name="cancellationToken" /> is canceled.
     /// </summary>
     public override async Task<int> RenderAsync(PrintResolution? printerResolution,
-        EventHandler<string>? reflowProgress)
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken = default)
     {
         LogService.TraceMessage();
 
-        if (Document is null)
+        if (Document is null && DocumentSource is null)
         {
             throw new InvalidOperationException("Document can't be null for RenderAsync");
         }
@@ -90,61 +132,183 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
             dpiX = dpiY = 96;
         }
 
-        _dpiY = dpiY;
+        // Nothing is paintable until the first page of this decode has been laid out.
+        PublishPages(0, reflowProgress);
 
         IGraphicsContext g = ResolveMeasurementContext(dpiX, dpiY, out IDisposable? owner);
+        DynamicScreen screen;
+        List<AnsiDecodeCheckpoint>? checkpoints = DocumentSource is null ? null : [];
         try
         {
             using IGraphicsFont font = CreateFont(g, GraphicsFontStyle.Regular);
-            _charSize = MeasureString(g, "W", font);
-            _lineHeight = font.GetHeight(dpiY);
+            GraphicsSizeF charSize = MeasureString(g, "W", font);
+            float lineHeight = font.GetHeight(dpiY);
 
-            if (PageSize.Height < _lineHeight)
+            if (PageSize.Height < lineHeight)
             {
                 throw new InvalidOperationException(
-                    $"The line height ({_lineHeight:F2}) is greater than page height ({PageSize.Height:F2}).");
+                    $"The line height ({lineHeight:F2}) is greater than page height ({PageSize.Height:F2}).");
             }
 
-            _linesPerPage = (int)Math.Floor(PageSize.Height / _lineHeight);
+            // Layout state is swapped under the lock so a concurrent PaintPage sees either the old or the new
+            // decode, never a mix.
+            lock (_pagesLock)
+            {
+                _dpiY = dpiY;
+                _charSize = charSize;
+                _lineHeight = lineHeight;
+                _linesPerPage = (int)Math.Floor(PageSize.Height / _lineHeight);
+
+                // 4 chars wide supports up to 999 line numbers before the gutter gets tight.
+                _lineNumberWidth = ContentSettings!.LineNumbers ? _charSize.Width * 4 : 0;
+
+                // Shortest line length (chars) we expect — the wrap width handed to libvt100.
+                _minLineLen = Math.Max(1,
+                    (int)((PageSize.Width - _lineNumberWidth) / Math.Max(1f, _charSize.Width)));
+
+                screen = CreateScreen(null, _minLineLen, _linesPerPage);
+                _screen = DocumentSource is null ? screen : null;
+                _checkpoints = checkpoints;
+                _checkpointsVersion++;
+            }
+        }
+        finally
+        {
+            owner?.Dispose();
+        }
 
-            // 4 chars wide supports up to 999 line numbers before the gutter gets tight.
-            _lineNumberWidth = ContentSettings!.LineNumbers ? _charSize.Width * 4 : 0;
+        // Decode off the caller's thread so pages published along the way can be painted meanwhile.
+        int lineCount = await Task.Run(
+                () => DecodeDocument(screen, checkpoints, reflowProgress, cancellationToken), cancellationToken)
+            .ConfigureAwait(false);
+        int n = (int)Math.Ceiling(lineCount / (double)_linesPerPage);
 
-            // Shortest line length (chars) we expect — the wrap width handed to libvt100.
-            _minLineLen = Math.Max(1, (int)((PageSize.Width - _lineNumberWidth) / Math.Max(1f, _charSize.Width)));
+        PublishPages(n, reflowProgress);
 
-            _screen = new DynamicScreen(_minLineLen)
-            {
-                TabSpaces = Math.Max(1, ContentSettings.TabSpaces)
-            };
+        Log.Debug("Rendered {pages} ANSI pages of {linesperpage} lines per page, total {lines} lines.", n,
+            _linesPerPage, lineCount);
+        return n;
+    }
 
-            IAnsiDecoder vt100 = new AnsiDecoder();
-            vt100.Encoding = Encoding ?? System.Text.Encoding.UTF8;
-            vt100.Subscribe(_screen);
+    /// <summary>
+    ///     Feeds the document to the decoder <see cref="DecodeChunkSize" /> at a time, publishing pages as they
+    ///     fill: the first as soon as it is complete, then at most every <see cref="s_publishInterval" />.
+    ///     When streaming from a <see cref="ContentTypeEngineBase.DocumentSource" />, a checkpoint is recorded
+    ///     at the last line break of each chunk and the lines of completed pages are released as decoding
+    ///     moves on, so memory is bounded by a chunk and a page rather than the size of the file. A checkpoint
+    ///     is dropped once the input after it moves the cursor above it: a page decode started there couldn't
+    ///     follow.
+    /// </summary>
+    /// <returns>The total number of lines.</returns>
+    private int DecodeDocument(DynamicScreen screen, List<AnsiDecodeCheckpoint>? checkpoints,
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken)
+    {
+        IAnsiDecoder vt100 = CreateDecoder(screen);
+        int published = 0;
+        long lastPublished = Stopwatch.GetTimestamp();
 
-            byte[] bytes = vt100.Encoding.GetBytes(Document);
-            if (bytes is { Length: > 0 })
+        try
+        {
+            if (DocumentSource is null)
             {
-                try
+                string document = Document ?? string.Empty;
+                for (int i = 0; i < document.Length; i += DecodeChunkSize)
                 {
-                    vt100.Input(bytes);
+                    lock (_pagesLock)
+                    {
+                        // Already text: decode it in place rather than round-tripping it through Encoding.
+                        vt100.Input(document.AsSpan(i, Math.Min(DecodeChunkSize, document.Length - i)));
+                    }
+
+                    Publish();
                 }
-                catch (Exception ex)
+            }
+            else
+            {
+                // The decoder keeps escape-sequence and multi-byte character state across Input calls, so
+                // chunk boundaries don't matter.
+                byte[] lineBreak = DocumentSource.Encoding.GetBytes("\n");
+                long offset = DocumentSource.ContentStart;
+                foreach (byte[] chunk in DocumentSource.ReadBytes(DecodeChunkSize))
                 {
-                    // The decoder is meant to survive bad data on its own; this is a last-resort guard so
-                    // a malformed ANSI file degrades to a partial render instead of aborting reflow.
-                    Log.Warning(ex, "AnsiCte: ANSI decode aborted early; rendering partial output.");
+                    int end = EndOfLastLine(chunk, lineBreak, offset - DocumentSource.ContentStart);
+                    if (end < 0)
+                    {
+                        vt100.Input(chunk);
+                    }
+                    else
+                    {
+                        vt100.Input(chunk.AsSpan(0, end));
+                        DropCheckpointsBelowCursor(screen, checkpoints!);
+                        if (vt100.IsIdle && screen.CreateCheckpoint() is { } state)
+                        {
+                            lock (_pagesLock)
+                            {
+                                checkpoints!.Add(new AnsiDecodeCheckpoint(offset + end, state));
+                            }
+                        }
+
+                        vt100.Input(chunk.AsSpan(end));
+                    }
+
+                    offset += chunk.Length;
+
+                    // Pages are re-decoded from a checkpoint when painted. The cursor can't move more than a page
+                    // above the last line (see CreateScreen), so those lines are kept.
+                    screen.ReleaseLines(screen.CursorPosition.Y - _linesPerPage);
+                    Publish();
                 }
             }
+        }
+        catch (Exception ex) when (ex is not OperationCanceledException)
+        {
+            // The decoder is meant to survive bad data on its own; this is a last-resort guard so
+            // a malformed ANSI file degrades to a partial render instead of aborting reflow.
+            Log.Warning(ex, "AnsiCte: ANSI decode aborted early; rendering partial output.");
+        }
 
-            int n = (int)Math.Ceiling(_screen.Lines.Count / (double)_linesPerPage);
-            Log.Debug("Rendered {pages} ANSI pages of {linesperpage} lines per page, total {lines} lines.", n,
-                _linesPerPage, _screen.Lines.Count);
-            return await Task.FromResult(n);
+        if (checkpoints is not null)
+        {
+            DropCheckpointsBelowCursor(screen, checkpoints);
         }
-        finally
+
+        return screen.FirstLine + screen.Lines.Count;
+
+        void DropCheckpointsBelowCursor(DynamicScreen screen, List<AnsiDecodeCheckpoint> checkpoints)
         {
-            owner?.Dispose();
+            // Since the last check the cursor has been as far up as TopmostCursorLine; decoding from a later
+            // checkpoint starts with no lines above it to move to.
+            int top = screen.TopmostCursorLine;
+            screen.ResetTopmostCursorLine();
+            lock (_pagesLock)
+            {
+                int keep = checkpoints.Count;
+                while (keep > 0 && checkpoints[keep - 1].Screen.Line > top)
+                {
+                    keep--;
+                }
+
+                if (keep < checkpoints.Count)
+                {
+                    checkpoints.RemoveRange(keep, checkpoints.Count - keep);
+                    _checkpointsVersion++;
+                }
+            }
+        }
+
+        void Publish()
+        {
+            cancellationToken.ThrowIfCancellationRequested();
+
+            // The last line may still grow, so a page is complete once a line after it exists.
+            int complete = (screen.FirstLine + screen.Lines.Count - 1) / _linesPerPage;
+            if (complete > published &&
+                (published == 0 || Stopwatch.GetElapsedTime(lastPublished) >= s_publishInterval))
+            {
+                published = complete;
+                lastPublished = Stopwatch.GetTimestamp();
+                PublishPages(published, reflowProgress);
+            }
         }
     }
 
@@ -154,10 +318,48 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
     public override void PaintPage(IGraphicsContext g, int pageNum)
     {
         LogService.TraceMessage($"{pageNum}");
-        if (_screen is null)
+
+        List<DynamicScreen.Line>? lines = null;
+        int first;
+        int linesPerPage;
+        int minLineLen;
+        int version;
+        AnsiDecodeCheckpoint? checkpoint = null;
+        lock (_pagesLock)
         {
-            Log.Debug("_screen must not be null");
-            return;
+            if (_screen is null && _checkpoints is null)
+            {
+                Log.Debug("_screen must not be null");
+                return;
+            }
+
+            linesPerPage = _linesPerPage;
+            minLineLen = _minLineLen;
+            version = _checkpointsVersion;
+            first = linesPerPage * (pageNum - 1);
+            if (first < 0)
+            {
+                return;
+            }
+
+            if (_screen is not null)
+            {
+                lines = GetPageLines(_screen, first, linesPerPage);
+            }
+            else
+            {
+                checkpoint = FindCheckpointLocked(first);
+            }
+        }
+
+        if (lines is null)
+        {
+            // Streaming: the page is decoded again from the file, without holding up the reflow.
+            lock (_pageDecodeLock)
+            {
+                DynamicScreen screen = DecodePageLocked(first, checkpoint, version, minLineLen, linesPerPage);
+                lines = GetPageLines(screen, first, linesPerPage);
+            }
         }
 
         g.SetTextRenderingMode(GraphicsTextRenderingMode);
@@ -176,12 +378,10 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
                 return f;
             }
 
-            int firstLineOnPage = _linesPerPage * (pageNum - 1);
-            int i;
-            for (i = firstLineOnPage; i < firstLineOnPage + _linesPerPage && i < _screen.Lines.Count; i++)
+            for (int i = 0; i < lines.Count; i++)
             {
-                DynamicScreen.Line line = _screen.Lines[i];
-                float yPos = (i - _linesPerPage * (pageNum - 1)) * _lineHeight;
+                DynamicScreen.Line line = lines[i];
+                float yPos = i * _lineHeight;
 
                 PaintLineNumber(g, line.LineNumber, yPos, GetFont(GraphicsFontStyle.Regular));
 
@@ -210,7 +410,7 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
                 }
             }
 
-            Log.Debug("Painted {lineOnPage} lines.", i - firstLineOnPage);
+            Log.Debug("Painted {lineOnPage} lines.", lines.Count);
         }
         finally
         {
@@ -221,6 +421,138 @@ public class AnsiCte : ContentTypeEngineBase, IDisposable
         }
     }
 
+    private static List<DynamicScreen.Line> GetPageLines(DynamicScreen screen, int first, int linesPerPage)
+    {
+        int start = first - screen.FirstLine;
+        return start < 0 || start >= screen.Lines.Count
+            ? []
+            : screen.Lines.GetRange(start, Math.Min(linesPerPage, screen.Lines.Count - start));
+    }
+
+    /// <summary>
+    ///     Decodes (streaming) until the page starting at line <paramref name="first" /> is complete. Pages
+    ///     are usually painted in order (printing), so the decode of the previous page is continued; it is
+    ///     restarted from <paramref name="checkpoint" /> (the nearest one) when the page is behind it, the
+    ///     checkpoint is closer, or the checkpoints have changed since it started (<paramref name="version" />).
+    ///     Lines of earlier pages are released: once painted (spooled, when printing) they aren't needed.
+    /// </summary>
+    private DynamicScreen DecodePageLocked(int first, AnsiDecodeCheckpoint? checkpoint, int version, int minLineLen,
+        int linesPerPage)
+    {
+        DynamicScreen? screen = _pageScreen;
+        if (screen is null || _pageVersion != version || screen.FirstLine > first ||
+            (checkpoint?.Screen.Line ?? 0) > screen.FirstLine + screen.Lines.Count)
+        {
+            ResetPageDecoderLocked();
+            screen = CreateScreen(checkpoint?.Screen, minLineLen, linesPerPage);
+            _pageScreen = screen;
+            _pageVersion = version;
+            _pageDecoder = CreateDecoder(screen);
+            _pageChunks = DocumentSource!.ReadBytes(checkpoint?.Offset ?? DocumentSource.ContentStart,
+                DecodeChunkSize).GetEnumerator();
+        }
+
+        while (_pageChunks is not null && screen.FirstLine + screen.Lines.Count <= first + linesPerPage)
+        {
+            try
+            {
+                if (_pageChunks.MoveNext())
+                {
+                    _pageDecoder!.Input(_pageChunks.Current);
+                    continue;
+                }
+            }
+            catch (Exception ex)
+            {
+                // As in RenderAsync: render what was decoded.
+                Log.Warning(ex, "AnsiCte: ANSI decode aborted early; rendering partial output.");
+            }
+
+            _pageChunks.Dispose();
+            _pageChunks = null;
+        }
+
+        screen.ReleaseLines(first - screen.FirstLine);
+        return screen;
+    }
+
+    // The last checkpoint at or before line, or null if decoding has to start at the beginning of the file.
+    private AnsiDecodeCheckpoint? FindCheckpointLocked(int line)
+    {
+        List<AnsiDecodeCheckpoint> checkpoints = _checkpoints!;
+        int lo = 0;
+        int hi = checkpoints.Count - 1;
+        while (lo <= hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (checkpoints[mid].Screen.Line <= line)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+
+        return hi < 0 ? null : checkpoints[hi];
+    }
+
+    private void ResetPageDecoderLocked()
+    {
+        _pageChunks?.Dispose();
+        _pageChunks = null;
+        _pageDecoder = null;
+        _pageScreen = null;
+    }
+
+    // Index just past the last line break in chunk, or -1. Only matches aligned to the encoding's code
+    // units count, so a UTF-16 line break isn't found straddling two characters.
+    private static int EndOfLastLine(ReadOnlySpan<byte> chunk, ReadOnlySpan<byte> lineBreak, long chunkPosition)
+    {
+        int end = chunk.Length;
+        while (true)
+        {
+            int i = chunk[..end].LastIndexOf(lineBreak);
+            if (i < 0)
+            {
+                return -1;
+            }
+
+            if ((chunkPosition + i) % lineBreak.Length == 0)
+            {
+                return i + lineBreak.Length;
+            }
+
+            end = i + lineBreak.Length - 1;
+        }
+    }
+
+    private DynamicScreen CreateScreen(DynamicScreen.Checkpoint? checkpoint, int minLineLen, int linesPerPage)
+    {
+        DynamicScreen screen = checkpoint is null
+            ? new DynamicScreen(minLineLen)
+            : new DynamicScreen(minLineLen, checkpoint);
+        screen.TabSpaces = Math.Max(1, ContentSettings!.TabSpaces);
+
+        // A streamed screen releases lines. Keeping the cursor within a page of the last line makes where it
+        // goes the same however many lines the reflow and the page decodes happen to hold.
+        if (DocumentSource is not null)
+        {
+            screen.ScrollbackLines = linesPerPage;
+        }
+
+        return screen;
+    }
+
+    private IAnsiDecoder CreateDecoder(DynamicScreen screen)
+    {
+        IAnsiDecoder vt100 = new AnsiDecoder();
+        vt100.Encoding = DocumentSource?.Encoding ?? Encoding ?? System.Text.Encoding.UTF8;
+        vt100.Subscribe(screen);
+        return vt100;
+    }
+
     private void PaintLineNumber(IGraphicsContext g, int lineNumber, float yPos, IGraphicsFont font)
     {
         if (!ContentSettings!.LineNumbers || _lineNumberWidth == 0)
@@ -0,0 +1,15 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using libvt100;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Where <see cref="AnsiCte" /> can resume decoding when it streams from a <see cref="TextFileLineSource" />:
+///     decoding the file from <paramref name="Offset" /> into a screen created from <paramref name="Screen" />
+///     reproduces the lines from <see cref="DynamicScreen.Checkpoint.Line" /> on.
+/// </summary>
+/// <param name="Offset">File offset just past a line break, where the decoder was idle.</param>
+/// <param name="Screen">Screen state (line index, attributes, line numbering) at that offset.</param>
+internal readonly record struct AnsiDecodeCheckpoint(long Offset, DynamicScreen.Checkpoint Screen);
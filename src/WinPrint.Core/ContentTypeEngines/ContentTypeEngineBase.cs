@@ -70,6 +70,7 @@ public abstract class ContentTypeEngineBase : ModelBase, INotifyPropertyChanged
     public static readonly GraphicsTextRenderingMode GraphicsTextRenderingMode =
         GraphicsTextRenderingMode.ClearTypeGridFit;
 
+    private int _availablePages;
     private ContentSettings? _contentSettings;
     private string? _document;
     private Encoding? _encoding = Encoding.Default;
@@ -110,11 +111,55 @@ public abstract class ContentTypeEngineBase : ModelBase, INotifyPropertyChanged
     public string? Document
     {
         get => _document;
-        set =>
+        set
+        {
             //LogService.TraceMessage($"Document is {document.Length} chars.");
+            if (value is not null)
+            {
+                DocumentSource = null;
+            }
+
             SetField(ref _document, value);
+        }
     }
 
+    /// <summary>
+    ///     Streaming source of the file to be printed, used instead of <see cref="Document" /> for files too
+    ///     large to hold in memory (see <see cref="Settings.StreamingThresholdBytes" />). Only set on engines
+    ///     where <see cref="SupportsDocumentSource" /> is true. The engine does not own the source.
+    /// </summary>
+    [JsonIgnore]
+    public TextFileLineSource? DocumentSource { get; private set; }
+
+    /// <summary>
+    ///     True if this engine can render directly from a <see cref="TextFileLineSource" /> (see
+    ///     <see cref="SetDocumentSourceAsync" />).
+    /// </summary>
+    [JsonIgnore]
+    public virtual bool SupportsDocumentSource => false;
+
+    /// <summary>
+    ///     True if <see cref="PaintPage" /> may run for different pages at the same time, each on its own
+    ///     <see cref="IGraphicsContext" />, once <see cref="RenderAsync" /> has completed. False (the default) for
+    ///     engines whose painting goes through shared state, such as a graphics adapter or a decoder.
+    /// </summary>
+    [JsonIgnore]
+    public virtual bool SupportsConcurrentPainting => false;
+
+    /// <summary>
+    ///     Number of pages laid out so far by the current <see cref="RenderAsync" />. Engines that reflow
+    ///     progressively publish pages as they complete (see <see cref="PublishPages" />); pages up to
+    ///     this number can be painted while later pages are still being laid out. Thread-safe.
+    /// </summary>
+    [JsonIgnore]
+    public int AvailablePages => Volatile.Read(ref _availablePages);
+
+    /// <summary>
+    ///     Source lines per chunk for engines that wrap chunks of the document concurrently (see
+    ///     <see cref="WrapChunksAsync{TChunk}" />). Tests lower it to exercise chunk stitching on small inputs.
+    /// </summary>
+    internal int WrapChunkSize { get; set; } = 1024;
+
     /// <summary>
     ///     Path of the source file being rendered, when known. Used to resolve document-relative
     ///     references (e.g. local images in Markdown). May be empty/null for string-loaded content.
@@ -201,11 +246,15 @@ public abstract class ContentTypeEngineBase : ModelBase, INotifyPropertyChanged
     /// <param name="e"></param>
     /// <param name="printerResolution"></param>
     /// <param name="reflowProgress"></param>
+    /// <param name="cancellationToken">
+    ///     Abandons the reflow (throwing <see cref="OperationCanceledException" />) when a newer one
+    ///     supersedes it. The layout is then incomplete until the next reflow finishes.
+    /// </param>
     /// <returns>Number of sheets.</returns>
     public virtual async Task<int> RenderAsync(PrintResolution? printerResolution,
-        EventHandler<string>? reflowProgress)
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken = default)
     {
-        if (Document == null)
+        if (Document == null && DocumentSource == null)
         {
             throw new InvalidOperationException("Document can't be null for Render");
         }
@@ -213,6 +262,44 @@ public abstract class ContentTypeEngineBase : ModelBase, INotifyPropertyChanged
         return await Task.FromResult(0);
     }
 
+    /// <summary>
+    ///     Lays out <paramref name="text" />, appended to the end of <see cref="Document" />, after the pages
+    ///     of the last <see cref="RenderAsync" /> without reflowing them (following a growing log file).
+    ///     <paramref name="text" /> holds whole lines, each ending in '\n'.
+    /// </summary>
+    /// <param name="text">The appended lines.</param>
+    /// <param name="reflowProgress">Reports the new page count.</param>
+    /// <param name="cancellationToken">Checked before the layout is changed.</param>
+    /// <returns>
+    ///     The new number of pages, or -1 if the engine can't extend its layout in place (it doesn't support
+    ///     appending, the document is streamed, or the last reflow didn't complete). <see cref="Document" /> is
+    ///     then unchanged and the caller should load and reflow the whole document again.
+    /// </returns>
+    public virtual Task<int> AppendAsync(string text, EventHandler<string>? reflowProgress,
+        CancellationToken cancellationToken = default)
+    {
+        return Task.FromResult(-1);
+    }
+
+    /// <summary>
+    ///     Appends <paramref name="text" /> to <see cref="Document" /> without raising
+    ///     <see cref="SettingsChanged" />; for <see cref="AppendAsync" />, which lays the text out itself.
+    /// </summary>
+    protected void AppendToDocument(string text)
+    {
+        _document += text;
+    }
+
+    /// <summary>
+    ///     Makes pages 1..<paramref name="pages" /> available for painting during reflow and reports it
+    ///     through <paramref name="reflowProgress" />. Call with 0 when a reflow starts.
+    /// </summary>
+    protected void PublishPages(int pages, EventHandler<string>? reflowProgress)
+    {
+        Volatile.Write(ref _availablePages, pages);
+        reflowProgress?.Invoke(this, $"{pages} pages laid out");
+    }
+
     /// <summary>
     ///     Paints a single page
     /// </summary>
@@ -401,75 +488,135 @@ public abstract class ContentTypeEngineBase : ModelBase, INotifyPropertyChanged
     /// <returns>The content type</returns>
     public static string GetContentType(string filePath)
     {
-        string contentType = WinPrintServices.Current.Settings.DefaultContentType;
+        string defaultContentType = WinPrintServices.Current.Settings.DefaultContentType;
 
         if (string.IsNullOrEmpty(filePath))
         {
-            return contentType;
+            return defaultContentType;
+        }
+
+        // If there's a file extension get the content type from the file type association mapper; an empty
+        // extension (e.g. .\.ssh\config) uses the file name.
+        string fileName = Path.GetFileName(filePath);
+        string ext = Path.GetExtension(fileName);
+        FileTypeMappingIndex index = WinPrintServices.Current.FileTypeMappingIndex;
+        string? contentType = ext.Length > 0 ? index.FindByExtension(ext) : index.FindByFileName(fileName);
+
+        return contentType ?? defaultContentType;
+    }
+
+    public abstract Task<bool> SetDocumentAsync(string document);
+
+    /// <summary>
+    ///     Sets the document to a streaming <see cref="TextFileLineSource" />; <see cref="Document" /> is
+    ///     cleared. Throws if the engine does not support streaming (see <see cref="SupportsDocumentSource" />).
+    /// </summary>
+    public virtual async Task<bool> SetDocumentSourceAsync(TextFileLineSource source)
+    {
+        ArgumentNullException.ThrowIfNull(source);
+        if (!SupportsDocumentSource)
+        {
+            throw new NotSupportedException($"{GetType().Name} cannot render from a streaming document source.");
+        }
+
+        Document = null;
+        DocumentSource = source;
+        OnSettingsChanged(true);
+        return await Task.FromResult(true);
+    }
+
+    /// <summary>
+    ///     Enumerates the document line by line, from <see cref="DocumentSource" /> when streaming or from
+    ///     <see cref="Document" /> otherwise. Line breaks follow <see cref="TextReader.ReadLine" />.
+    /// </summary>
+    protected IEnumerable<string> ReadDocumentLines(int firstLine = 0)
+    {
+        if (DocumentSource is not null)
+        {
+            return DocumentSource.ReadLines(firstLine);
         }
 
-        // Expand path
-        filePath = Path.GetFullPath(filePath);
+        return ReadStringLines(Document ?? string.Empty, firstLine);
+    }
 
-        // If there's a file extension get the content type from the file type association mapper
-        string ext = Path.GetExtension(filePath).ToLower();
-        if (ext != string.Empty)
+    /// <summary>
+    ///     Splits <paramref name="lines" /> into chunks of <see cref="WrapChunkSize" /> consecutive lines and
+    ///     runs <paramref name="wrap" /> on up to one chunk per core concurrently. Results are handed to
+    ///     <paramref name="stitch" /> one at a time, in document order. Lines are read sequentially and at
+    ///     most <see cref="Environment.ProcessorCount" /> chunks are in flight, so a streamed
+    ///     <see cref="DocumentSource" /> stays memory-bounded.
+    /// </summary>
+    /// <param name="lines">The document's lines.</param>
+    /// <param name="wrap">Wraps one chunk given the 0-based index of its first line; runs on the thread pool.</param>
+    /// <param name="stitch">Appends a wrapped chunk to the layout; never called concurrently.</param>
+    /// <param name="cancellationToken">Checked before each chunk is queued and stitched.</param>
+    protected async Task WrapChunksAsync<TChunk>(IEnumerable<string> lines, Func<int, List<string>, TChunk> wrap,
+        Action<TChunk> stitch, CancellationToken cancellationToken = default)
+    {
+        int chunkSize = Math.Max(1, WrapChunkSize);
+        int maxInFlight = Math.Max(1, Environment.ProcessorCount);
+        var pending = new Queue<Task<TChunk>>();
+        try
         {
-            // BUGBUG: This assumes all extensions in FilesAssociations are lowercase
-            if (WinPrintServices.Current.FileTypeMapping.FilesAssociations.TryGetValue("*" + ext, out string? ct))
+            int firstLine = 0;
+            List<string> chunk = [];
+            foreach (string line in lines)
             {
-                // Now find Id in Languages
-                contentType = WinPrintServices.Current.FileTypeMapping.ContentTypes
-                    .Where(lang => lang.Id.Equals(ct, StringComparison.OrdinalIgnoreCase))
-                    .DefaultIfEmpty(new ContentType { Id = WinPrintServices.Current.Settings.DefaultContentType })
-                    .First().Id;
+                chunk.Add(line);
+                if (chunk.Count < chunkSize)
+                {
+                    continue;
+                }
+
+                cancellationToken.ThrowIfCancellationRequested();
+                if (pending.Count == maxInFlight)
+                {
+                    stitch(await pending.Dequeue().ConfigureAwait(false));
+                }
+
+                List<string> full = chunk;
+                int first = firstLine;
+                pending.Enqueue(Task.Run(() => wrap(first, full)));
+                firstLine += full.Count;
+                chunk = [];
             }
-            else
+
+            if (chunk.Count > 0)
             {
-                // No direct file extension, look in Languages
-                contentType = WinPrintServices.Current.FileTypeMapping.ContentTypes
-                    .Where(lang => lang.Extensions
-                        .Count(i => CultureInfo.CurrentCulture.CompareInfo.Compare(i, "*" + ext,
-                                        CompareOptions.IgnoreCase) ==
-                                    0 ||
-                                    CultureInfo.CurrentCulture.CompareInfo.Compare(i, ext,
-                                        CompareOptions.IgnoreCase) ==
-                                    0) > 0)
-                    .DefaultIfEmpty(new ContentType { Id = WinPrintServices.Current.Settings.DefaultContentType })
-                    .First().Id;
+                pending.Enqueue(Task.Run(() => wrap(firstLine, chunk)));
             }
-        }
-        else
-        {
-            // Empty means no extension (e.g. .\.ssh\config) - use filename
-            if (WinPrintServices.Current.FileTypeMapping.FilesAssociations.TryGetValue("*" + Path.GetFileName(filePath),
-                    out string? ct))
+
+            while (pending.Count > 0)
             {
-                contentType = ct;
+                cancellationToken.ThrowIfCancellationRequested();
+                stitch(await pending.Dequeue().ConfigureAwait(false));
             }
-            else
+        }
+        finally
+        {
+            // After a failure, later chunks may still be running; let them finish before the caller
+            // releases the state they use.
+            await ((Task)Task.WhenAll(pending)).ConfigureAwait(ConfigureAwaitOptions.SuppressThrowing);
+        }
+    }
+
+    /// <summary>
+    ///     Splits <paramref name="document" /> into lines as <see cref="ReadDocumentLines" /> does, skipping the
+    ///     first <paramref name="firstLine" />.
+    /// </summary>
+    protected static IEnumerable<string> ReadStringLines(string document, int firstLine)
+    {
+        using var reader = new StringReader(document);
+        int lineNumber = 0;
+        while (reader.ReadLine() is { } line)
+        {
+            if (lineNumber++ >= firstLine)
             {
-                // No direct file extension, look in Languages
-                contentType = WinPrintServices.Current.FileTypeMapping.ContentTypes
-                    .Where(lang => lang.Extensions.Count(i => CultureInfo.CurrentCulture.CompareInfo.Compare(i,
-                        Path.GetFileName(filePath),
-                        CompareOptions.IgnoreCase) == 0) > 0)
-                    .DefaultIfEmpty(new ContentType { Id = WinPrintServices.Current.Settings.DefaultContentType })
-                    .First().Id;
+                yield return line;
             }
         }
-
-        // If not text or html, is it a language?
-        //if (!contentType.Equals("text/plain") && !contentType.Equals("text/html")) {
-        //    // Technically, because we got the assocation from FilesAssocation, this should always work 
-        //    if (!((List<Language>)WinPrintServices.Current.Associations.Languages).Exists(lang => lang.Id == contentType))
-        //        contentType = "text/plain";
-        //}
-        return contentType;
     }
 
-    public abstract Task<bool> SetDocumentAsync(string document);
-
     public override void CopyPropertiesFrom(ModelBase? source)
     {
         if (source is not ContentTypeEngineBase src)
@@ -480,6 +627,7 @@ public abstract class ContentTypeEngineBase : ModelBase, INotifyPropertyChanged
         PageSize = src.PageSize;
         MeasurementContext = src.MeasurementContext;
         Document = src.Document;
+        DocumentSource = src.DocumentSource;
         SourceFileName = src.SourceFileName;
         Encoding = src.Encoding;
 
@@ -0,0 +1,243 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using WinPrint.Core.Abstractions;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Character-wrapping engine used by <see cref="TextCte" />. Instead of re-measuring ever longer
+///     prefixes of a line (O(n²) <c>MeasureString</c> calls per line), it asks the graphics context for
+///     the advance of each distinct glyph exactly once, caches it for the lifetime of the font, and finds
+///     break points with a single linear prefix-sum scan. Fixed-pitch fonts take a pure-arithmetic fast
+///     path for lines made only of printable ASCII.
+///     A wrapper is not thread-safe; concurrent wrapping uses one wrapper (and font) per worker, with
+///     measurement through the shared context serialized by a common lock.
+/// </summary>
+internal sealed class GlyphAdvanceWrapper
+{
+    // Tolerance for accumulated float error in the prefix sum; well below a pixel.
+    private const float WidthEpsilon = 0.01f;
+
+    private readonly float[] _asciiAdvances = new float[128];
+    private readonly IGraphicsFont _font;
+    private readonly float _fallbackAdvance;
+    private readonly Lock? _measureLock;
+    private readonly Dictionary<int, float> _otherAdvances = [];
+    private readonly GraphicsSizeF _proposedSize;
+    private IGraphicsContext? _g;
+
+    /// <param name="g">
+    ///     Context used to measure glyphs. Only touched the first time a glyph is seen, and never after
+    ///     <see cref="Detach" />.
+    /// </param>
+    /// <param name="font">The measurement font. Advances are cached per instance, i.e. per font.</param>
+    /// <param name="maxWidth">Width available for text (page width minus the line number gutter).</param>
+    /// <param name="lineHeight">Line height; used to build the proposed measurement size.</param>
+    /// <param name="measureLock">
+    ///     Held while measuring when other wrappers share <paramref name="g" /> from other threads.
+    /// </param>
+    public GlyphAdvanceWrapper(IGraphicsContext g, IGraphicsFont font, float maxWidth, float lineHeight,
+        Lock? measureLock = null)
+    {
+        _g = g;
+        _font = font;
+        _measureLock = measureLock;
+        MaxWidth = maxWidth;
+        _proposedSize = new GraphicsSizeF(Math.Max(maxWidth, 1f) * 4, lineHeight + lineHeight / 2);
+        Array.Fill(_asciiAdvances, -1f);
+
+        // A font is treated as fixed-pitch when its narrowest and widest common glyphs agree.
+        float w = GetAdvance('W');
+        _fallbackAdvance = w;
+        IsFixedPitch = w > 0 &&
+                       Math.Abs(GetAdvance('i') - w) < WidthEpsilon &&
+                       Math.Abs(GetAdvance('.') - w) < WidthEpsilon &&
+                       Math.Abs(GetAdvance('m') - w) < WidthEpsilon;
+        FixedPitchCharsPerLine = IsFixedPitch ? Math.Max(1, (int)((maxWidth + WidthEpsilon) / w)) : 0;
+    }
+
+    /// <summary>The measurement font.</summary>
+    public IGraphicsFont Font => _font;
+
+    /// <summary>Width available for a wrapped line.</summary>
+    public float MaxWidth { get; }
+
+    /// <summary>True when the font's common glyphs all share one advance.</summary>
+    public bool IsFixedPitch { get; }
+
+    /// <summary>Characters per line for the fixed-pitch fast path (0 for proportional fonts).</summary>
+    public int FixedPitchCharsPerLine { get; }
+
+    /// <summary>Number of distinct glyphs measured so far (for diagnostics and tests).</summary>
+    public int MeasuredGlyphCount { get; private set; }
+
+    /// <summary>
+    ///     Releases the measurement context (which may be disposed once reflow completes). Afterwards the
+    ///     cached advances are read-only, so the wrapper can re-wrap lines from any thread; a glyph that was
+    ///     never measured is given the advance of 'W'.
+    /// </summary>
+    public void Detach()
+    {
+        _g = null;
+    }
+
+    /// <summary>
+    ///     Adds the advances <paramref name="other" /> (a wrapper for the same font and width) has measured
+    ///     that this one hasn't, so lines wrapped by either wrap the same way with this one after
+    ///     <see cref="Detach" />.
+    /// </summary>
+    public void MergeFrom(GlyphAdvanceWrapper other)
+    {
+        for (int ch = 0; ch < _asciiAdvances.Length; ch++)
+        {
+            if (_asciiAdvances[ch] < 0 && other._asciiAdvances[ch] >= 0)
+            {
+                _asciiAdvances[ch] = other._asciiAdvances[ch];
+                MeasuredGlyphCount++;
+            }
+        }
+
+        foreach (KeyValuePair<int, float> advance in other._otherAdvances)
+        {
+            if (_otherAdvances.TryAdd(advance.Key, advance.Value))
+            {
+                MeasuredGlyphCount++;
+            }
+        }
+    }
+
+    /// <summary>
+    ///     Wraps <paramref name="line" /> to <see cref="MaxWidth" />, appending one <see cref="WrappedLine" />
+    ///     per segment. The first segment carries <paramref name="lineNumber" />; continuation segments
+    ///     carry 0. Every segment holds at least one glyph so a glyph wider than the page still progresses.
+    /// </summary>
+    public void Wrap(string line, int lineNumber, List<WrappedLine> wrappedList)
+    {
+        int start = 0;
+        do
+        {
+            int count = FitChars(line, start);
+            var wl = new WrappedLine
+            {
+                Text = start == 0 && count == line.Length ? line : line.Substring(start, count),
+                NonWrappedLineNumber = start == 0 ? lineNumber : 0
+            };
+#if DEBUG
+            wl.TextNonWrapped = line;
+#endif
+            wrappedList.Add(wl);
+            start += count;
+        } while (start < line.Length);
+    }
+
+    /// <summary>
+    ///     Returns how many UTF-16 chars of <paramref name="text" />, starting at <paramref name="start" />,
+    ///     fit in <see cref="MaxWidth" />. Never splits a surrogate pair and never returns 0 for a non-empty
+    ///     remainder.
+    /// </summary>
+    public int FitChars(string text, int start)
+    {
+        int remaining = text.Length - start;
+        if (remaining <= 0)
+        {
+            return 0;
+        }
+
+        ReadOnlySpan<char> span = text.AsSpan(start);
+
+        // Fixed-pitch fast path: only the window that could fit needs to be printable ASCII.
+        if (IsFixedPitch && !span[..Math.Min(remaining, FixedPitchCharsPerLine)].ContainsAnyExceptInRange(' ', '~'))
+        {
+            return Math.Min(remaining, FixedPitchCharsPerLine);
+        }
+
+        float width = 0;
+        int i = 0;
+        while (i < span.Length)
+        {
+            bool pair = char.IsHighSurrogate(span[i]) && i + 1 < span.Length && char.IsLowSurrogate(span[i + 1]);
+            int glyphLength = pair ? 2 : 1;
+            width += pair ? GetAdvance(char.ConvertToUtf32(span[i], span[i + 1])) : GetAdvance(span[i]);
+            if (width > MaxWidth + WidthEpsilon)
+            {
+                return i == 0 ? glyphLength : i;
+            }
+
+            i += glyphLength;
+        }
+
+        return span.Length;
+    }
+
+    private float GetAdvance(char ch)
+    {
+        if (ch >= _asciiAdvances.Length)
+        {
+            // Non-ASCII BMP chars (and lone surrogates) share the dictionary with supplementary code
+            // points; the key spaces don't overlap.
+            if (!_otherAdvances.TryGetValue(ch, out float other))
+            {
+                if (_g is null)
+                {
+                    return _fallbackAdvance;
+                }
+
+                other = Measure(ch.ToString());
+                _otherAdvances[ch] = other;
+            }
+
+            return other;
+        }
+
+        float advance = _asciiAdvances[ch];
+        if (advance < 0)
+        {
+            if (_g is null)
+            {
+                return _fallbackAdvance;
+            }
+
+            advance = Measure(ch.ToString());
+            _asciiAdvances[ch] = advance;
+        }
+
+        return advance;
+    }
+
+    private float GetAdvance(int codePoint)
+    {
+        if (!_otherAdvances.TryGetValue(codePoint, out float advance))
+        {
+            if (_g is null)
+            {
+                return _fallbackAdvance;
+            }
+
+            advance = Measure(char.ConvertFromUtf32(codePoint));
+            _otherAdvances[codePoint] = advance;
+        }
+
+        return advance;
+    }
+
+    private float Measure(string glyph)
+    {
+        MeasuredGlyphCount++;
+        if (_measureLock is null)
+        {
+            return MeasureCore(glyph);
+        }
+
+        lock (_measureLock)
+        {
+            return MeasureCore(glyph);
+        }
+    }
+
+    private float MeasureCore(string glyph)
+    {
+        return _g!.MeasureString(glyph, _font, _proposedSize, ContentTypeEngineBase.GraphicsStringFormat, out _,
+            out _).Width;
+    }
+}
@@ -0,0 +1,75 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+namespace WinPrint.Core.ContentTypeEngines.Html;
+
+/// <summary>
+///     The drawing commands of one paint of an HTML layout, bucketed by page. <see cref="HtmlCte" /> paints
+///     the laid-out document once into a recording <see cref="WinPrintHtmlGraphics" /> and then replays a
+///     page's bucket per page, instead of walking every box of the layout for every page. A command whose
+///     vertical extent straddles a page boundary is in the bucket of each page it touches.
+/// </summary>
+internal sealed class HtmlDisplayList
+{
+    private readonly double _pageHeight;
+    private readonly List<Action<WinPrintHtmlGraphics>>[] _pages;
+
+    public HtmlDisplayList(int pageCount, double pageHeight)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(pageCount);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(pageHeight);
+
+        _pageHeight = pageHeight;
+        _pages = new List<Action<WinPrintHtmlGraphics>>[pageCount];
+        for (int i = 0; i < pageCount; i++)
+        {
+            _pages[i] = [];
+        }
+    }
+
+    /// <summary>Number of pages the commands are bucketed into.</summary>
+    public int PageCount => _pages.Length;
+
+    /// <summary>Number of commands recorded (once each, however many pages they touch).</summary>
+    public int CommandCount { get; private set; }
+
+    /// <summary>
+    ///     Records <paramref name="draw" />, which covers document y coordinates <paramref name="top" /> to
+    ///     <paramref name="bottom" />, for every page that range touches. Content past the last page is dropped.
+    /// </summary>
+    public void Add(double top, double bottom, Action<WinPrintHtmlGraphics> draw)
+    {
+        CommandCount++;
+        if (bottom < top)
+        {
+            (top, bottom) = (bottom, top);
+        }
+
+        int first = Math.Max(0, (int)Math.Floor(top / _pageHeight));
+
+        // A range ending exactly on a page boundary doesn't reach the next page (unless it is empty).
+        int last = Math.Max(first, (int)Math.Ceiling(bottom / _pageHeight) - 1);
+        for (int page = first; page <= Math.Min(last, _pages.Length - 1); page++)
+        {
+            _pages[page].Add(draw);
+        }
+    }
+
+    /// <summary>
+    ///     Replays the commands of page <paramref name="pageNum" /> (1-based) onto <paramref name="target" />,
+    ///     shifted up so the top of the page is at y = 0.
+    /// </summary>
+    public void Replay(int pageNum, WinPrintHtmlGraphics target)
+    {
+        if (pageNum < 1 || pageNum > _pages.Length)
+        {
+            return;
+        }
+
+        target.OffsetY = -(pageNum - 1) * _pageHeight;
+        foreach (Action<WinPrintHtmlGraphics> draw in _pages[pageNum - 1])
+        {
+            draw(target);
+        }
+    }
+}
@@ -6,22 +6,59 @@ using System.Text;
 namespace WinPrint.Core.ContentTypeEngines.Html;
 
 /// <summary>
-///     A minimal MHTML ("MIME HTML" / saved-web-archive, <c>.mhtml</c>/<c>.mht</c>) reader. Parses the
-///     multipart/related MIME container into its root <see cref="Html" /> document and a map of embedded
-///     <see cref="Resources" /> (keyed by both <c>Content-Location</c> URL and <c>cid:&lt;Content-ID&gt;</c>),
-///     so images and stylesheets render offline from the archive instead of the network.
+///     A minimal MHTML ("MIME HTML" / saved-web-archive, <c>.mhtml</c>/<c>.mht</c>) reader. Indexes the
+///     multipart/related MIME container into its parts (headers plus the offsets of each body in the archive
+///     text), keyed by both <c>Content-Location</c> URL and <c>cid:&lt;Content-ID&gt;</c>, so images and
+///     stylesheets render offline from the archive instead of the network. Bodies are decoded only when
+///     asked for: <see cref="Html" /> decodes just the root part, and <see cref="Resolve" /> decodes one
+///     resource into a cache of at most <see cref="CacheCapacity" /> bytes (least recently used first out).
 /// </summary>
 internal sealed class MhtmlArchive
 {
-    private MhtmlArchive(string html, Dictionary<string, byte[]> resources)
+    /// <summary>Default <see cref="CacheCapacity" />: 32 MB of decoded resources.</summary>
+    public const long DefaultCacheCapacity = 32L * 1024 * 1024;
+
+    // Decoded bodies by part index, most recently used last in _lru.
+    private readonly Dictionary<int, (byte[] Bytes, LinkedListNode<int> Node)> _cache = [];
+    private readonly Lock _cacheLock = new();
+    private readonly string _doc;
+    private readonly int _htmlPart;
+    private readonly LinkedList<int> _lru = new();
+    private readonly MhtmlPart[] _parts;
+    private readonly Dictionary<string, int> _resources;
+    private long _cachedBytes;
+    private string? _html;
+
+    private MhtmlArchive(string doc, MhtmlPart[] parts, int htmlPart, Dictionary<string, int> resources,
+        long cacheCapacity)
     {
-        Html = html;
-        Resources = resources;
+        _doc = doc;
+        _parts = parts;
+        _htmlPart = htmlPart;
+        _resources = resources;
+        CacheCapacity = cacheCapacity;
     }
 
-    public string Html { get; }
+    /// <summary>The root HTML document, decoded on first use.</summary>
+    public string Html => _html ??= GetString(DecodePart(_htmlPart), _parts[_htmlPart].ContentType);
 
-    public IReadOnlyDictionary<string, byte[]> Resources { get; }
+    /// <summary>Number of MIME parts in the archive.</summary>
+    public int PartCount => _parts.Length;
+
+    /// <summary>Most bytes of decoded resources kept for reuse by <see cref="Resolve" />.</summary>
+    public long CacheCapacity { get; }
+
+    /// <summary>Bytes of decoded resources currently cached.</summary>
+    public long CachedBytes
+    {
+        get
+        {
+            lock (_cacheLock)
+            {
+                return _cachedBytes;
+            }
+        }
+    }
 
     /// <summary>Cheap heuristic: does this document look like an MHTML MIME archive?</summary>
     public static bool LooksLikeMhtml(string doc)
@@ -36,53 +73,63 @@ internal sealed class MhtmlArchive
                head.Contains("multipart/related", StringComparison.OrdinalIgnoreCase);
     }
 
-    /// <summary>Parses the archive, or returns null if it isn't valid MHTML / has no HTML part.</summary>
-    public static MhtmlArchive? Parse(string doc)
+    /// <summary>
+    ///     Indexes the archive, or returns null if it isn't valid MHTML / has no HTML part. Only headers are
+    ///     parsed; no part body is decoded.
+    /// </summary>
+    public static MhtmlArchive? Parse(string doc, long cacheCapacity = DefaultCacheCapacity)
     {
-        (Dictionary<string, string> topHeaders, string topBody) = SplitHeadersBody(doc);
+        int topSplit = IndexOfBlankLine(doc, 0, doc.Length, out int topBodyStart);
+        Dictionary<string, string> topHeaders = ParseHeaders(doc.AsSpan(0, topSplit < 0 ? doc.Length : topSplit));
         string? boundary = ExtractBoundary(topHeaders.GetValueOrDefault("content-type", string.Empty));
         if (boundary is null)
         {
             return null;
         }
 
-        string? html = null;
-        var resources = new Dictionary<string, byte[]>(StringComparer.OrdinalIgnoreCase);
+        int htmlPart = -1;
+        var parts = new List<MhtmlPart>();
+        var resources = new Dictionary<string, int>(StringComparer.OrdinalIgnoreCase);
 
-        foreach (string rawPart in SplitParts(topBody, boundary))
+        foreach ((int start, int end) in FindParts(doc, topBodyStart, boundary))
         {
-            (Dictionary<string, string> headers, string body) = SplitHeadersBody(rawPart);
-            if (headers.Count == 0 && body.Length == 0)
+            int split = IndexOfBlankLine(doc, start, end, out int bodyStart);
+            Dictionary<string, string> headers = ParseHeaders(doc.AsSpan(start, (split < 0 ? end : split) - start));
+            if (headers.Count == 0 && bodyStart >= end)
             {
                 continue;
             }
 
             string contentType = headers.GetValueOrDefault("content-type", string.Empty);
-            string encoding = headers.GetValueOrDefault("content-transfer-encoding", string.Empty);
-            byte[] bytes = Decode(body, encoding);
+            int index = parts.Count;
+            parts.Add(new MhtmlPart(contentType, headers.GetValueOrDefault("content-transfer-encoding", string.Empty),
+                bodyStart, end - bodyStart));
 
-            if (html is null && contentType.Contains("text/html", StringComparison.OrdinalIgnoreCase))
+            if (htmlPart < 0 && contentType.Contains("text/html", StringComparison.OrdinalIgnoreCase))
             {
-                html = GetString(bytes, contentType);
+                htmlPart = index;
             }
 
             string location = headers.GetValueOrDefault("content-location", string.Empty).Trim();
             if (location.Length > 0)
             {
-                resources[location] = bytes;
+                resources[location] = index;
             }
 
             string contentId = headers.GetValueOrDefault("content-id", string.Empty).Trim().Trim('<', '>');
             if (contentId.Length > 0)
             {
-                resources["cid:" + contentId] = bytes;
+                resources["cid:" + contentId] = index;
             }
         }
 
-        return html is null ? null : new MhtmlArchive(html, resources);
+        return htmlPart < 0 ? null : new MhtmlArchive(doc, [.. parts], htmlPart, resources, cacheCapacity);
     }
 
-    /// <summary>Resolves a resource by an HTML reference (a <c>cid:</c> URI or a Content-Location URL).</summary>
+    /// <summary>
+    ///     Resolves a resource by an HTML reference (a <c>cid:</c> URI or a Content-Location URL), decoding
+    ///     it unless it is still cached.
+    /// </summary>
     public byte[]? Resolve(string? src)
     {
         if (string.IsNullOrEmpty(src))
@@ -90,34 +137,74 @@ internal sealed class MhtmlArchive
             return null;
         }
 
-        if (Resources.TryGetValue(src, out byte[]? exact))
+        if (_resources.TryGetValue(src, out int exact))
         {
-            return exact;
+            return GetPart(exact);
         }
 
         if (src.StartsWith("cid:", StringComparison.OrdinalIgnoreCase) &&
-            Resources.TryGetValue("cid:" + src[4..].Trim().Trim('<', '>'), out byte[]? byCid))
+            _resources.TryGetValue("cid:" + src[4..].Trim().Trim('<', '>'), out int byCid))
         {
-            return byCid;
+            return GetPart(byCid);
         }
 
         return null;
     }
 
-    private static (Dictionary<string, string> Headers, string Body) SplitHeadersBody(string text)
+    private byte[] GetPart(int index)
     {
-        var headers = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+        lock (_cacheLock)
+        {
+            if (_cache.TryGetValue(index, out (byte[] Bytes, LinkedListNode<int> Node) hit))
+            {
+                _lru.Remove(hit.Node);
+                _lru.AddLast(hit.Node);
+                return hit.Bytes;
+            }
+        }
+
+        // Decode outside the lock; a racing decode of the same part just loses the cache insert.
+        byte[] bytes = DecodePart(index);
+        if (bytes.Length > CacheCapacity)
+        {
+            return bytes;
+        }
+
+        lock (_cacheLock)
+        {
+            if (_cache.ContainsKey(index))
+            {
+                return bytes;
+            }
+
+            while (_cachedBytes + bytes.Length > CacheCapacity && _lru.First is { } oldest)
+            {
+                _cachedBytes -= _cache[oldest.Value].Bytes.Length;
+                _cache.Remove(oldest.Value);
+                _lru.RemoveFirst();
+            }
 
-        // Headers are separated from the body by the first blank line.
-        int split = IndexOfBlankLine(text, out int bodyStart);
-        string headerBlock = split < 0 ? text : text[..split];
-        string body = split < 0 ? string.Empty : text[bodyStart..];
+            _cache[index] = (bytes, _lru.AddLast(index));
+            _cachedBytes += bytes.Length;
+        }
+
+        return bytes;
+    }
+
+    private byte[] DecodePart(int index)
+    {
+        MhtmlPart part = _parts[index];
+        return Decode(_doc.AsSpan(part.BodyStart, part.BodyLength), part.TransferEncoding);
+    }
 
+    private static Dictionary<string, string> ParseHeaders(ReadOnlySpan<char> headerBlock)
+    {
+        var headers = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
         string? name = null;
         var value = new StringBuilder();
-        foreach (string rawLine in headerBlock.Split('\n'))
+        foreach (Range range in headerBlock.Split('\n'))
         {
-            string line = rawLine.TrimEnd('\r');
+            ReadOnlySpan<char> line = headerBlock[range].TrimEnd('\r');
             if (line.Length == 0)
             {
                 continue;
@@ -140,7 +227,7 @@ internal sealed class MhtmlArchive
                 headers[name] = value.ToString().Trim();
             }
 
-            name = line[..colon].Trim().ToLowerInvariant();
+            name = line[..colon].Trim().ToString().ToLowerInvariant();
             value.Clear();
             value.Append(line[(colon + 1)..]);
         }
@@ -150,43 +237,54 @@ internal sealed class MhtmlArchive
             headers[name] = value.ToString().Trim();
         }
 
-        return (headers, body);
+        return headers;
     }
 
-    private static int IndexOfBlankLine(string text, out int bodyStart)
+    // Headers are separated from the body by the first blank line in [start, end).
+    private static int IndexOfBlankLine(string text, int start, int end, out int bodyStart)
     {
-        int crlf = text.IndexOf("\r\n\r\n", StringComparison.Ordinal);
-        int lf = text.IndexOf("\n\n", StringComparison.Ordinal);
+        ReadOnlySpan<char> span = text.AsSpan(start, end - start);
+        int crlf = span.IndexOf("\r\n\r\n", StringComparison.Ordinal);
+        int lf = span.IndexOf("\n\n", StringComparison.Ordinal);
         if (crlf >= 0 && (lf < 0 || crlf <= lf))
         {
-            bodyStart = crlf + 4;
-            return crlf;
+            bodyStart = start + crlf + 4;
+            return start + crlf;
         }
 
         if (lf >= 0)
         {
-            bodyStart = lf + 2;
-            return lf;
+            bodyStart = start + lf + 2;
+            return start + lf;
         }
 
-        bodyStart = text.Length;
+        bodyStart = end;
         return -1;
     }
 
-    private static IEnumerable<string> SplitParts(string body, string boundary)
+    // Yields the [start, end) range of each part between "--boundary" delimiters (leading line breaks skipped).
+    private static IEnumerable<(int Start, int End)> FindParts(string doc, int bodyStart, string boundary)
     {
         string delimiter = "--" + boundary;
-        string[] segments = body.Split(delimiter);
-        // segments[0] is the preamble; the final segment is the "--" close or epilogue.
-        for (int i = 1; i < segments.Length; i++)
+        // The text before the first delimiter is the preamble.
+        int at = doc.IndexOf(delimiter, bodyStart, StringComparison.Ordinal);
+        while (at >= 0)
         {
-            string seg = segments[i];
-            if (seg.StartsWith("--", StringComparison.Ordinal))
+            int start = at + delimiter.Length;
+            if (string.CompareOrdinal(doc, start, "--", 0, 2) == 0)
             {
                 yield break; // closing boundary reached
             }
 
-            yield return seg.TrimStart('\r', '\n');
+            int next = doc.IndexOf(delimiter, start, StringComparison.Ordinal);
+            int end = next < 0 ? doc.Length : next;
+            while (start < end && doc[start] is '\r' or '\n')
+            {
+                start++;
+            }
+
+            yield return (start, end);
+            at = next;
         }
     }
 
@@ -215,18 +313,13 @@ internal sealed class MhtmlArchive
         return stop > 0 ? rest[..stop] : rest;
     }
 
-    private static byte[] Decode(string body, string encoding)
+    private static byte[] Decode(ReadOnlySpan<char> body, string encoding)
     {
         if (encoding.Contains("base64", StringComparison.OrdinalIgnoreCase))
         {
-            try
-            {
-                return Convert.FromBase64String(RemoveWhitespace(body));
-            }
-            catch (Exception)
-            {
-                return [];
-            }
+            // TryFromBase64Chars skips the line breaks and spaces the body is wrapped with.
+            byte[] buffer = new byte[body.Length / 4 * 3 + 3];
+            return Convert.TryFromBase64Chars(body, buffer, out int written) ? buffer[..written] : [];
         }
 
         if (encoding.Contains("quoted-printable", StringComparison.OrdinalIgnoreCase))
@@ -234,10 +327,13 @@ internal sealed class MhtmlArchive
             return DecodeQuotedPrintable(body);
         }
 
-        return Encoding.UTF8.GetBytes(body); // 7bit/8bit/binary
+        // 7bit/8bit/binary
+        byte[] bytes = new byte[Encoding.UTF8.GetByteCount(body)];
+        Encoding.UTF8.GetBytes(body, bytes);
+        return bytes;
     }
 
-    private static byte[] DecodeQuotedPrintable(string body)
+    private static byte[] DecodeQuotedPrintable(ReadOnlySpan<char> body)
     {
         var bytes = new List<byte>(body.Length);
         for (int i = 0; i < body.Length; i++)
@@ -267,20 +363,6 @@ internal sealed class MhtmlArchive
         return [.. bytes];
     }
 
-    private static string RemoveWhitespace(string s)
-    {
-        var sb = new StringBuilder(s.Length);
-        foreach (char c in s)
-        {
-            if (!char.IsWhiteSpace(c))
-            {
-                sb.Append(c);
-            }
-        }
-
-        return sb.ToString();
-    }
-
     private static string GetString(byte[] bytes, string contentType)
     {
         Encoding encoding = Encoding.UTF8;
@@ -0,0 +1,13 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+namespace WinPrint.Core.ContentTypeEngines.Html;
+
+/// <summary>
+///     Where one MIME part of an <see cref="MhtmlArchive" /> is in the archive text, and how to decode it.
+/// </summary>
+/// <param name="ContentType">The part's <c>Content-Type</c>.</param>
+/// <param name="TransferEncoding">The part's <c>Content-Transfer-Encoding</c>, or empty.</param>
+/// <param name="BodyStart">Index of the first character of the (still encoded) body.</param>
+/// <param name="BodyLength">Length of the encoded body.</param>
+internal readonly record struct MhtmlPart(string ContentType, string TransferEncoding, int BodyStart, int BodyLength);
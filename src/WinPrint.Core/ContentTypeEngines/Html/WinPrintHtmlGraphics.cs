@@ -10,19 +10,29 @@ namespace WinPrint.Core.ContentTypeEngines.Html;
 /// <summary>
 ///     Bridges HtmlRenderer's <see cref="RGraphics" /> drawing surface onto WinPrint's cross-platform
 ///     <see cref="IGraphicsContext" />. The context is owned by the caller (the engine) and is not
-///     disposed here.
+///     disposed here. Given a <see cref="HtmlDisplayList" />, drawing is recorded into it instead (text is
+///     still measured with the context) for later replay onto a page.
 /// </summary>
 internal sealed class WinPrintHtmlGraphics : RGraphics
 {
     private readonly Dictionary<(string Family, double Size, GraphicsFontStyle Style), IGraphicsFont> _fonts = [];
     private readonly IGraphicsContext _g;
+    private readonly HtmlDisplayList? _recorder;
 
-    public WinPrintHtmlGraphics(WinPrintHtmlAdapter adapter, IGraphicsContext g, RRect initialClip)
+    public WinPrintHtmlGraphics(WinPrintHtmlAdapter adapter, IGraphicsContext g, RRect initialClip,
+        HtmlDisplayList? recorder = null)
         : base(adapter, initialClip)
     {
         _g = g;
+        _recorder = recorder;
     }
 
+    /// <summary>
+    ///     Added to every y coordinate drawn on the context (not to recorded ones); set by
+    ///     <see cref="HtmlDisplayList.Replay" />.
+    /// </summary>
+    public double OffsetY { get; set; }
+
     // HtmlRenderer pushes a clip per box (for overflow). We intentionally do NOT propagate these to the
     // backend: page-boundary clipping is already provided by the host's page clip and the page-sized
     // surface, and some backends (ImageSharp) only approximate text clipping by the run's origin point,
@@ -117,34 +127,33 @@ internal sealed class WinPrintHtmlGraphics : RGraphics
             return;
         }
 
+        if (_recorder is not null)
+        {
+            _recorder.Add(point.Y, point.Y + size.Height, g => g.DrawString(str, font, color, point, size, rtl));
+            return;
+        }
+
         using IGraphicsBrush brush = _g.CreateSolidBrush(HtmlConv.ToColor(color));
-        _g.DrawString(str, Native(font), brush, (float)point.X, (float)point.Y);
+        _g.DrawString(str, Native(font), brush, (float)point.X, Y(point.Y));
     }
 
     public override void DrawLine(RPen pen, double x1, double y1, double x2, double y2)
     {
+        // HtmlRenderer reuses a pen per color and sets its width before each use, so record the values.
         var p = (WinPrintHtmlPen)pen;
-        using IGraphicsPen native = _g.CreatePen(p.Color, (float)p.Width);
-        _g.DrawLine(native, (float)x1, (float)y1, (float)x2, (float)y2);
+        DrawLine(p.Color, p.Width, x1, y1, x2, y2);
     }
 
     public override void DrawRectangle(RPen pen, double x, double y, double width, double height)
     {
         var p = (WinPrintHtmlPen)pen;
-        using IGraphicsPen native = _g.CreatePen(p.Color, (float)p.Width);
-        _g.DrawRectangle(native, (float)x, (float)y, (float)width, (float)height);
+        DrawRectangle(p.Color, p.Width, x, y, width, height);
     }
 
     public override void DrawRectangle(RBrush brush, double x, double y, double width, double height)
     {
         var b = (WinPrintHtmlBrush)brush;
-        if (b.Color.A == 0)
-        {
-            return;
-        }
-
-        using IGraphicsBrush native = _g.CreateSolidBrush(b.Color);
-        _g.FillRectangle(native, (float)x, (float)y, (float)width, (float)height);
+        FillRectangle(b.Color, x, y, width, height);
     }
 
     public override void DrawImage(RImage image, RRect destRect, RRect srcRect)
@@ -154,10 +163,16 @@ internal sealed class WinPrintHtmlGraphics : RGraphics
 
     public override void DrawImage(RImage image, RRect destRect)
     {
+        if (_recorder is not null)
+        {
+            _recorder.Add(destRect.Top, destRect.Bottom, g => g.DrawImage(image, destRect));
+            return;
+        }
+
         IGraphicsImage? native = ((WinPrintHtmlImage)image).Decode(_g);
         if (native is not null)
         {
-            _g.DrawImage(native, (float)destRect.X, (float)destRect.Y,
+            _g.DrawImage(native, (float)destRect.X, Y(destRect.Y),
                 (float)destRect.Width, (float)destRect.Height);
         }
     }
@@ -165,22 +180,12 @@ internal sealed class WinPrintHtmlGraphics : RGraphics
     public override void DrawPath(RPen pen, RGraphicsPath path)
     {
         var p = (WinPrintHtmlPen)pen;
-        IReadOnlyList<GraphicsPointF> pts = ((WinPrintHtmlGraphicsPath)path).Points;
-        if (pts.Count < 2)
-        {
-            return;
-        }
-
-        using IGraphicsPen native = _g.CreatePen(p.Color, (float)p.Width);
-        for (int i = 1; i < pts.Count; i++)
-        {
-            _g.DrawLine(native, pts[i - 1].X, pts[i - 1].Y, pts[i].X, pts[i].Y);
-        }
+        DrawPolyline(p.Color, p.Width, [.. ((WinPrintHtmlGraphicsPath)path).Points]);
     }
 
     public override void DrawPath(RBrush brush, RGraphicsPath path)
     {
-        FillPolygon((WinPrintHtmlBrush)brush, ((WinPrintHtmlGraphicsPath)path).Points);
+        FillPolygon(((WinPrintHtmlBrush)brush).Color, [.. ((WinPrintHtmlGraphicsPath)path).Points]);
     }
 
     public override void DrawPolygon(RBrush brush, RPoint[] points)
@@ -196,7 +201,7 @@ internal sealed class WinPrintHtmlGraphics : RGraphics
             pts[i] = new GraphicsPointF((float)points[i].X, (float)points[i].Y);
         }
 
-        FillPolygon((WinPrintHtmlBrush)brush, pts);
+        FillPolygon(((WinPrintHtmlBrush)brush).Color, pts);
     }
 
     public override void Dispose()
@@ -224,10 +229,76 @@ internal sealed class WinPrintHtmlGraphics : RGraphics
         return native;
     }
 
+    private float Y(double y)
+    {
+        return (float)(y + OffsetY);
+    }
+
+    private void DrawLine(GraphicsColor color, double width, double x1, double y1, double x2, double y2)
+    {
+        if (_recorder is not null)
+        {
+            _recorder.Add(Math.Min(y1, y2), Math.Max(y1, y2), g => g.DrawLine(color, width, x1, y1, x2, y2));
+            return;
+        }
+
+        using IGraphicsPen native = _g.CreatePen(color, (float)width);
+        _g.DrawLine(native, (float)x1, Y(y1), (float)x2, Y(y2));
+    }
+
+    private void DrawRectangle(GraphicsColor color, double width, double x, double y, double w, double h)
+    {
+        if (_recorder is not null)
+        {
+            _recorder.Add(y, y + h, g => g.DrawRectangle(color, width, x, y, w, h));
+            return;
+        }
+
+        using IGraphicsPen native = _g.CreatePen(color, (float)width);
+        _g.DrawRectangle(native, (float)x, Y(y), (float)w, (float)h);
+    }
+
+    private void FillRectangle(GraphicsColor color, double x, double y, double w, double h)
+    {
+        if (color.A == 0)
+        {
+            return;
+        }
+
+        if (_recorder is not null)
+        {
+            _recorder.Add(y, y + h, g => g.FillRectangle(color, x, y, w, h));
+            return;
+        }
+
+        using IGraphicsBrush native = _g.CreateSolidBrush(color);
+        _g.FillRectangle(native, (float)x, Y(y), (float)w, (float)h);
+    }
+
+    private void DrawPolyline(GraphicsColor color, double width, GraphicsPointF[] pts)
+    {
+        if (pts.Length < 2)
+        {
+            return;
+        }
+
+        if (_recorder is not null)
+        {
+            _recorder.Add(pts.Min(pt => pt.Y), pts.Max(pt => pt.Y), g => g.DrawPolyline(color, width, pts));
+            return;
+        }
+
+        using IGraphicsPen native = _g.CreatePen(color, (float)width);
+        for (int i = 1; i < pts.Length; i++)
+        {
+            _g.DrawLine(native, pts[i - 1].X, Y(pts[i - 1].Y), pts[i].X, Y(pts[i].Y));
+        }
+    }
+
     // No fill-polygon primitive in IGraphicsContext; approximate by filling the polygon's bounding box.
-    private void FillPolygon(WinPrintHtmlBrush brush, IReadOnlyList<GraphicsPointF> pts)
+    private void FillPolygon(GraphicsColor color, GraphicsPointF[] pts)
     {
-        if (brush.Color.A == 0 || pts.Count == 0)
+        if (color.A == 0 || pts.Length == 0)
         {
             return;
         }
@@ -244,7 +315,6 @@ internal sealed class WinPrintHtmlGraphics : RGraphics
             maxY = Math.Max(maxY, pt.Y);
         }
 
-        using IGraphicsBrush native = _g.CreateSolidBrush(brush.Color);
-        _g.FillRectangle(native, minX, minY, maxX - minX, maxY - minY);
+        FillRectangle(color, minX, minY, maxX - minX, maxY - minY);
     }
 }
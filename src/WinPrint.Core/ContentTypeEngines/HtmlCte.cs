@@ -18,10 +18,11 @@ namespace WinPrint.Core.ContentTypeEngines;
 /// <summary>
 ///     Implements <c>text/html</c> (and <c>.mhtml</c>/<c>.mht</c> web archives) by laying out and painting
 ///     HTML/CSS through the pure-managed HtmlRenderer engine, rendered onto WinPrint's cross-platform
-///     <see cref="IGraphicsContext" /> via <see cref="WinPrintHtmlAdapter" />. The document is laid out once
-///     (in <see cref="RenderAsync" />) and that layout is reused for every page; images are decoded per
-///     paint backend on demand. Local files (relative to <see cref="ContentTypeEngineBase.SourceFileName" />)
-///     and <c>data:</c> URIs always load; <c>http(s)</c> resources require <see cref="AllowRemoteResources" />.
+///     <see cref="IGraphicsContext" /> via <see cref="WinPrintHtmlAdapter" />. The document is laid out and
+///     painted once (in <see cref="RenderAsync" />) into a <see cref="HtmlDisplayList" />, and each page
+///     replays only the drawing commands that fall on it; images are decoded per paint backend on demand.
+///     Local files (relative to <see cref="ContentTypeEngineBase.SourceFileName" />) and <c>data:</c> URIs
+///     always load; <c>http(s)</c> resources require <see cref="AllowRemoteResources" />.
 /// </summary>
 public class HtmlCte : ContentTypeEngineBase, IDisposable
 {
@@ -32,6 +33,7 @@ public class HtmlCte : ContentTypeEngineBase, IDisposable
     private WinPrintHtmlAdapter? _adapter;
     private MhtmlArchive? _archive;
     private HtmlContainerInt? _container;
+    private HtmlDisplayList? _displayList;
     private bool _disposed;
     private int _dpiY = 96;
     private int _pageCount;
@@ -71,6 +73,7 @@ public class HtmlCte : ContentTypeEngineBase, IDisposable
         {
             _container?.Dispose();
             _container = null;
+            _displayList = null;
         }
 
         _disposed = true;
@@ -86,7 +89,7 @@ public class HtmlCte : ContentTypeEngineBase, IDisposable
     }
 
     public override async Task<int> RenderAsync(PrintResolution? printerResolution,
-        EventHandler<string>? reflowProgress)
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken = default)
     {
         LogService.TraceMessage();
         if (Document is null)
@@ -110,6 +113,7 @@ public class HtmlCte : ContentTypeEngineBase, IDisposable
 
         _resourceCache.Clear();
         _container?.Dispose();
+        _displayList = null;
 
         // Lay the document out exactly once; PaintPage reuses this layout for every page.
         IGraphicsContext g = ResolveMeasurementContext(dpiX, dpiY, out IDisposable? owner);
@@ -127,15 +131,30 @@ public class HtmlCte : ContentTypeEngineBase, IDisposable
             _container.RenderError += (_, e) =>
                 Log.Warning("HtmlCte render error: {type} {message}", e.Type, e.Message);
             _container.SetHtml(_archive?.Html ?? Document ?? string.Empty);
+            cancellationToken.ThrowIfCancellationRequested();
 
             using (var layoutGfx = new WinPrintHtmlGraphics(_adapter, g, RRect.FromLTRB(0, 0, PageSize.Width, 1e6)))
             {
                 _container.PerformLayout(layoutGfx);
             }
 
+            cancellationToken.ThrowIfCancellationRequested();
             double height = _container.ActualSize.Height;
             _pageCount = height <= 0 ? 1 : Math.Max(1, (int)Math.Ceiling(height / PageSize.Height));
-            Log.Debug("Rendered {pages} HTML pages from {height:F0} (1/100\") of content.", _pageCount, height);
+
+            // Paint the whole document once, bucketing the drawing commands by page. The clip covers every
+            // page so HtmlRenderer doesn't skip boxes below the first one.
+            var displayList = new HtmlDisplayList(_pageCount, PageSize.Height);
+            _container.ScrollOffset = RPoint.Empty;
+            var recordClip = RRect.FromLTRB(0, 0, PageSize.Width, _pageCount * PageSize.Height);
+            using (var recordGfx = new WinPrintHtmlGraphics(_adapter, g, recordClip, displayList))
+            {
+                _container.PerformPaint(recordGfx);
+            }
+
+            _displayList = displayList;
+            Log.Debug("Rendered {pages} HTML pages from {height:F0} (1/100\") of content; {commands} draw commands.",
+                _pageCount, height, displayList.CommandCount);
             return await Task.FromResult(_pageCount);
         }
         finally
@@ -147,22 +166,19 @@ public class HtmlCte : ContentTypeEngineBase, IDisposable
     public override void PaintPage(IGraphicsContext g, int pageNum)
     {
         LogService.TraceMessage($"{pageNum}");
-        if (_container is null || _adapter is null)
+        if (_displayList is null || _adapter is null)
         {
             return;
         }
 
         g.SetTextRenderingMode(GraphicsTextRenderingMode);
 
-        // Reuse the single layout; only the paint surface and scroll position change per page.
+        // Replay the page's slice of the recorded paint; the layout itself isn't walked again.
         _adapter.Graphics = g;
         _adapter.DpiY = _dpiY;
-        // Negative scrolls the laid-out content up so page N's slice maps to the top of the surface.
-        _container.ScrollOffset = new RPoint(0, -((pageNum - 1) * PageSize.Height));
-
         var clip = RRect.FromLTRB(0, 0, PageSize.Width, PageSize.Height);
         using var gfx = new WinPrintHtmlGraphics(_adapter, g, clip);
-        _container.PerformPaint(gfx);
+        _displayList.Replay(pageNum, gfx);
     }
 
     private void OnImageLoad(HtmlImageLoadEventArgs e)
@@ -5,6 +5,7 @@ using System.Globalization;
 using System.Net;
 using System.Net.Http;
 using System.Runtime.InteropServices;
+using System.Security.Cryptography;
 using System.Text;
 using System.Text.Json.Serialization;
 using System.Text.RegularExpressions;
@@ -72,6 +73,9 @@ public class MarkdownCte : ContentTypeEngineBase
     /// <summary>Prefix distinguishing rendered mermaid diagrams from image URLs in <see cref="_imageCache" />.</summary>
     private const string MermaidCachePrefix = "mermaid:";
 
+    /// <summary>Most image loads and diagram renders a render runs at once.</summary>
+    private static int MaxPreloadParallelism => Math.Clamp(Environment.ProcessorCount, 2, 8);
+
     private static readonly GraphicsColor TextColor = GraphicsColor.FromRgb(0x1d, 0x1d, 0x1f);
     private static readonly GraphicsColor LinkColor = GraphicsColor.FromRgb(0x0b, 0x57, 0xd0);
     private static readonly GraphicsColor CodeColor = GraphicsColor.FromRgb(0x37, 0x37, 0x37);
@@ -156,7 +160,7 @@ public class MarkdownCte : ContentTypeEngineBase
     }
 
     public override async Task<int> RenderAsync(PrintResolution? printerResolution,
-        EventHandler<string>? reflowProgress)
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken = default)
     {
         LogService.TraceMessage();
         if (Document is null)
@@ -174,7 +178,7 @@ public class MarkdownCte : ContentTypeEngineBase
 
         // Serialize renders: see _renderGate. A queued render runs after the in-flight one and
         // publishes last, so the final published state always reflects the latest settings.
-        await _renderGate.WaitAsync();
+        await _renderGate.WaitAsync(cancellationToken);
         try
         {
             _dpiY = dpiY;
@@ -199,9 +203,11 @@ public class MarkdownCte : ContentTypeEngineBase
                 }
 
                 MarkdownDocument ast = Markdown.Parse(Document, s_pipeline);
-                await PreloadImagesAsync(ast);
-                await PreloadMermaidDiagramsAsync(ast);
+                await PreloadImagesAsync(ast, cancellationToken);
+                await PreloadMermaidDiagramsAsync(ast, cancellationToken);
+                cancellationToken.ThrowIfCancellationRequested();
                 WalkBlocks(ast, g, fontCache, 0, 0);
+                cancellationToken.ThrowIfCancellationRequested();
 
                 _pageCount = Paginate();
                 // Publish for painting only now that the build is complete.
@@ -854,15 +860,20 @@ public class MarkdownCte : ContentTypeEngineBase
         }
     }
 
-    private async Task PreloadImagesAsync(MarkdownDocument ast)
+    /// <summary>
+    ///     Loads every standalone image into <see cref="_imageCache" />, keyed by source URL/path, several
+    ///     at a time; local files and remote URLs go through <see cref="MarkdownResourceCache" />.
+    /// </summary>
+    private async Task PreloadImagesAsync(MarkdownDocument ast, CancellationToken cancellationToken)
     {
+        var urls = new List<string>();
         foreach (ParagraphBlock paragraph in ast.Descendants<ParagraphBlock>())
         {
             if (GetStandaloneImages(paragraph) is { } images)
             {
                 foreach (LinkInline image in images)
                 {
-                    await PreloadImageUrlAsync(image.Url ?? string.Empty);
+                    urls.Add(image.Url ?? string.Empty);
                 }
             }
 
@@ -870,7 +881,7 @@ public class MarkdownCte : ContentTypeEngineBase
             {
                 foreach ((string src, _) in htmlImages)
                 {
-                    await PreloadImageUrlAsync(src);
+                    urls.Add(src);
                 }
             }
         }
@@ -884,9 +895,93 @@ public class MarkdownCte : ContentTypeEngineBase
 
             foreach ((string src, _) in ParseHtmlImages(html))
             {
-                await PreloadImageUrlAsync(src);
+                urls.Add(src);
             }
         }
+
+        await PreloadAsync(urls.Where(u => u.Length > 0)
+            .Select(u => new MarkdownPreloadItem(u, GetImageSharedKey(u), () => LoadImageBytesAsync(u))),
+            cancellationToken);
+    }
+
+    /// <summary>
+    ///     The <see cref="MarkdownResourceCache" /> key for an image: full path, modification time and length
+    ///     for a local file, the URL for a remote one (which <see cref="RenderDiskCache" /> keeps for
+    ///     <see cref="RenderDiskCache.MaxUrlAge" /> before fetching it again). Null (not shared) for
+    ///     <c>data:</c> URIs, which decode cheaply, and for files that don't exist.
+    /// </summary>
+    private string? GetImageSharedKey(string url)
+    {
+        if (url.StartsWith("data:", StringComparison.OrdinalIgnoreCase))
+        {
+            return null;
+        }
+
+        if (url.StartsWith("http://", StringComparison.OrdinalIgnoreCase) ||
+            url.StartsWith("https://", StringComparison.OrdinalIgnoreCase))
+        {
+            return "url:" + url;
+        }
+
+        try
+        {
+            var file = new FileInfo(ResolveLocalPath(url));
+            return file.Exists ? $"file:{file.FullName}|{file.LastWriteTimeUtc.Ticks}|{file.Length}" : null;
+        }
+        catch (Exception ex)
+        {
+            Log.Debug(ex, "Markdown: can't stat image {url}", url);
+            return null;
+        }
+    }
+
+    /// <summary>
+    ///     Loads <paramref name="items" /> into <see cref="_imageCache" /> with at most
+    ///     <see cref="MaxPreloadParallelism" /> loads in flight. Items whose key is already cached (or
+    ///     repeated) load once; items with a <see cref="MarkdownPreloadItem.SharedKey" /> are served from, and
+    ///     added to, <see cref="MarkdownResourceCache" />. The build cache is only written once all loads
+    ///     are done, on the render's own flow. Canceling stops starting loads and waiting for shared ones; a
+    ///     shared load already running still completes into <see cref="MarkdownResourceCache" />.
+    /// </summary>
+    private async Task PreloadAsync(IEnumerable<MarkdownPreloadItem> items, CancellationToken cancellationToken)
+    {
+        var seen = new HashSet<string>(StringComparer.Ordinal);
+        MarkdownPreloadItem[] pending = [.. items.Where(i => !_imageCache.ContainsKey(i.Key) && seen.Add(i.Key))];
+        if (pending.Length == 0)
+        {
+            return;
+        }
+
+        var results = new byte[]?[pending.Length];
+        var hits = new bool[pending.Length];
+        var options = new ParallelOptions
+        {
+            MaxDegreeOfParallelism = MaxPreloadParallelism, CancellationToken = cancellationToken
+        };
+        await Parallel.ForEachAsync(Enumerable.Range(0, pending.Length), options, async (i, token) =>
+        {
+            MarkdownPreloadItem item = pending[i];
+            if (item.SharedKey is null)
+            {
+                results[i] = await item.Load();
+                return;
+            }
+
+            (results[i], hits[i]) = await MarkdownResourceCache.GetOrLoadAsync(item.SharedKey, item.Load)
+                .WaitAsync(token);
+            if (hits[i])
+            {
+                Log.Debug("Markdown: {resource} served from the shared render cache.", item.SharedKey);
+            }
+        });
+
+        for (int i = 0; i < pending.Length; i++)
+        {
+            _imageCache[pending[i].Key] = results[i];
+        }
+
+        Log.Debug("Markdown: preloaded {count} images/diagrams, {hits} from the shared render cache.",
+            pending.Length, hits.Count(h => h));
     }
 
     // ---- mermaid ----------------------------------------------------------------------------------
@@ -894,35 +989,52 @@ public class MarkdownCte : ContentTypeEngineBase
     /// <summary>
     ///     Renders every <c>```mermaid</c> fence to image bytes (via <see cref="MermaidRenderer" /> or
     ///     the <see cref="MermaidBackend" />-selected default) into <see cref="_imageCache" />, keyed
-    ///     by <see cref="MermaidCachePrefix" /> + source so identical diagrams render once. No-op
+    ///     by <see cref="MermaidCachePrefix" /> + source so identical diagrams render once. Diagrams render
+    ///     concurrently; with the default backends the results are shared across renders through
+    ///     <see cref="MarkdownResourceCache" /> (keyed by a hash of the source and the backend). No-op
     ///     unless <see cref="RenderMermaidDiagrams" /> is enabled; a null result marks a failed render
     ///     so the fence falls back to a plain code block.
     /// </summary>
-    private async Task PreloadMermaidDiagramsAsync(MarkdownDocument ast)
+    private async Task PreloadMermaidDiagramsAsync(MarkdownDocument ast, CancellationToken cancellationToken)
     {
         if (!RenderMermaidDiagrams)
         {
             return;
         }
 
-        IMermaidRenderer? renderer = null;
-        foreach (FencedCodeBlock fence in ast.Descendants<FencedCodeBlock>())
+        string[] diagrams = [.. ast.Descendants<FencedCodeBlock>()
+            .Where(IsMermaidFence)
+            .Select(GetFenceText)
+            .Where(d => d.Length > 0)];
+        if (diagrams.Length == 0)
         {
-            if (!IsMermaidFence(fence))
-            {
-                continue;
-            }
+            return;
+        }
 
-            string diagram = GetFenceText(fence);
-            string key = MermaidCachePrefix + diagram;
-            if (diagram.Length == 0 || _imageCache.ContainsKey(key))
-            {
-                continue;
-            }
+        IMermaidRenderer renderer = ResolveMermaidRenderer();
+        await PreloadAsync(diagrams.Select(d =>
+            new MarkdownPreloadItem(MermaidCachePrefix + d, GetMermaidSharedKey(d), () => renderer.RenderAsync(d))),
+            cancellationToken);
+    }
 
-            renderer ??= ResolveMermaidRenderer();
-            _imageCache[key] = await renderer.RenderAsync(diagram);
+    /// <summary>
+    ///     The <see cref="MarkdownResourceCache" /> key for a diagram: the backend (with the version of the
+    ///     builtin renderer, so an upgrade doesn't reuse diagrams it would render differently) plus a hash of
+    ///     the source. Null for an injected <see cref="MermaidRenderer" />, whose output we can't identify by a
+    ///     key.
+    /// </summary>
+    private string? GetMermaidSharedKey(string diagram)
+    {
+        if (MermaidRenderer is not null)
+        {
+            return null;
         }
+
+        string backend = string.Equals(MermaidBackend, "service", StringComparison.OrdinalIgnoreCase)
+            ? "service:" + MermaidServiceUrl
+            : "builtin:" + MermaiderRenderer.Version;
+        string hash = Convert.ToHexString(SHA256.HashData(Encoding.UTF8.GetBytes(diagram)));
+        return $"{MermaidCachePrefix}{backend}:{hash}";
     }
 
     /// <summary>
@@ -991,16 +1103,6 @@ public class MarkdownCte : ContentTypeEngineBase
         return sb.ToString();
     }
 
-    private async Task PreloadImageUrlAsync(string url)
-    {
-        if (url.Length == 0 || _imageCache.ContainsKey(url))
-        {
-            return;
-        }
-
-        _imageCache[url] = await LoadImageBytesAsync(url);
-    }
-
     private async Task<byte[]?> LoadImageBytesAsync(string url)
     {
         if (string.IsNullOrWhiteSpace(url))
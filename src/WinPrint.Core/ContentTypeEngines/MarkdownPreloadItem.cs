@@ -0,0 +1,12 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     An image or Mermaid diagram <see cref="MarkdownCte" /> loads before laying a document out.
+/// </summary>
+/// <param name="Key">The key of the loaded bytes in the render's image cache (URL, or prefixed diagram source).</param>
+/// <param name="SharedKey">The <see cref="MarkdownResourceCache" /> key, or null to always load.</param>
+/// <param name="Load">Loads the bytes; returns null on failure.</param>
+internal readonly record struct MarkdownPreloadItem(string Key, string? SharedKey, Func<Task<byte[]?>> Load);
@@ -0,0 +1,104 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using System.Collections.Concurrent;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Process-wide cache of the image and Mermaid diagram bytes <see cref="MarkdownCte" /> preloads, so a
+///     reflow (a margin tweak, a sheet switch) or the next document of a batch print doesn't re-read local
+///     images or re-rasterize diagrams. Keys identify the content, not the reference: a local image by full
+///     path, modification time and length; a diagram by its source and renderer. Concurrent loads of one key
+///     share a single load. Failed loads (null) aren't kept, so they are retried next time. Entries are
+///     evicted oldest first once more than <see cref="Capacity" /> bytes are cached. A miss is looked up in
+///     <see cref="RenderDiskCache.Current" />, when set, before loading, and what's loaded is stored there.
+/// </summary>
+internal static class MarkdownResourceCache
+{
+    /// <summary>Most bytes kept across all documents.</summary>
+    public const long Capacity = 64L * 1024 * 1024;
+
+    private static readonly ConcurrentDictionary<string, Lazy<Task<byte[]?>>> s_entries = new(StringComparer.Ordinal);
+    private static readonly Queue<(string Key, int Length)> s_order = new();
+    private static readonly Lock s_orderLock = new();
+    private static long s_bytes;
+
+    /// <summary>Bytes currently cached.</summary>
+    public static long CachedBytes
+    {
+        get
+        {
+            lock (s_orderLock)
+            {
+                return s_bytes;
+            }
+        }
+    }
+
+    /// <summary>
+    ///     Returns the bytes cached for <paramref name="key" />, or runs <paramref name="load" /> and caches a
+    ///     non-null result. <c>Hit</c> is true when the bytes came from the cache (or from a load of the same
+    ///     key already in flight).
+    /// </summary>
+    public static async Task<(byte[]? Bytes, bool Hit)> GetOrLoadAsync(string key, Func<Task<byte[]?>> load)
+    {
+        var created = new Lazy<Task<byte[]?>>(() => LoadAsync(key, load));
+        Lazy<Task<byte[]?>> entry = s_entries.GetOrAdd(key, created);
+        if (!ReferenceEquals(entry, created))
+        {
+            return (await entry.Value.ConfigureAwait(false), true);
+        }
+
+        byte[]? bytes;
+        try
+        {
+            bytes = await entry.Value.ConfigureAwait(false);
+        }
+        catch
+        {
+            s_entries.TryRemove(KeyValuePair.Create(key, entry));
+            throw;
+        }
+
+        if (bytes is null)
+        {
+            s_entries.TryRemove(KeyValuePair.Create(key, entry));
+            return (null, false);
+        }
+
+        Admit(key, bytes.Length);
+        return (bytes, false);
+    }
+
+    private static async Task<byte[]?> LoadAsync(string key, Func<Task<byte[]?>> load)
+    {
+        RenderDiskCache? disk = RenderDiskCache.Current;
+        if (disk is not null && await disk.TryReadAsync(key).ConfigureAwait(false) is { } stored)
+        {
+            return stored;
+        }
+
+        byte[]? bytes = await load().ConfigureAwait(false);
+        if (disk is not null && bytes is { Length: > 0 })
+        {
+            await disk.WriteAsync(key, bytes).ConfigureAwait(false);
+        }
+
+        return bytes;
+    }
+
+    private static void Admit(string key, int length)
+    {
+        lock (s_orderLock)
+        {
+            s_order.Enqueue((key, length));
+            s_bytes += length;
+            while (s_bytes > Capacity && s_order.TryDequeue(out (string Key, int Length) oldest))
+            {
+                s_entries.TryRemove(oldest.Key, out _);
+                s_bytes -= oldest.Length;
+            }
+        }
+    }
+}
@@ -22,6 +22,14 @@ public sealed class MermaiderRenderer : IMermaidRenderer
 {
     private const float RasterScale = 2f;
 
+    /// <summary>
+    ///     Versions of the assemblies the rendered PNGs depend on (Mermaider, Svg.Skia, SkiaSharp and this
+    ///     one, which inlines the CSS), so cached diagrams are rendered again after any of them is upgraded.
+    /// </summary>
+    internal static string Version { get; } = string.Join('+',
+        new[] { typeof(Mermaider.MermaidRenderer), typeof(SKSvg), typeof(SKBitmap), typeof(MermaiderRenderer) }
+            .Select(t => t.Assembly.GetName().Version?.ToString() ?? "0"));
+
     public Task<byte[]?> RenderAsync(string diagram)
     {
         // Purely CPU-bound and fast (a few ms); no memoization needed, unlike the network renderer.
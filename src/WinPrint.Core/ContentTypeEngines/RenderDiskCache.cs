@@ -0,0 +1,243 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using System.Buffers.Binary;
+using System.Security.Cryptography;
+using System.Text;
+using Serilog;
+using WinPrint.Core.Services;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Content-addressed on-disk cache for the <see cref="MarkdownResourceCache" /> entries that are
+///     expensive to recreate: rendered Mermaid diagrams (<c>mermaid/&lt;sha256&gt;.png</c>) and fetched
+///     remote images (<c>images/&lt;sha256&gt;.bin</c>), named by the SHA-256 of the entry's key. Lets
+///     repeated runs of <c>wp print</c> (e.g. CI printing the same docs) skip diagram rendering and image
+///     downloads. Each file starts with the SHA-256 of the rest of it: the time it was stored, then the
+///     payload; a file that doesn't match is deleted and treated as a miss. Remote images may change at their
+///     URL, so they are fetched again once older than <see cref="MaxUrlAge" />. Once more than
+///     <see cref="Capacity" /> bytes are stored, the least recently used files (by last-write time, which a
+///     read refreshes) are deleted. I/O failures are logged and treated as misses. Disabled unless a front end
+///     sets <see cref="Current" />.
+/// </summary>
+public sealed class RenderDiskCache
+{
+    /// <summary>Default <see cref="Capacity" />: 256 MB.</summary>
+    public const long DefaultCapacity = 256L * 1024 * 1024;
+
+    private const int HashSize = 32;
+
+    // The SHA-256, then the UTC ticks the entry was stored at.
+    private const int HeaderSize = HashSize + sizeof(long);
+
+    private readonly TimeProvider _timeProvider;
+
+    private readonly Lock _sizeLock = new();
+
+    // Bytes stored, or -1 until the directory is first scanned.
+    private long _bytes = -1;
+
+    public RenderDiskCache(string directory, long capacity = DefaultCapacity, TimeSpan? maxUrlAge = null,
+        TimeProvider? timeProvider = null)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(directory);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(capacity);
+        Directory = directory;
+        Capacity = capacity;
+        MaxUrlAge = maxUrlAge ?? DefaultMaxUrlAge;
+        _timeProvider = timeProvider ?? TimeProvider.System;
+    }
+
+    /// <summary>Default <see cref="MaxUrlAge" />: one day.</summary>
+    public static TimeSpan DefaultMaxUrlAge { get; } = TimeSpan.FromDays(1);
+
+    /// <summary>The cache <see cref="MarkdownCte" /> reads and writes through; <c>null</c> (default): none.</summary>
+    public static RenderDiskCache? Current { get; set; }
+
+    /// <summary>Root directory of the cache.</summary>
+    public string Directory { get; }
+
+    /// <summary>Most bytes stored before least recently used files are deleted.</summary>
+    public long Capacity { get; }
+
+    /// <summary>How long a fetched remote image (a <c>url:</c> key) is used before it is fetched again.</summary>
+    public TimeSpan MaxUrlAge { get; }
+
+    /// <summary>A cache in the <c>cache</c> folder of the settings directory, or <c>null</c> if there's none.</summary>
+    public static RenderDiskCache? CreateDefault()
+    {
+        string? settingsPath = SettingsService.SettingsPath;
+        return string.IsNullOrEmpty(settingsPath) ? null : new RenderDiskCache(Path.Combine(settingsPath, "cache"));
+    }
+
+    /// <summary>
+    ///     Returns the file <paramref name="key" /> is stored in, or <c>null</c> for keys that aren't kept on
+    ///     disk (local images, which are already files).
+    /// </summary>
+    public string? GetPath(string key)
+    {
+        (string Folder, string Extension)? kind =
+            key.StartsWith("mermaid:", StringComparison.Ordinal) ? ("mermaid", ".png")
+            : key.StartsWith("url:", StringComparison.Ordinal) ? ("images", ".bin")
+            : null;
+        if (kind is null)
+        {
+            return null;
+        }
+
+        string name = Convert.ToHexStringLower(SHA256.HashData(Encoding.UTF8.GetBytes(key)));
+        return Path.Combine(Directory, kind.Value.Folder, name + kind.Value.Extension);
+    }
+
+    /// <summary>Returns the bytes stored for <paramref name="key" />, or <c>null</c> if none (or corrupt).</summary>
+    public async Task<byte[]?> TryReadAsync(string key)
+    {
+        string? path = GetPath(key);
+        if (path is null || !File.Exists(path))
+        {
+            return null;
+        }
+
+        try
+        {
+            byte[] file = await File.ReadAllBytesAsync(path).ConfigureAwait(false);
+            if (file.Length < HeaderSize ||
+                !SHA256.HashData(file.AsSpan(HashSize)).AsSpan().SequenceEqual(file.AsSpan(0, HashSize)))
+            {
+                Log.Warning("Render cache: {path} is corrupt; deleting it.", path);
+                Delete(path, file.Length);
+                return null;
+            }
+
+            var stored = new DateTime(BinaryPrimitives.ReadInt64LittleEndian(file.AsSpan(HashSize)), DateTimeKind.Utc);
+            if (key.StartsWith("url:", StringComparison.Ordinal) &&
+                _timeProvider.GetUtcNow().UtcDateTime - stored > MaxUrlAge)
+            {
+                Log.Debug("Render cache: {key} was fetched {stored:u}; fetching it again.", key, stored);
+                Delete(path, file.Length);
+                return null;
+            }
+
+            File.SetLastWriteTimeUtc(path, DateTime.UtcNow);
+            Log.Debug("Render cache: {key} read from {path}.", key, path);
+            return file[HeaderSize..];
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            Log.Debug(ex, "Render cache: failed to read {path}.", path);
+            return null;
+        }
+    }
+
+    /// <summary>Stores <paramref name="bytes" /> for <paramref name="key" />; evicts files if over capacity.</summary>
+    public async Task WriteAsync(string key, byte[] bytes)
+    {
+        string? path = GetPath(key);
+        if (path is null || HeaderSize + bytes.Length > Capacity)
+        {
+            return;
+        }
+
+        byte[] stored = new byte[sizeof(long)];
+        BinaryPrimitives.WriteInt64LittleEndian(stored, _timeProvider.GetUtcNow().UtcTicks);
+        using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+        hash.AppendData(stored);
+        hash.AppendData(bytes);
+
+        // Write to a temporary file and move it into place, so readers never see a partial file.
+        string temp = $"{path}.{Guid.NewGuid():N}.tmp";
+        long replaced;
+        try
+        {
+            System.IO.Directory.CreateDirectory(Path.GetDirectoryName(path)!);
+            await using (FileStream stream = File.Create(temp))
+            {
+                await stream.WriteAsync(hash.GetHashAndReset()).ConfigureAwait(false);
+                await stream.WriteAsync(stored).ConfigureAwait(false);
+                await stream.WriteAsync(bytes).ConfigureAwait(false);
+            }
+
+            // Another writer (or an expired entry) may already have stored this key; its size is replaced.
+            var existing = new FileInfo(path);
+            replaced = existing.Exists ? existing.Length : 0;
+            File.Move(temp, path, true);
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            Log.Debug(ex, "Render cache: failed to write {path}.", path);
+            TryDelete(temp);
+            return;
+        }
+
+        lock (_sizeLock)
+        {
+            _bytes = _bytes < 0 ? StoredFiles().Sum(f => f.Length) : _bytes - replaced + HeaderSize + bytes.Length;
+            if (_bytes > Capacity)
+            {
+                TrimLocked();
+            }
+        }
+    }
+
+    // Deletes least recently used files until the cache is at 90% of capacity, leaving room to grow.
+    private void TrimLocked()
+    {
+        FileInfo[] files = [.. StoredFiles().OrderBy(f => f.LastWriteTimeUtc)];
+        long total = files.Sum(f => f.Length);
+        foreach (FileInfo file in files)
+        {
+            if (total <= Capacity * 9 / 10)
+            {
+                break;
+            }
+
+            if (TryDelete(file.FullName))
+            {
+                total -= file.Length;
+            }
+        }
+
+        Log.Debug("Render cache: trimmed {directory} to {bytes} bytes.", Directory, total);
+        _bytes = total;
+    }
+
+    // Deletes a stored file of `length` bytes and stops counting it.
+    private void Delete(string path, long length)
+    {
+        if (!TryDelete(path))
+        {
+            return;
+        }
+
+        lock (_sizeLock)
+        {
+            if (_bytes >= 0)
+            {
+                _bytes -= length;
+            }
+        }
+    }
+
+    private IEnumerable<FileInfo> StoredFiles()
+    {
+        var root = new DirectoryInfo(Directory);
+        return root.Exists
+            ? root.EnumerateFiles("*", SearchOption.AllDirectories).Where(f => f.Extension != ".tmp")
+            : [];
+    }
+
+    private static bool TryDelete(string path)
+    {
+        try
+        {
+            File.Delete(path);
+            return true;
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            Log.Debug(ex, "Render cache: failed to delete {path}.", path);
+            return false;
+        }
+    }
+}
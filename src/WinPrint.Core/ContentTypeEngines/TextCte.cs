@@ -1,8 +1,9 @@
 // Copyright Kindel, LLC - http://www.kindel.com
 // Published under the MIT License at https://github.com/tig/winprint
 
+using System.Collections.Concurrent;
+using System.Diagnostics;
 using System.Runtime.InteropServices;
-using System.Text;
 using Serilog;
 using WinPrint.Core.Abstractions;
 using WinPrint.Core.Models;
@@ -16,7 +17,11 @@ namespace WinPrint.Core.ContentTypeEngines;
 /// </summary>
 public class TextCte : ContentTypeEngineBase, IDisposable
 {
+    // Minimum time between progressive page publications after the first page.
+    private static readonly TimeSpan s_publishInterval = TimeSpan.FromMilliseconds(100);
     private static readonly string[] s_supportedContentTypes = ["text/plain"];
+    private static readonly Func<WrappedLine, int, WrappedLine> s_renumber = Renumber;
+    private static readonly Func<WrappedLine> s_blank = static () => new WrappedLine { Text = "" };
     private IGraphicsFont? _cachedFont;
 
     // Protected implementation of Dispose pattern.
@@ -27,7 +32,24 @@ public class TextCte : ContentTypeEngineBase, IDisposable
 
     private float _lineNumberWidth;
     private int _linesPerPage;
-    private int _minLineLen;
+
+    // True once a reflow has laid out the whole document; AppendAsync extends only a complete layout.
+    private bool _layoutComplete;
+
+    // Line number counter after the last source line laid out (the next line is numbered from it).
+    private int _lineNumber;
+
+    // Serializes use of the measurement context by the per-chunk wrappers.
+    private readonly Lock _measureLock = new();
+
+    // Guards the layout (wrapped lines/anchors, wrapper) shared by the reflow thread and PaintPage.
+    private readonly Lock _pagesLock = new();
+
+    // When streaming from a DocumentSource only page anchors are kept; pages are re-wrapped on demand.
+    private List<TextPageAnchor>? _pageAnchors;
+
+    // Glyph-advance wrap engine for the current reflow (per measurement font).
+    private GlyphAdvanceWrapper? _wrapper;
 
     // All of the lines of the text file, after reflow/line-wrap
     private List<WrappedLine>? _wrappedLines;
@@ -37,6 +59,12 @@ public class TextCte : ContentTypeEngineBase, IDisposable
     /// </summary>
     public override string[] SupportedContentTypes => s_supportedContentTypes;
 
+    public override bool SupportsDocumentSource => true;
+
+    // An in-memory page is copied out under _pagesLock and drawn with a font created per call; a streamed
+    // page is re-wrapped through the shared _wrapper.
+    public override bool SupportsConcurrentPainting => _pageAnchors is null;
+
     public void Dispose()
     {
         Dispose(true);
@@ -59,7 +87,9 @@ public class TextCte : ContentTypeEngineBase, IDisposable
                 _cachedFont.Dispose();
             }
 
+            _wrapper = null;
             _wrappedLines = null;
+            _pageAnchors = null;
         }
 
         _disposed = true;
@@ -78,13 +108,14 @@ public class TextCte : ContentTypeEngineBase, IDisposable
     /// <param name="e"></param>
     /// <param name="printerResolution"></param>
     /// <param name="reflowProgress"></param>
+    /// <param name="cancellationToken"></param>
     /// <returns></returns>
     public override async Task<int> RenderAsync(PrintResolution? printerResolution,
-        EventHandler<string>? reflowProgress)
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken = default)
     {
         LogService.TraceMessage();
 
-        if (Document is null)
+        if (Document is null && DocumentSource is null)
         {
             throw new InvalidOperationException("Document can't be null for Render");
         }
@@ -112,48 +143,81 @@ public class TextCte : ContentTypeEngineBase, IDisposable
 
         try
         {
-            // Calculate the number of lines per page; first we need our font. Keep it around.
-            _cachedFont?.Dispose();
-            _cachedFont = g.CreateFont(ContentSettings!.Font.Family, ContentSettings.Font.Size / 72F * 96F,
-                (GraphicsFontStyle)ContentSettings.Font.Style, GraphicsFontUnit.Pixel);
+            // Nothing is paintable until the first page of this reflow has been laid out.
+            PublishPages(0, reflowProgress);
 
-            _lineHeight = _cachedFont.GetHeight(dpiY);
-
-            if (PageSize.Height < _lineHeight)
+            // Layout state is swapped under the lock so a concurrent PaintPage sees either the old or
+            // the new reflow, never a mix.
+            lock (_pagesLock)
             {
-                throw new InvalidOperationException(
-                    $"The line height ({_lineHeight:F2}) is greater than page height ({PageSize.Height:F2}). " +
-                    $"PageSize={PageSize.Width:F2}x{PageSize.Height:F2}, Font={ContentSettings.Font.Family} {ContentSettings.Font.Size}pt, DPI={dpiY}");
-            }
+                _layoutComplete = false;
 
-            // Round down # of lines per page to ensure lines don't clip on bottom
-            _linesPerPage = (int)Math.Floor(PageSize.Height / _lineHeight);
+                // Calculate the number of lines per page; first we need our font. Keep it around.
+                _cachedFont?.Dispose();
+                _cachedFont = g.CreateFont(ContentSettings!.Font.Family, ContentSettings.Font.Size / 72F * 96F,
+                    (GraphicsFontStyle)ContentSettings.Font.Style, GraphicsFontUnit.Pixel);
 
-            // 3 digits + 1 wide - Will support 999 lines before line numbers start to not fit
-            // TODO: Make line number width dynamic
-            // Note, MeasureString is actually dependent on lineNumberWidth!
-            _lineNumberWidth = ContentSettings.LineNumbers
-                ? MeasureString(g, new string('0', 4), _cachedFont).Width
-                : 0;
+                _lineHeight = _cachedFont.GetHeight(dpiY);
+
+                if (PageSize.Height < _lineHeight)
+                {
+                    throw new InvalidOperationException(
+                        $"The line height ({_lineHeight:F2}) is greater than page height ({PageSize.Height:F2}). " +
+                        $"PageSize={PageSize.Width:F2}x{PageSize.Height:F2}, Font={ContentSettings.Font.Family} {ContentSettings.Font.Size}pt, DPI={dpiY}");
+                }
+
+                // Round down # of lines per page to ensure lines don't clip on bottom
+                _linesPerPage = (int)Math.Floor(PageSize.Height / _lineHeight);
+
+                // 3 digits + 1 wide - Will support 999 lines before line numbers start to not fit
+                // TODO: Make line number width dynamic
+                // Note, MeasureString is actually dependent on lineNumberWidth!
+                _lineNumberWidth = ContentSettings.LineNumbers
+                    ? MeasureString(g, new string('0', 4), _cachedFont).Width
+                    : 0;
 
-            // This is the shortest line length (in chars) that we think we'll see.
-            // This is used as a performance optimization (probably premature) and
-            // could be 0 with no functional change.
-            _minLineLen = (int)((PageSize.Width - _lineNumberWidth) / MeasureString(g, "W", _cachedFont).Width);
+                // Each distinct glyph is measured once; wrapping is then a linear scan per line.
+                _wrapper = new GlyphAdvanceWrapper(g, _cachedFont, PageSize.Width - _lineNumberWidth, _lineHeight,
+                    _measureLock);
 
-            // Note, MeasureLines may increment numPages due to form feeds and line wrapping
-            _wrappedLines = LineWrapDocument(g, Document); // new List<string>();
+                // When streaming from a DocumentSource only page anchors are kept (memory bounded by the
+                // page count); otherwise every wrapped line is.
+                _wrappedLines = DocumentSource is null ? [] : null;
+                _pageAnchors = DocumentSource is null ? null : [];
+            }
 
-            int n = (int)Math.Ceiling(_wrappedLines.Count / (double)_linesPerPage);
+            // Wrap off the caller's thread so pages published along the way can be painted meanwhile.
+            int wrappedLineCount = await Task.Run(
+                    () => LineWrapDocumentAsync(g, reflowProgress, cancellationToken), cancellationToken)
+                .ConfigureAwait(false);
+            int n = (int)Math.Ceiling(wrappedLineCount / (double)_linesPerPage);
+            lock (_pagesLock)
+            {
+                _layoutComplete = true;
+            }
+
+            PublishPages(n, reflowProgress);
 
             Log.Debug("Rendered {pages} pages of {linesperpage} lines per page, for a total of {lines} lines.", n,
-                _linesPerPage, _wrappedLines.Count);
+                _linesPerPage, wrappedLineCount);
+            Log.Debug("Measured {glyphs} distinct glyphs (fixed pitch: {fixedPitch}).",
+                _wrapper!.MeasuredGlyphCount, _wrapper.IsFixedPitch);
 
-            return await Task.FromResult(n);
+            return n;
         }
         finally
         {
-            ownedContext?.Dispose();
+            if (ownedContext is not null)
+            {
+                // Every glyph in the document has been measured (and merged into _wrapper); streamed pages
+                // re-wrap without the context this reflow created.
+                lock (_pagesLock)
+                {
+                    _wrapper?.Detach();
+                }
+
+                ownedContext.Dispose();
+            }
         }
     }
 
@@ -161,44 +225,203 @@ public class TextCte : ContentTypeEngineBase, IDisposable
     ///     This does the heavy-weight task of ensuring each line will fit PageSize.Width by
     ///     wrapping them. It also does tab expansion (which is naive for variable-pitched fonts) and
     ///     Supports form-feeds.
+    ///     Chunks of the document are wrapped concurrently, each by a wrapper with its own measurement font
+    ///     (see <see cref="ContentTypeEngineBase.WrapChunksAsync{TChunk}" />), and stitched in order.
+    ///     Pages are published (see <see cref="ContentTypeEngineBase.PublishPages" />) as they fill: the first
+    ///     as soon as it is complete, then at most every <see cref="s_publishInterval" />.
     /// </summary>
-    /// <param name="g"></param>
-    /// <param name="document"></param>
-    /// <returns></returns>
-    private List<WrappedLine> LineWrapDocument(IGraphicsContext g, string document)
+    /// <param name="g">The measurement context.</param>
+    /// <param name="reflowProgress"></param>
+    /// <param name="cancellationToken"></param>
+    /// <returns>The total number of wrapped lines.</returns>
+    private async Task<int> LineWrapDocumentAsync(IGraphicsContext g, EventHandler<string>? reflowProgress,
+        CancellationToken cancellationToken)
     {
-        // TODO: Profile for performance
-        // LogService.TraceMessage();
-        var wrapped = new List<WrappedLine>();
+        var wrappers = new ConcurrentBag<GlyphAdvanceWrapper>();
+        var scratch = new List<WrappedLine>();
+        int total = 0;
+        int lineCount = 0;
+        int published = 0;
+        long lastPublished = Stopwatch.GetTimestamp();
 
+        try
+        {
+            await WrapChunksAsync(ReadDocumentLines(), (firstLine, lines) =>
+            {
+                if (!wrappers.TryTake(out GlyphAdvanceWrapper? wrapper))
+                {
+                    wrapper = CreateChunkWrapper(g);
+                }
 
-        int lineCount = 0;
+                try
+                {
+                    var chunk = new WrapChunk<WrappedLine>(firstLine, lines);
+                    foreach (string line in lines)
+                    {
+                        WrapSourceLine(chunk, line, wrapper);
+                    }
+
+                    return chunk;
+                }
+                finally
+                {
+                    wrappers.Add(wrapper);
+                }
+            }, chunk =>
+            {
+                lock (_pagesLock)
+                {
+                    for (int i = 0; i < chunk.Count; i++)
+                    {
+                        if (_pageAnchors is null)
+                        {
+                            chunk.Stitch(i, lineCount, _wrappedLines!, 0, _linesPerPage, s_renumber, s_blank);
+                            continue;
+                        }
+
+                        scratch.Clear();
+                        chunk.Stitch(i, lineCount, scratch, total, _linesPerPage, s_renumber, s_blank);
+
+                        // First wrapped line of the next page is the (_pageAnchors.Count * _linesPerPage)th overall
+                        while ((long)_pageAnchors.Count * _linesPerPage < total + scratch.Count)
+                        {
+                            _pageAnchors.Add(new TextPageAnchor(chunk.FirstSourceLine + i,
+                                _pageAnchors.Count * _linesPerPage - total, lineCount + chunk.LineNumberBefore(i)));
+                        }
+
+                        total += scratch.Count;
+                    }
+
+                    if (_pageAnchors is null)
+                    {
+                        total = _wrappedLines!.Count;
+                    }
+                }
+
+                lineCount += chunk.LineNumber;
 
-        // convert string to stream
-        byte[] byteArray = Encoding.UTF8.GetBytes(document);
-        var stream = new MemoryStream(byteArray);
-        var reader = new StreamReader(stream);
-        while (reader.ReadLine() is { } line)
+                int complete = total / _linesPerPage;
+                if (complete > published &&
+                    (published == 0 || Stopwatch.GetElapsedTime(lastPublished) >= s_publishInterval))
+                {
+                    published = complete;
+                    lastPublished = Stopwatch.GetTimestamp();
+                    PublishPages(published, reflowProgress);
+                }
+            }, cancellationToken).ConfigureAwait(false);
+        }
+        finally
         {
-            // Expand tabs
-            if (ContentSettings!.TabSpaces > 0)
+            // The streaming path re-wraps pages with _wrapper, so it has to know every glyph any chunk
+            // measured to wrap them identically.
+            lock (_pagesLock)
             {
-                line = line.Replace("\t", new string(' ', ContentSettings.TabSpaces));
+                foreach (GlyphAdvanceWrapper wrapper in wrappers)
+                {
+                    _wrapper!.MergeFrom(wrapper);
+                    wrapper.Font.Dispose();
+                }
+
+                _lineNumber = lineCount;
             }
+        }
 
-            ++lineCount;
-            if (ContentSettings.NewPageOnFormFeed && line.Contains("\f"))
+        return total;
+    }
+
+    /// <summary>
+    ///     Wraps the appended lines with the last reflow's wrapper and stitches them onto the end of the wrapped
+    ///     lines, so pages already laid out stay as they are (the last one may fill up). Not supported when
+    ///     streaming from a <see cref="ContentTypeEngineBase.DocumentSource" />, where only page anchors are
+    ///     kept, or when the last reflow created (and disposed) its own measurement context.
+    /// </summary>
+    public override async Task<int> AppendAsync(string text, EventHandler<string>? reflowProgress,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(text);
+
+        GlyphAdvanceWrapper? wrapper;
+        List<WrappedLine>? wrappedLines;
+        lock (_pagesLock)
+        {
+            wrapper = _wrapper;
+            wrappedLines = _wrappedLines;
+            if (!_layoutComplete || wrappedLines is null || wrapper is null || MeasurementContext is null ||
+                Document is not { Length: > 0 } document || document[^1] != '\n')
             {
-                lineCount = ExpandFormFeeds(g, wrapped, line, lineCount);
+                return -1;
             }
-            else
+        }
+
+        var chunk = new WrapChunk<WrappedLine>(0, [.. ReadStringLines(text, 0)]);
+        await Task.Run(() =>
+        {
+            foreach (string line in chunk.SourceLines)
             {
-                //Log.Debug("Line {num}: {line}", lineCount, line);
-                lineCount = AddLine(g, wrapped, line, lineCount);
+                WrapSourceLine(chunk, line, wrapper);
             }
+        }, cancellationToken).ConfigureAwait(false);
+        cancellationToken.ThrowIfCancellationRequested();
+
+        int pages;
+        lock (_pagesLock)
+        {
+            for (int i = 0; i < chunk.Count; i++)
+            {
+                chunk.Stitch(i, _lineNumber, wrappedLines, 0, _linesPerPage, s_renumber, s_blank);
+            }
+
+            _lineNumber += chunk.LineNumber;
+            AppendToDocument(text);
+            pages = (int)Math.Ceiling(wrappedLines.Count / (double)_linesPerPage);
+        }
+
+        PublishPages(pages, reflowProgress);
+        Log.Debug("Appended {lines} lines; {pages} pages.", chunk.Count, pages);
+        return pages;
+    }
+
+    /// <summary>
+    ///     Creates a wrapper, with its own measurement font, for wrapping one chunk at a time on a worker
+    ///     thread.
+    /// </summary>
+    private GlyphAdvanceWrapper CreateChunkWrapper(IGraphicsContext g)
+    {
+        IGraphicsFont font;
+        lock (_measureLock)
+        {
+            font = g.CreateFont(ContentSettings!.Font.Family, ContentSettings.Font.Size / 72F * 96F,
+                (GraphicsFontStyle)ContentSettings.Font.Style, GraphicsFontUnit.Pixel);
         }
 
-        return wrapped;
+        return new GlyphAdvanceWrapper(g, font, _wrapper!.MaxWidth, _lineHeight, _measureLock);
+    }
+
+    /// <summary>
+    ///     Expands tabs and form feeds in one source line and appends its wrapped lines to
+    ///     <paramref name="chunk" />. Form feeds are recorded as page breaks and padded when the chunk is
+    ///     stitched (see <see cref="WrapChunk{TLine}.Stitch" />).
+    /// </summary>
+    private void WrapSourceLine(WrapChunk<WrappedLine> chunk, string line, GlyphAdvanceWrapper wrapper)
+    {
+        // Expand tabs
+        if (ContentSettings!.TabSpaces > 0)
+        {
+            line = line.Replace("\t", new string(' ', ContentSettings.TabSpaces));
+        }
+
+        ++chunk.LineNumber;
+        if (ContentSettings.NewPageOnFormFeed && line.Contains('\f'))
+        {
+            ExpandFormFeeds(chunk, line, wrapper);
+        }
+        else
+        {
+            //Log.Debug("Line {num}: {line}", chunk.LineNumber, line);
+            wrapper.Wrap(line, chunk.LineNumber, chunk.Lines);
+        }
+
+        chunk.EndSourceLine();
     }
 
     /// <summary>
@@ -209,12 +432,10 @@ public class TextCte : ContentTypeEngineBase, IDisposable
     ///     next page
     ///     FF at end of line - Next line should be top of next page
     /// </summary>
-    /// <param name="g"></param>
-    /// <param name="list"></param>
+    /// <param name="chunk"></param>
     /// <param name="line"></param>
-    /// <param name="lineCount"></param>
-    /// <returns></returns>
-    private int ExpandFormFeeds(IGraphicsContext g, List<WrappedLine> list, string line, int lineCount)
+    /// <param name="wrapper"></param>
+    private static void ExpandFormFeeds(WrapChunk<WrappedLine> chunk, string line, GlyphAdvanceWrapper wrapper)
     {
         string lineToAdd = "";
 
@@ -225,23 +446,16 @@ public class TextCte : ContentTypeEngineBase, IDisposable
                 if (lineToAdd.Length > 0)
                 {
                     // FF was NOT at start of line. Add it.
-                    AddLine(g, list, lineToAdd, lineCount);
+                    wrapper.Wrap(lineToAdd, chunk.LineNumber, chunk.Lines);
                     // if we're not at the end of the line t increment line #
                     if (i < line.Length - 1)
                     {
-                        lineCount++;
+                        chunk.LineNumber++;
                     }
                 }
 
-                // Add blank lines to get to next page
-                while (list.Count % _linesPerPage != 0)
-                {
-                    var newLine = new WrappedLine { Text = "", NonWrappedLineNumber = 0 };
-#if DEBUG
-                    newLine.TextNonWrapped = line;
-#endif
-                    list.Add(newLine);
-                }
+                // Blank lines to get to next page are added when the chunk is stitched
+                chunk.AddPageBreak();
 
                 // Now on next line
                 lineToAdd = "";
@@ -254,71 +468,18 @@ public class TextCte : ContentTypeEngineBase, IDisposable
 
         if (lineToAdd.Length > 0)
         {
-            AddLine(g, list, lineToAdd, lineCount);
+            wrapper.Wrap(lineToAdd, chunk.LineNumber, chunk.Lines);
         }
-
-        return lineCount;
     }
 
-    /// <summary>
-    ///     Add a 'full length' line to the wrapped lines list. This function (which is recursive)
-    ///     parses the passed line, finding the truncated version that will JUST fit in Page.Width
-    ///     using GDI+'s MeasureString functionality. It then adds that truncated line to the wrapped line
-    ///     list and runs recursively on the remainder.
-    /// </summary>
-    /// <param name="g"></param>
-    /// <param name="wrappedList"></param>
-    /// <param name="lineToAdd">The, potentially, too-long line to wrap.</param>
-    /// <param name="lineCount"></param>
-    /// <returns></returns>
-    private int AddLine(IGraphicsContext g, List<WrappedLine> wrappedList, string lineToAdd, int lineCount)
+    private static WrappedLine Renumber(WrappedLine line, int lineNumberOffset)
     {
-        // TODO: Profile AddLine for performance
-        MeasureString(g, lineToAdd, _cachedFont!, out int numCharsThatFit, out int l1);
-        //Log.Debug("   AddLine: {lineToAdd} - this line should {not}wrap", lineToAdd, lineToAdd.Length <= numCharsThatFit ? "not " : "");
-        if (lineToAdd.Length > numCharsThatFit)
+        if (line.NonWrappedLineNumber > 0)
         {
-            // TODO: should this be >?
-            // This line wraps. Figure out by how much.
-            // Starting at minLineLen into the line, keep trying until it wraps again
-            // For fixed-pitch fonts, minLineLen will match exactly, so all this is not needed
-            // But for variable-pitched fonts, we have to char-by-char
-            int start = 0;
-            int end = _minLineLen;
-            for (int i = _minLineLen; i <= lineToAdd.Length; i++)
-            {
-                string truncatedLine = lineToAdd[start..end++];
-                MeasureString(g, truncatedLine, _cachedFont!, out int numCharsThatFitTruncated, out int l2);
-                if (truncatedLine.Length > numCharsThatFitTruncated)
-                {
-                    // The truncated line now too big, so shorten it by one char and add it
-                    truncatedLine = truncatedLine[..^1];
-                    var wl = new WrappedLine { Text = truncatedLine, NonWrappedLineNumber = lineCount };
-#if DEBUG
-                    wl.TextNonWrapped = lineToAdd;
-                    //Log.Debug("   Adding shorter line to list: {truncatedLine}, {nonWrappedLineNumber}, {textNonWrapped}", wl.text, wl.nonWrappedLineNumber, wl.textNonWrapped);
-#endif
-                    wrappedList.Add(wl);
-
-                    // Recurse with the rest of the line
-                    AddLine(g, wrappedList, lineToAdd[truncatedLine.Length..], 0);
-
-                    // exit for loop
-                    break;
-                }
-            }
-        }
-        else
-        {
-            var wl = new WrappedLine { Text = lineToAdd, NonWrappedLineNumber = lineCount };
-#if DEBUG
-            wl.TextNonWrapped = lineToAdd;
-            //Log.Debug("   Adding passed to list: {truncatedLine}, {nonWrappedLineNumber}, {textNonWrapped}", wl.text, wl.nonWrappedLineNumber, wl.textNonWrapped);
-#endif
-            wrappedList.Add(wl);
+            line.NonWrappedLineNumber += lineNumberOffset;
         }
 
-        return lineCount;
+        return line;
     }
 
     /// <summary>
@@ -329,7 +490,7 @@ public class TextCte : ContentTypeEngineBase, IDisposable
     public override void PaintPage(IGraphicsContext g, int pageNum)
     {
         LogService.TraceMessage($"{pageNum}");
-        if (_wrappedLines == null)
+        if (_wrappedLines == null && _pageAnchors == null)
         {
             Log.Debug("wrappedLines must not be null");
             return;
@@ -338,29 +499,28 @@ public class TextCte : ContentTypeEngineBase, IDisposable
         g.SetTextRenderingMode(GraphicsTextRenderingMode);
         using IGraphicsFont paintFont = CreatePaintFont(g);
 
-        // Paint each line of the file (each element of _wrappedLines that go on pageNum
-        int firstLineInWrappedLines = _linesPerPage * (pageNum - 1);
+        // Paint each line of the file that goes on pageNum
+        List<WrappedLine> pageLines = GetPageLines(pageNum);
         int i;
-        for (i = firstLineInWrappedLines;
-             i < firstLineInWrappedLines + _linesPerPage && i < _wrappedLines.Count;
-             i++)
+        for (i = 0; i < pageLines.Count; i++)
         {
-            float yPos = (i - _linesPerPage * (pageNum - 1)) * _lineHeight;
+            WrappedLine wrappedLine = pageLines[i];
+            float yPos = i * _lineHeight;
 
             // Right justify line number
             int x = ContentSettings!.LineNumberSeparator
                 ? (int)(_lineNumberWidth - 6 -
-                        MeasureString(g, $"{_wrappedLines[i].NonWrappedLineNumber}", paintFont).Width)
+                        MeasureString(g, $"{wrappedLine.NonWrappedLineNumber}", paintFont).Width)
                 : 0;
 
             // Line #s
-            if (_wrappedLines[i].NonWrappedLineNumber > 0)
+            if (wrappedLine.NonWrappedLineNumber > 0)
             {
                 if (ContentSettings.LineNumbers && _lineNumberWidth != 0)
                 {
                     // TOOD: Figure out how to make the spacing around separator more dynamic
                     // TODO: Allow a different (non-monospace) font for line numbers
-                    g.DrawString($"{_wrappedLines[i].NonWrappedLineNumber}", paintFont, g.GrayBrush, x, yPos,
+                    g.DrawString($"{wrappedLine.NonWrappedLineNumber}", paintFont, g.GrayBrush, x, yPos,
                         GraphicsStringFormat);
                 }
             }
@@ -373,7 +533,7 @@ public class TextCte : ContentTypeEngineBase, IDisposable
             }
 
             // Text
-            g.DrawString(_wrappedLines[i].Text, paintFont, g.BlackBrush, _lineNumberWidth, yPos,
+            g.DrawString(wrappedLine.Text, paintFont, g.BlackBrush, _lineNumberWidth, yPos,
                 GraphicsStringFormat);
             if (ContentSettings.Diagnostics)
             {
@@ -384,6 +544,51 @@ public class TextCte : ContentTypeEngineBase, IDisposable
         Log.Debug("Painted {lineOnPage} lines.", i - 1);
     }
 
+    /// <summary>
+    ///     Returns the wrapped lines on <paramref name="pageNum" />; when streaming, the page is re-wrapped from
+    ///     its anchor in the source.
+    /// </summary>
+    private List<WrappedLine> GetPageLines(int pageNum)
+    {
+        lock (_pagesLock)
+        {
+            return GetPageLinesLocked(pageNum);
+        }
+    }
+
+    private List<WrappedLine> GetPageLinesLocked(int pageNum)
+    {
+        if (_pageAnchors is null)
+        {
+            int first = _linesPerPage * (pageNum - 1);
+            return first < 0 || first >= _wrappedLines!.Count
+                ? []
+                : _wrappedLines.GetRange(first, Math.Min(_linesPerPage, _wrappedLines.Count - first));
+        }
+
+        if (pageNum < 1 || pageNum > _pageAnchors.Count)
+        {
+            return [];
+        }
+
+        TextPageAnchor anchor = _pageAnchors[pageNum - 1];
+        int baseCount = ((-anchor.SkipWrappedLines % _linesPerPage) + _linesPerPage) % _linesPerPage;
+        var lines = new List<WrappedLine>();
+        var chunk = new WrapChunk<WrappedLine>(anchor.SourceLine, []);
+        foreach (string line in DocumentSource!.ReadLines(anchor.SourceLine))
+        {
+            WrapSourceLine(chunk, line, _wrapper!);
+            chunk.Stitch(chunk.Count - 1, anchor.LineCount, lines, baseCount, _linesPerPage, s_renumber, s_blank);
+            if (lines.Count >= anchor.SkipWrappedLines + _linesPerPage)
+            {
+                break;
+            }
+        }
+
+        int count = Math.Clamp(lines.Count - anchor.SkipWrappedLines, 0, _linesPerPage);
+        return lines.GetRange(Math.Min(anchor.SkipWrappedLines, lines.Count), count);
+    }
+
     private IGraphicsFont CreatePaintFont(IGraphicsContext g)
     {
         GraphicsFontUnit unit = g.IsDisplayUnit ? GraphicsFontUnit.Point : GraphicsFontUnit.Pixel;
@@ -0,0 +1,346 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using System.Buffers;
+using System.Text;
+using Microsoft.Win32.SafeHandles;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     A streaming, memory-bounded view of a text file for the line-oriented content engines
+///     (<see cref="TextCte" />, <see cref="TextMateCte" />, <see cref="AnsiCte" />). Lines are decoded on
+///     demand straight from the file with positional reads; nothing but a sparse index (the byte offset of
+///     every <see cref="CheckpointInterval" />th line) is kept, so memory is bounded by the longest line
+///     rather than the file size. Line breaks follow <see cref="TextReader.ReadLine" />: <c>\n</c>,
+///     <c>\r\n</c>, and a lone <c>\r</c>.
+///     Enumerations are independent of each other (no shared file position), so pages can be read
+///     concurrently.
+/// </summary>
+public sealed class TextFileLineSource : IDisposable
+{
+    /// <summary>A byte offset is recorded for every line whose index is a multiple of this.</summary>
+    public const int CheckpointInterval = 1024;
+
+    private const int BufferSize = 64 * 1024;
+
+    private readonly List<long> _checkpoints = [];
+    private readonly byte[] _cr;
+    private readonly SafeFileHandle _handle;
+    private readonly byte[] _lf;
+    private readonly Lock _lock = new();
+    private readonly int _unit;
+    private bool _disposed;
+    private int _lineCount = -1;
+
+    /// <summary>
+    ///     Opens <paramref name="filePath" /> for streaming. The file is shared for read/write so a log that
+    ///     is still being appended to can be opened.
+    /// </summary>
+    public TextFileLineSource(string filePath, Encoding encoding)
+    {
+        ArgumentException.ThrowIfNullOrEmpty(filePath);
+        ArgumentNullException.ThrowIfNull(encoding);
+
+        FilePath = filePath;
+        Encoding = encoding;
+        _handle = File.OpenHandle(filePath, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
+        Length = RandomAccess.GetLength(_handle);
+
+        _lf = encoding.GetBytes("\n");
+        _cr = encoding.GetBytes("\r");
+        _unit = Math.Max(1, _lf.Length);
+
+        // Skip the byte order mark, as StreamReader does.
+        ReadOnlySpan<byte> preamble = encoding.Preamble;
+        ContentStart = 0;
+        if (preamble.Length > 0 && Length >= preamble.Length)
+        {
+            Span<byte> head = stackalloc byte[preamble.Length];
+            if (RandomAccess.Read(_handle, head, 0) == preamble.Length && head.SequenceEqual(preamble))
+            {
+                ContentStart = preamble.Length;
+            }
+        }
+
+        _checkpoints.Add(ContentStart);
+    }
+
+    /// <summary>Path of the underlying file.</summary>
+    public string FilePath { get; }
+
+    /// <summary>Encoding used to decode lines.</summary>
+    public Encoding Encoding { get; }
+
+    /// <summary>Size of the file in bytes when it was opened.</summary>
+    public long Length { get; }
+
+    /// <summary>Byte offset of the first content byte (past any byte order mark).</summary>
+    public long ContentStart { get; }
+
+    /// <summary>Number of lines, or -1 until an enumeration has reached the end of the file.</summary>
+    public int LineCount
+    {
+        get
+        {
+            lock (_lock)
+            {
+                return _lineCount;
+            }
+        }
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        _handle.Dispose();
+    }
+
+    /// <summary>
+    ///     Returns the number of lines, scanning (and indexing) the file once if that hasn't happened yet.
+    ///     Lines are not decoded during the scan.
+    /// </summary>
+    public int CountLines()
+    {
+        int count = LineCount;
+        if (count >= 0)
+        {
+            return count;
+        }
+
+        foreach (string _ in ReadLines(int.MaxValue))
+        {
+        }
+
+        return LineCount;
+    }
+
+    /// <summary>
+    ///     Enumerates lines starting at line <paramref name="firstLine" /> (0-based). Seeks to the nearest
+    ///     indexed line at or before it and skips forward without decoding.
+    /// </summary>
+    public IEnumerable<string> ReadLines(int firstLine = 0)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        ArgumentOutOfRangeException.ThrowIfNegative(firstLine);
+
+        long offset;
+        int line;
+        lock (_lock)
+        {
+            int checkpoint = Math.Min(firstLine / CheckpointInterval, _checkpoints.Count - 1);
+            offset = _checkpoints[checkpoint];
+            line = checkpoint * CheckpointInterval;
+        }
+
+        return ReadLinesFrom(offset, line, firstLine);
+    }
+
+    /// <summary>
+    ///     Enumerates the raw content bytes (past any byte order mark) in chunks of at most
+    ///     <paramref name="chunkSize" /> bytes. Each chunk is a new, exactly sized array.
+    /// </summary>
+    public IEnumerable<byte[]> ReadBytes(int chunkSize = BufferSize)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(chunkSize);
+
+        return ReadBytesFrom(ContentStart, chunkSize);
+    }
+
+    /// <summary>
+    ///     Enumerates the raw bytes from byte <paramref name="offset" /> (e.g. a position recorded while
+    ///     reading an earlier enumeration) in chunks of at most <paramref name="chunkSize" /> bytes.
+    /// </summary>
+    public IEnumerable<byte[]> ReadBytes(long offset, int chunkSize)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        ArgumentOutOfRangeException.ThrowIfLessThan(offset, ContentStart);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(chunkSize);
+
+        return ReadBytesFrom(offset, chunkSize);
+    }
+
+    /// <summary>
+    ///     Decodes the whole file into one string, for engines that need the complete document (e.g.
+    ///     Markdown, HTML).
+    /// </summary>
+    public string ReadToEnd()
+    {
+        using var stream = new FileStream(FilePath, FileMode.Open, FileAccess.Read,
+            FileShare.ReadWrite | FileShare.Delete);
+        using var reader = new StreamReader(stream, Encoding);
+        return reader.ReadToEnd();
+    }
+
+    private IEnumerable<byte[]> ReadBytesFrom(long offset, int chunkSize)
+    {
+        byte[] buffer = new byte[chunkSize];
+        while (true)
+        {
+            int read = RandomAccess.Read(_handle, buffer, offset);
+            if (read == 0)
+            {
+                yield break;
+            }
+
+            offset += read;
+            yield return read == buffer.Length ? buffer : buffer[..read];
+            buffer = new byte[chunkSize];
+        }
+    }
+
+    private IEnumerable<string> ReadLinesFrom(long offset, int line, int firstLine)
+    {
+        byte[] buffer = ArrayPool<byte>.Shared.Rent(BufferSize);
+        try
+        {
+            // Valid data is buffer[0..end); the current line starts at lineStart and scanning resumes at
+            // pos. bufferOffset is the file offset of buffer[0].
+            long bufferOffset = offset;
+            int lineStart = 0;
+            int pos = 0;
+            int end = 0;
+            bool eof = false;
+            bool needMore = true;
+
+            while (true)
+            {
+                if (needMore)
+                {
+                    needMore = false;
+                    if (lineStart > 0)
+                    {
+                        Buffer.BlockCopy(buffer, lineStart, buffer, 0, end - lineStart);
+                        bufferOffset += lineStart;
+                        pos -= lineStart;
+                        end -= lineStart;
+                        lineStart = 0;
+                    }
+
+                    if (end == buffer.Length)
+                    {
+                        // A line longer than the buffer: grow to hold it.
+                        byte[] larger = ArrayPool<byte>.Shared.Rent(buffer.Length * 2);
+                        Buffer.BlockCopy(buffer, 0, larger, 0, end);
+                        ArrayPool<byte>.Shared.Return(buffer);
+                        buffer = larger;
+                    }
+
+                    int read = RandomAccess.Read(_handle, buffer.AsSpan(end), bufferOffset + end);
+                    if (read == 0)
+                    {
+                        eof = true;
+                    }
+
+                    end += read;
+                }
+
+                int terminator = IndexOfTerminator(buffer, pos, end);
+                if (terminator < 0)
+                {
+                    if (!eof)
+                    {
+                        // Resume at the first unscanned (unit-aligned) position once more data is read.
+                        pos = end - (end - lineStart) % _unit;
+                        needMore = true;
+                        continue;
+                    }
+
+                    if (end > lineStart)
+                    {
+                        // Last line, not terminated.
+                        if (line >= firstLine)
+                        {
+                            yield return Encoding.GetString(buffer, lineStart, end - lineStart);
+                        }
+
+                        line++;
+                    }
+
+                    lock (_lock)
+                    {
+                        _lineCount = line;
+                    }
+
+                    yield break;
+                }
+
+                int terminatorLength = _unit;
+                if (Matches(buffer, terminator, _cr))
+                {
+                    if (terminator + 2 * _unit > end && !eof)
+                    {
+                        // A CR at the end of the buffer; read on to see whether it's a CRLF.
+                        pos = terminator;
+                        needMore = true;
+                        continue;
+                    }
+
+                    if (terminator + 2 * _unit <= end && Matches(buffer, terminator + _unit, _lf))
+                    {
+                        terminatorLength = 2 * _unit;
+                    }
+                }
+
+                if (line >= firstLine)
+                {
+                    yield return Encoding.GetString(buffer, lineStart, terminator - lineStart);
+                }
+
+                line++;
+                lineStart = pos = terminator + terminatorLength;
+                if (line % CheckpointInterval == 0)
+                {
+                    AddCheckpoint(line, bufferOffset + lineStart);
+                }
+            }
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+    }
+
+    private void AddCheckpoint(int line, long offset)
+    {
+        lock (_lock)
+        {
+            // Checkpoints are only ever appended in order; a later enumeration of an indexed range is a no-op.
+            if (line / CheckpointInterval == _checkpoints.Count)
+            {
+                _checkpoints.Add(offset);
+            }
+        }
+    }
+
+    private int IndexOfTerminator(byte[] buffer, int pos, int end)
+    {
+        if (_unit == 1)
+        {
+            int i = buffer.AsSpan(pos, end - pos).IndexOfAny(_lf[0], _cr[0]);
+            return i < 0 ? -1 : pos + i;
+        }
+
+        // Multi-byte code units (UTF-16/32): compare whole, aligned units only.
+        for (int i = pos; i + _unit <= end; i += _unit)
+        {
+            if (Matches(buffer, i, _lf) || Matches(buffer, i, _cr))
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    private static bool Matches(byte[] buffer, int index, byte[] unit)
+    {
+        return index + unit.Length <= buffer.Length && buffer.AsSpan(index, unit.Length).SequenceEqual(unit);
+    }
+}
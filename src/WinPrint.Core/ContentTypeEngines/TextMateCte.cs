@@ -1,3 +1,4 @@
+using System.Diagnostics;
 using System.Drawing;
 using System.Globalization;
 using System.Runtime.InteropServices;
@@ -17,17 +18,51 @@ namespace WinPrint.Core.ContentTypeEngines;
 /// </summary>
 public class TextMateCte : ContentTypeEngineBase, IDisposable
 {
+    // Minimum time between progressive page publications after the first page.
+    private static readonly TimeSpan s_publishInterval = TimeSpan.FromMilliseconds(100);
     private static readonly string[] s_supportedContentTypes = ["text/plain"];
+    private static readonly Func<TextMateWrappedLine, int, TextMateWrappedLine> s_renumber = Renumber;
+    private static readonly Func<TextMateWrappedLine> s_blank = static () => new TextMateWrappedLine();
 
     private IGraphicsFont? _cachedFont;
+
+    // The last reflow's token cache key, or null when the document is streamed.
+    private string? _cacheKey;
     private bool _disposed;
+
+    // Rule state after the last source line laid out; AppendAsync tokenizes appended lines from it.
+    private IStateStack? _endRuleStack;
     private string? _filePath;
-    private IGrammar? _grammar;
+    private bool _grammarResolved;
     private float _lineHeight;
     private float _lineNumberWidth;
     private int _linesPerPage;
-    private Registry? _registry;
+
+    // True once a reflow has laid out the whole document; AppendAsync extends only a complete layout.
+    private bool _layoutComplete;
+
+    // Logical lines the gutter was sized for, the line number counter after the last source line, the
+    // number of source lines and the characters per wrapped line of the current layout.
+    private int _logicalLineCount;
+    private int _lineNumber;
+    private int _sourceLineCount;
+    private int _maxLineChars;
+
+    // Guards the layout shared by the reflow thread and PaintPage.
+    private readonly Lock _pagesLock = new();
+
+    // When streaming from a DocumentSource only page anchors are kept; pages are re-tokenized on demand.
+    private List<TextMatePageAnchor>? _pageAnchors;
+
+    // Paint resources not in use by a PaintPage call, all of generation _paintGeneration; guarded by
+    // _paintLock. The generation changes with _paintKey, the kind of context and font they were made for.
+    private readonly List<TextMatePaintResources> _idlePaintResources = [];
+    private readonly Lock _paintLock = new();
+    private int _paintGeneration;
+    private (Type Context, float DpiX, float DpiY, bool IsDisplayUnit, string Family, float Size)? _paintKey;
+    private ThemeName _registryTheme;
     private string? _resolvedScopeName;
+    private int _tokenizedLineCount;
     private List<TextMateWrappedLine>? _wrappedLines;
 
     public string? ContentType { get; private set; }
@@ -35,17 +70,74 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
 
     public override string[] SupportedContentTypes => s_supportedContentTypes;
 
+    public override bool SupportsDocumentSource => true;
+
+    /// <summary>
+    ///     Source lines run through the grammar by the last reflow (or <see cref="AppendAsync" />); the others
+    ///     were reused from <see cref="TextMateTokenCache" />. For diagnostics and tests.
+    /// </summary>
+    internal int TokenizedLineCount => Volatile.Read(ref _tokenizedLineCount);
+
     public void Dispose()
     {
         Dispose(true);
         GC.SuppressFinalize(this);
     }
 
+    /// <summary>
+    ///     Starts loading, in the background, the grammars for the most common file types among
+    ///     <paramref name="filePaths" /> that this engine renders, so a batch print doesn't pay for loading a
+    ///     grammar on the first file of each type. Each is loaded in the theme of the sheet the file prints with:
+    ///     <paramref name="sheetStyle" /> returns the <see cref="ContentSettings.Style" /> of the sheet for a
+    ///     content type.
+    /// </summary>
+    /// <returns>The scopes of the grammars loaded.</returns>
+    public static Task<List<string>> WarmUpGrammarsAsync(IEnumerable<string> filePaths,
+        Func<string, string?> sheetStyle)
+    {
+        ArgumentNullException.ThrowIfNull(sheetStyle);
+        List<string> paths = [.. filePaths];
+        return Task.Run(async () =>
+        {
+            // Files another engine renders (Markdown, HTML, ANSI...) don't need a grammar.
+            Dictionary<string, ThemeName?> themes = new(StringComparer.OrdinalIgnoreCase);
+            List<(ThemeName Theme, string Path)> files = [];
+            foreach (string path in paths)
+            {
+                string contentType = GetContentType(path);
+                if (!themes.TryGetValue(contentType, out ThemeName? theme))
+                {
+                    (ContentTypeEngineBase? cte, _, _) = CreateContentTypeEngine(contentType);
+                    theme = cte is TextMateCte ? ParseTheme(sheetStyle(contentType)) : null;
+                    (cte as IDisposable)?.Dispose();
+                    themes[contentType] = theme;
+                }
+
+                if (theme is { } t)
+                {
+                    files.Add((t, path));
+                }
+            }
+
+            List<string> scopes = [];
+            foreach (IGrouping<ThemeName, (ThemeName Theme, string Path)> group in files.GroupBy(f => f.Theme))
+            {
+                scopes.AddRange(await TextMateRegistryCache.WarmUpAsync(group.Key, group.Select(f => f.Path))
+                    .ConfigureAwait(false));
+            }
+
+            return scopes;
+        });
+    }
+
     public void Configure(string? contentType, string? language, string? filePath)
     {
         ContentType = contentType;
         Language = language;
         _filePath = filePath;
+
+        // The grammar is resolved from these on the next reflow.
+        _grammarResolved = false;
     }
 
     private void Dispose(bool disposing)
@@ -61,6 +153,13 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
         {
             _cachedFont?.Dispose();
             _wrappedLines = null;
+            _pageAnchors = null;
+            lock (_paintLock)
+            {
+                // Resources still in use are disposed when they're returned.
+                _disposed = true;
+                DisposeIdlePaintResources();
+            }
         }
 
         _disposed = true;
@@ -73,11 +172,11 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
     }
 
     public override async Task<int> RenderAsync(PrintResolution? printerResolution,
-        EventHandler<string>? reflowProgress)
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken = default)
     {
         LogService.TraceMessage();
 
-        if (Document is null)
+        if (Document is null && DocumentSource is null)
         {
             throw new InvalidOperationException("Document can't be null for RenderAsync");
         }
@@ -103,36 +202,72 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
         {
             g.SetTextRenderingMode(GraphicsTextRenderingMode);
 
-            _cachedFont?.Dispose();
-            _cachedFont = g.CreateFont(ContentSettings!.Font.Family, ContentSettings.Font.Size / 72F * 96F,
-                (GraphicsFontStyle)ContentSettings.Font.Style, GraphicsFontUnit.Pixel);
+            // Nothing is paintable until the first page of this reflow has been laid out.
+            PublishPages(0, reflowProgress);
+
+            int logicalLineCount = DocumentSource is null
+                ? CountLogicalLines(Document!, ContentSettings!.NewPageOnFormFeed)
+                : DocumentSource.CountLines();
 
-            _lineHeight = _cachedFont.GetHeight(dpiY);
-            if (PageSize.Height < _lineHeight)
+            int maxLineChars;
+            lock (_pagesLock)
             {
-                throw new InvalidOperationException(
-                    $"The line height ({_lineHeight:F2}) is greater than page height ({PageSize.Height:F2}). " +
-                    $"PageSize={PageSize.Width:F2}x{PageSize.Height:F2}, Font={ContentSettings.Font.Family} {ContentSettings.Font.Size}pt, DPI={dpiY}");
-            }
+                _layoutComplete = false;
+                _cachedFont?.Dispose();
+                _cachedFont = g.CreateFont(ContentSettings.Font.Family, ContentSettings.Font.Size / 72F * 96F,
+                    (GraphicsFontStyle)ContentSettings.Font.Style, GraphicsFontUnit.Pixel);
+
+                _lineHeight = _cachedFont.GetHeight(dpiY);
+                if (PageSize.Height < _lineHeight)
+                {
+                    throw new InvalidOperationException(
+                        $"The line height ({_lineHeight:F2}) is greater than page height ({PageSize.Height:F2}). " +
+                        $"PageSize={PageSize.Width:F2}x{PageSize.Height:F2}, Font={ContentSettings.Font.Family} {ContentSettings.Font.Size}pt, DPI={dpiY}");
+                }
+
+                _linesPerPage = (int)Math.Floor(PageSize.Height / _lineHeight);
+                _lineNumberWidth = ContentSettings.LineNumbers
+                    ? MeasureRun(g, new string('0', GetLineNumberDigits(logicalLineCount) + 1), _cachedFont).Width
+                    : 0;
 
-            _linesPerPage = (int)Math.Floor(PageSize.Height / _lineHeight);
-            int logicalLineCount = CountLogicalLines(Document, ContentSettings.NewPageOnFormFeed);
-            int lineNumberDigits = Math.Max(3, logicalLineCount.ToString(CultureInfo.InvariantCulture).Length);
-            _lineNumberWidth = ContentSettings.LineNumbers
-                ? MeasureRun(g, new string('0', lineNumberDigits + 1), _cachedFont).Width
-                : 0;
+                float charWidth = Math.Max(1, MeasureRun(g, "W", _cachedFont).Width);
+                maxLineChars = Math.Max(1, (int)Math.Floor((PageSize.Width - _lineNumberWidth) / charWidth));
+                _logicalLineCount = logicalLineCount;
+                _maxLineChars = maxLineChars;
 
-            float charWidth = Math.Max(1, MeasureRun(g, "W", _cachedFont).Width);
-            int maxLineChars = Math.Max(1, (int)Math.Floor((PageSize.Width - _lineNumberWidth) / charWidth));
+                // When streaming from a DocumentSource only page anchors are kept (memory bounded by the
+                // page count); otherwise every wrapped line is.
+                _wrappedLines = DocumentSource is null ? [] : null;
+                _pageAnchors = DocumentSource is null ? null : [];
+            }
 
             InitializeGrammar();
-            _wrappedLines = TokenizeAndWrap(Document, maxLineChars);
 
-            int pages = (int)Math.Ceiling(_wrappedLines.Count / (double)_linesPerPage);
+            // Streamed documents are too large to keep the tokens of every line in memory.
+            string? cacheKey = DocumentSource is null
+                ? TextMateTokenCache.CreateKey(_filePath, _resolvedScopeName, _registryTheme.ToString(),
+                    ContentSettings.TabSpaces, ContentSettings.NewPageOnFormFeed)
+                : null;
+            _cacheKey = cacheKey;
+
+            // Tokenize off the caller's thread so pages published along the way can be painted meanwhile.
+            int lineCount = await Task.Run(() =>
+                    TokenizeAndWrapAsync(ReadDocumentLines(), maxLineChars, cacheKey, reflowProgress,
+                        cancellationToken), cancellationToken)
+                .ConfigureAwait(false);
+
+            int pages = (int)Math.Ceiling(lineCount / (double)_linesPerPage);
+            lock (_pagesLock)
+            {
+                _layoutComplete = true;
+            }
+
+            PublishPages(pages, reflowProgress);
             Log.Debug(
                 "Rendered {pages} TextMate pages of {linesperpage} lines per page, for a total of {lines} lines.",
-                pages, _linesPerPage, _wrappedLines.Count);
-            return await Task.FromResult(pages);
+                pages, _linesPerPage, lineCount);
+            Log.Debug("TextMate: tokenized {tokenized} source lines; the rest were cached.", TokenizedLineCount);
+            return pages;
         }
         finally
         {
@@ -143,7 +278,7 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
     public override void PaintPage(IGraphicsContext graphicsContext, int pageNum)
     {
         LogService.TraceMessage($"{pageNum}");
-        if (_wrappedLines is null || _cachedFont is null)
+        if ((_wrappedLines is null && _pageAnchors is null) || _cachedFont is null)
         {
             Log.Debug("TextMateCte must be rendered before painting.");
             return;
@@ -151,20 +286,84 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
 
         graphicsContext.SetTextRenderingMode(GraphicsTextRenderingMode);
 
-        // Create IGraphicsFont equivalents for cross-platform rendering
-        GraphicsFontUnit unit = graphicsContext.IsDisplayUnit ? GraphicsFontUnit.Point : GraphicsFontUnit.Pixel;
-        float size = graphicsContext.IsDisplayUnit
-            ? ContentSettings!.Font.Size
-            : ContentSettings!.Font.Size / 72F * 96F;
-        using IGraphicsFont baseFont = graphicsContext.CreateFont(ContentSettings.Font.Family, size,
-            (GraphicsFontStyle)ContentSettings.Font.Style, unit);
+        // Copy the page's lines out under the lock; a reflow may still be appending later pages.
+        List<TextMateWrappedLine> pageLines;
+        lock (_pagesLock)
+        {
+            pageLines = GetPageLinesLocked(pageNum);
+        }
 
-        int firstLineOnPage = _linesPerPage * (pageNum - 1);
-        int i;
-        for (i = firstLineOnPage; i < firstLineOnPage + _linesPerPage && i < _wrappedLines.Count; i++)
+        TextMatePaintResources resources = RentPaintResources(graphicsContext);
+        try
         {
-            TextMateWrappedLine line = _wrappedLines[i];
-            float yPos = (i - firstLineOnPage) * _lineHeight;
+            PaintLines(graphicsContext, pageLines, resources);
+        }
+        finally
+        {
+            ReturnPaintResources(resources);
+        }
+
+        Log.Debug("Painted {lineOnPage} TextMate lines.", pageLines.Count - 1);
+    }
+
+    /// <summary>
+    ///     Returns the wrapped lines on <paramref name="pageNum" />; when streaming, the page is tokenized and
+    ///     wrapped again from its anchor in the source.
+    /// </summary>
+    private List<TextMateWrappedLine> GetPageLinesLocked(int pageNum)
+    {
+        if (_pageAnchors is null)
+        {
+            int first = _linesPerPage * (pageNum - 1);
+            return first < 0 || first >= _wrappedLines!.Count
+                ? []
+                : _wrappedLines.GetRange(first, Math.Min(_linesPerPage, _wrappedLines.Count - first));
+        }
+
+        if (pageNum < 1 || pageNum > _pageAnchors.Count)
+        {
+            return [];
+        }
+
+        TextMatePageAnchor anchor = _pageAnchors[pageNum - 1];
+        int baseCount = ((-anchor.SkipWrappedLines % _linesPerPage) + _linesPerPage) % _linesPerPage;
+        var lines = new List<TextMateWrappedLine>();
+        var chunk = new WrapChunk<TextMateWrappedLine>(anchor.SourceLine, []);
+        IStateStack? ruleStack = anchor.RuleStack;
+        (Registry? Registry, IGrammar? Grammar) tokenizer = TextMateRegistryCache.Rent(_registryTheme,
+            _resolvedScopeName);
+        try
+        {
+            foreach (string source in DocumentSource!.ReadLines(anchor.SourceLine))
+            {
+                TextMateTokenizedLine line = TokenizeSourceLineCore(source, tokenizer, ruleStack);
+                ruleStack = line.RuleStack;
+                WrapTokenizedLine(chunk, line, _maxLineChars);
+                chunk.Stitch(chunk.Count - 1, anchor.LineCount, lines, baseCount, _linesPerPage, s_renumber,
+                    s_blank);
+                if (lines.Count >= anchor.SkipWrappedLines + _linesPerPage)
+                {
+                    break;
+                }
+            }
+        }
+        finally
+        {
+            TextMateRegistryCache.Return(_registryTheme, _resolvedScopeName, tokenizer);
+        }
+
+        int count = Math.Clamp(lines.Count - anchor.SkipWrappedLines, 0, _linesPerPage);
+        return lines.GetRange(Math.Min(anchor.SkipWrappedLines, lines.Count), count);
+    }
+
+    private void PaintLines(IGraphicsContext graphicsContext, List<TextMateWrappedLine> pageLines,
+        TextMatePaintResources resources)
+    {
+        IGraphicsFont baseFont = resources.GetFont(graphicsContext, (GraphicsFontStyle)ContentSettings!.Font.Style);
+        for (int i = 0; i < pageLines.Count; i++)
+        {
+            TextMateWrappedLine line = pageLines[i];
+            float yPos = i * _lineHeight;
 
             if (ContentSettings.LineNumbers && _lineNumberWidth != 0)
             {
@@ -201,26 +400,81 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
                 }
 
                 string text = line.Text.Substring(run.Start, Math.Min(run.Length, line.Text.Length - run.Start));
-                GraphicsFontStyle fontStyle = GetGraphicsFontStyle(run.FontStyle);
-                using IGraphicsFont runFont = graphicsContext.CreateFont(ContentSettings.Font.Family, size,
-                    fontStyle, unit);
-                using IGraphicsBrush brush = graphicsContext.CreateSolidBrush(
-                    GraphicsColor.FromArgb(run.Foreground.A, run.Foreground.R, run.Foreground.G, run.Foreground.B));
-                graphicsContext.DrawString(text, runFont, brush, xPos, yPos, GraphicsStringFormat);
-                GraphicsSizeF measuredSize = MeasureRun(graphicsContext, text, runFont);
+                IGraphicsFont runFont = resources.GetFont(graphicsContext, GetGraphicsFontStyle(run.FontStyle));
+                graphicsContext.DrawString(text, runFont, resources.GetBrush(graphicsContext, run.Foreground), xPos,
+                    yPos, GraphicsStringFormat);
+
+                // Each run is measured once per kind of context, however often its page is painted.
+                if (!run.TryGetWidth(resources.Generation, out float width))
+                {
+                    width = MeasureRun(graphicsContext, text, runFont).Width;
+                    run.SetWidth(resources.Generation, width);
+                }
 
                 if (ContentSettings.Diagnostics)
                 {
                     using IGraphicsPen orangePen = graphicsContext.CreatePen(
                         GraphicsColor.FromRgb(255, 165, 0));
-                    graphicsContext.DrawRectangle(orangePen, xPos, yPos, measuredSize.Width, measuredSize.Height);
+                    graphicsContext.DrawRectangle(orangePen, xPos, yPos, width, _lineHeight);
                 }
 
-                xPos += measuredSize.Width;
+                xPos += width;
             }
         }
+    }
 
-        Log.Debug("Painted {lineOnPage} TextMate lines.", i - 1);
+    /// <summary>
+    ///     Takes idle paint resources made for contexts like <paramref name="g" />, or creates new ones. When
+    ///     <paramref name="g" /> differs from the contexts painted so far (e.g. printing after previewing), or
+    ///     the content font changed, the idle resources are dropped and run widths are measured again.
+    /// </summary>
+    private TextMatePaintResources RentPaintResources(IGraphicsContext g)
+    {
+        GraphicsFontUnit unit = g.IsDisplayUnit ? GraphicsFontUnit.Point : GraphicsFontUnit.Pixel;
+        float size = g.IsDisplayUnit ? ContentSettings!.Font.Size : ContentSettings!.Font.Size / 72F * 96F;
+        var key = (g.GetType(), g.DpiX, g.DpiY, g.IsDisplayUnit, ContentSettings.Font.Family, size);
+        lock (_paintLock)
+        {
+            if (_paintKey != key)
+            {
+                _paintKey = key;
+                _paintGeneration++;
+                DisposeIdlePaintResources();
+            }
+
+            if (_idlePaintResources.Count > 0)
+            {
+                TextMatePaintResources idle = _idlePaintResources[^1];
+                _idlePaintResources.RemoveAt(_idlePaintResources.Count - 1);
+                return idle;
+            }
+
+            return new TextMatePaintResources(ContentSettings.Font.Family, size, unit, _paintGeneration);
+        }
+    }
+
+    private void ReturnPaintResources(TextMatePaintResources resources)
+    {
+        lock (_paintLock)
+        {
+            if (!_disposed && resources.Generation == _paintGeneration)
+            {
+                _idlePaintResources.Add(resources);
+                return;
+            }
+        }
+
+        resources.Dispose();
+    }
+
+    private void DisposeIdlePaintResources()
+    {
+        foreach (TextMatePaintResources resources in _idlePaintResources)
+        {
+            resources.Dispose();
+        }
+
+        _idlePaintResources.Clear();
     }
 
     /// <summary>
@@ -255,21 +509,29 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
     private void InitializeGrammar()
     {
         ThemeName theme = ParseTheme(ContentSettings?.Style);
-        var options = new RegistryOptions(theme);
-        _registry = new Registry(new WinPrintRegistryOptions(options));
-        _resolvedScopeName = ResolveScopeName(options);
+        if (_grammarResolved && _registryTheme == theme)
+        {
+            // Same grammar and theme as the last reflow.
+            return;
+        }
+
+        _registryTheme = theme;
+        _resolvedScopeName = ResolveScopeName(TextMateRegistryCache.GetOptions(theme).Bundled);
         try
         {
-            _grammar = string.IsNullOrEmpty(_resolvedScopeName) ? null : _registry.LoadGrammar(_resolvedScopeName);
+            // Loads (or reuses) a compiled grammar now, so a broken one is caught here rather than by a worker.
+            TextMateRegistryCache.Return(theme, _resolvedScopeName,
+                TextMateRegistryCache.Rent(theme, _resolvedScopeName));
         }
         catch (Exception ex)
         {
             // A missing/broken grammar must not abort printing — fall back to plain (unhighlighted) text.
             Log.Warning(ex, "TextMate: failed to load grammar {scope}; rendering as plain text.", _resolvedScopeName);
-            _grammar = null;
             _resolvedScopeName = null;
         }
 
+        _grammarResolved = true;
+
         Log.Debug("TextMate grammar: {scope}", _resolvedScopeName ?? "(plain text)");
     }
 
@@ -329,66 +591,357 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
             : new string([.. value.Where(char.IsLetterOrDigit).Select(char.ToLowerInvariant)]);
     }
 
-    private List<TextMateWrappedLine> TokenizeAndWrap(string document, int maxLineChars)
+    /// <summary>
+    ///     Tokenizes and wraps <paramref name="lines" /> into <see cref="_wrappedLines" /> (or, when streaming,
+    ///     records a <see cref="TextMatePageAnchor" /> per page in <see cref="_pageAnchors" />), publishing pages
+    ///     as they fill (see <see cref="ContentTypeEngineBase.PublishPages" />): the first as soon as it is
+    ///     complete, then at most every <see cref="s_publishInterval" />.
+    ///     Chunks of the document are tokenized concurrently (see
+    ///     <see cref="ContentTypeEngineBase.WrapChunksAsync{TChunk}" />), each worker with its own grammar
+    ///     instance (see <see cref="TextMateRegistryCache" />) since grammars compile rules lazily and aren't
+    ///     thread-safe. A chunk's starting rule state
+    ///     isn't known until the chunks before it are done, so chunks are tokenized speculatively from the
+    ///     state the cached tokenization had there (or the initial state) and reconciled as they are stitched
+    ///     (see <see cref="ReconcileChunk" />). Every instance of a grammar numbers its rules the same way, so
+    ///     rule states can be passed between them.
+    /// </summary>
+    /// <param name="lines">The document's lines.</param>
+    /// <param name="maxLineChars">Characters per wrapped line.</param>
+    /// <param name="cacheKey">The document's <see cref="TextMateTokenCache" /> key, or null to not cache.</param>
+    /// <param name="reflowProgress">Raised as pages are published.</param>
+    /// <param name="cancellationToken">Abandons tokenizing; nothing is cached for an abandoned pass.</param>
+    /// <returns>The total number of wrapped lines.</returns>
+    private async Task<int> TokenizeAndWrapAsync(IEnumerable<string> lines, int maxLineChars, string? cacheKey,
+        EventHandler<string>? reflowProgress, CancellationToken cancellationToken)
     {
-        var wrapped = new List<TextMateWrappedLine>();
+        List<TextMateWrappedLine>? wrapped = _wrappedLines;
+        var scratch = new List<TextMateWrappedLine>();
+        int total = 0;
+        ThemeName theme = _registryTheme;
+        string? scope = _resolvedScopeName;
+        IReadOnlyList<TextMateTokenizedLine>? cached = cacheKey is null ? null : TextMateTokenCache.Get(cacheKey);
+        List<TextMateTokenizedLine>? tokenizedLines = cacheKey is null ? null : [];
         IStateStack? ruleStack = null;
         int lineNumber = 0;
+        int sourceLineCount = 0;
+        int published = 0;
+        long lastPublished = Stopwatch.GetTimestamp();
+        Volatile.Write(ref _tokenizedLineCount, 0);
 
-        using var reader = new StringReader(document);
-        string? line;
-        while ((line = reader.ReadLine()) != null)
+        await WrapChunksAsync(lines, (firstLine, chunkLines) =>
+        {
+            (Registry? Registry, IGrammar? Grammar) tokenizer = TextMateRegistryCache.Rent(theme, scope);
+            try
+            {
+                var chunk = new WrapChunk<TextMateWrappedLine>(firstLine, chunkLines);
+                var tokenized = new List<TextMateTokenizedLine>(chunkLines.Count);
+                IStateStack? startState = firstLine > 0 && firstLine <= cached?.Count
+                    ? cached[firstLine - 1].RuleStack
+                    : null;
+                IStateStack? chunkRuleStack = startState;
+                for (int i = 0; i < chunkLines.Count; i++)
+                {
+                    TextMateTokenizedLine line =
+                        FindCachedLine(cached, firstLine + i, chunkLines[i], chunkRuleStack) ??
+                        TokenizeSourceLine(chunkLines[i], tokenizer, chunkRuleStack);
+                    chunkRuleStack = line.RuleStack;
+                    tokenized.Add(line);
+                    WrapTokenizedLine(chunk, line, maxLineChars);
+                }
+
+                return (Chunk: chunk, Tokenized: tokenized, StartState: startState);
+            }
+            finally
+            {
+                TextMateRegistryCache.Return(theme, scope, tokenizer);
+            }
+        }, result =>
         {
-            if (ContentSettings!.TabSpaces > 0)
+            if (!Equals(ruleStack, result.StartState))
             {
-                line = line.Replace("\t", new string(' ', ContentSettings.TabSpaces));
+                (Registry? Registry, IGrammar? Grammar) tokenizer = TextMateRegistryCache.Rent(theme, scope);
+                try
+                {
+                    ReconcileChunk(result.Chunk, result.Tokenized, cached, ruleStack, maxLineChars, tokenizer);
+                }
+                finally
+                {
+                    TextMateRegistryCache.Return(theme, scope, tokenizer);
+                }
             }
 
-            lineNumber++;
-            if (ContentSettings.NewPageOnFormFeed && line.Contains('\f'))
+            IStateStack? chunkStart = ruleStack;
+            ruleStack = result.Tokenized[^1].RuleStack;
+            sourceLineCount += result.Tokenized.Count;
+            tokenizedLines?.AddRange(result.Tokenized);
+
+            lock (_pagesLock)
             {
-                string[] parts = line.Split('\f');
-                for (int i = 0; i < parts.Length; i++)
+                WrapChunk<TextMateWrappedLine> chunk = result.Chunk;
+                for (int i = 0; i < chunk.Count; i++)
                 {
-                    if (i > 0)
+                    if (_pageAnchors is null)
                     {
-                        AddBlankLinesToNextPage(wrapped);
+                        chunk.Stitch(i, lineNumber, wrapped!, 0, _linesPerPage, s_renumber, s_blank);
+                        continue;
                     }
 
-                    AddTokenizedLine(wrapped, parts[i], lineNumber, maxLineChars, ref ruleStack);
-                    if (i < parts.Length - 1)
+                    scratch.Clear();
+                    chunk.Stitch(i, lineNumber, scratch, total, _linesPerPage, s_renumber, s_blank);
+
+                    // First wrapped line of the next page is the (_pageAnchors.Count * _linesPerPage)th overall
+                    while ((long)_pageAnchors.Count * _linesPerPage < total + scratch.Count)
                     {
-                        lineNumber++;
+                        _pageAnchors.Add(new TextMatePageAnchor(chunk.FirstSourceLine + i,
+                            _pageAnchors.Count * _linesPerPage - total, lineNumber + chunk.LineNumberBefore(i),
+                            i == 0 ? chunkStart : result.Tokenized[i - 1].RuleStack));
                     }
+
+                    total += scratch.Count;
+                }
+
+                if (_pageAnchors is null)
+                {
+                    total = wrapped!.Count;
                 }
             }
-            else
+
+            lineNumber += result.Chunk.LineNumber;
+
+            int complete = total / _linesPerPage;
+            if (complete > published &&
+                (published == 0 || Stopwatch.GetElapsedTime(lastPublished) >= s_publishInterval))
             {
-                AddTokenizedLine(wrapped, line, lineNumber, maxLineChars, ref ruleStack);
+                published = complete;
+                lastPublished = Stopwatch.GetTimestamp();
+                PublishPages(published, reflowProgress);
             }
+        }, cancellationToken).ConfigureAwait(false);
+
+        if (cacheKey is not null)
+        {
+            TextMateTokenCache.Set(cacheKey, tokenizedLines!);
         }
 
-        if (wrapped.Count == 0)
+        lock (_pagesLock)
         {
-            wrapped.Add(new TextMateWrappedLine { NonWrappedLineNumber = 1 });
+            if (total == 0)
+            {
+                // An empty document still has one (blank) page.
+                wrapped?.Add(new TextMateWrappedLine { NonWrappedLineNumber = 1 });
+                total = 1;
+            }
+
+            _endRuleStack = ruleStack;
+            _lineNumber = lineNumber;
+            _sourceLineCount = sourceLineCount;
         }
 
-        return wrapped;
+        return total;
     }
 
-    private void AddBlankLinesToNextPage(List<TextMateWrappedLine> wrapped)
+    /// <summary>
+    ///     Tokenizes the appended lines from the rule state the document ended in, wraps them, and stitches
+    ///     them onto the end of the wrapped lines, so pages already laid out stay as they are (the last one
+    ///     may fill up). The cached tokens of the document are extended too. Not supported when streaming, or
+    ///     when line numbers are on and the appended lines need a wider gutter, which changes every page.
+    /// </summary>
+    public override async Task<int> AppendAsync(string text, EventHandler<string>? reflowProgress,
+        CancellationToken cancellationToken = default)
     {
-        while (_linesPerPage > 0 && wrapped.Count % _linesPerPage != 0)
+        ArgumentNullException.ThrowIfNull(text);
+
+        List<TextMateWrappedLine>? wrapped;
+        lock (_pagesLock)
+        {
+            wrapped = _wrappedLines;
+            if (!_layoutComplete || wrapped is null || Document is not { Length: > 0 } document ||
+                document[^1] != '\n')
+            {
+                return -1;
+            }
+        }
+
+        int logicalLineCount = _logicalLineCount + CountLogicalLines(text, ContentSettings!.NewPageOnFormFeed) - 1;
+        if (ContentSettings.LineNumbers &&
+            GetLineNumberDigits(logicalLineCount) != GetLineNumberDigits(_logicalLineCount))
         {
-            wrapped.Add(new TextMateWrappedLine());
+            return -1;
         }
+
+        ThemeName theme = _registryTheme;
+        string? scope = _resolvedScopeName;
+        List<string> lines = [.. ReadStringLines(text, 0)];
+        var chunk = new WrapChunk<TextMateWrappedLine>(_sourceLineCount, lines);
+        var tokenized = new List<TextMateTokenizedLine>(lines.Count);
+        IStateStack? ruleStack = _endRuleStack;
+        Volatile.Write(ref _tokenizedLineCount, 0);
+        await Task.Run(() =>
+        {
+            (Registry? Registry, IGrammar? Grammar) tokenizer = TextMateRegistryCache.Rent(theme, scope);
+            try
+            {
+                foreach (string source in lines)
+                {
+                    TextMateTokenizedLine line = TokenizeSourceLine(source, tokenizer, ruleStack);
+                    ruleStack = line.RuleStack;
+                    tokenized.Add(line);
+                    WrapTokenizedLine(chunk, line, _maxLineChars);
+                }
+            }
+            finally
+            {
+                TextMateRegistryCache.Return(theme, scope, tokenizer);
+            }
+        }, cancellationToken).ConfigureAwait(false);
+        cancellationToken.ThrowIfCancellationRequested();
+
+        int pages;
+        lock (_pagesLock)
+        {
+            for (int i = 0; i < chunk.Count; i++)
+            {
+                chunk.Stitch(i, _lineNumber, wrapped, 0, _linesPerPage, s_renumber, s_blank);
+            }
+
+            _lineNumber += chunk.LineNumber;
+            _logicalLineCount = logicalLineCount;
+            _endRuleStack = ruleStack;
+            AppendToDocument(text);
+            pages = (int)Math.Ceiling(wrapped.Count / (double)_linesPerPage);
+        }
+
+        // Only extend cached tokens that are still this document's; another engine may have replaced them.
+        if (_cacheKey is not null && TextMateTokenCache.Get(_cacheKey) is { } cached &&
+            cached.Count == _sourceLineCount)
+        {
+            TextMateTokenCache.Set(_cacheKey, [.. cached, .. tokenized]);
+        }
+
+        _sourceLineCount += lines.Count;
+        PublishPages(pages, reflowProgress);
+        Log.Debug("TextMate: appended {lines} lines; {pages} pages.", lines.Count, pages);
+        return pages;
     }
 
-    private void AddTokenizedLine(List<TextMateWrappedLine> wrapped, string line, int lineNumber, int maxLineChars,
-        ref IStateStack? ruleStack)
+    /// <summary>
+    ///     Corrects a speculatively tokenized chunk given <paramref name="ruleStack" />, the rule state the
+    ///     previous chunk actually ended in. Lines are re-tokenized from that state until the state after a
+    ///     line equals the speculative one; tokens from there on are already right. Wrapping doesn't depend
+    ///     on tokens, so the re-tokenized lines replace the speculative ones one for one. Source that stays in
+    ///     a nested rule (e.g. a block comment or a block-scoped namespace) may never converge, in which case
+    ///     the whole chunk is tokenized again.
+    /// </summary>
+    private void ReconcileChunk(WrapChunk<TextMateWrappedLine> chunk, List<TextMateTokenizedLine> tokenized,
+        IReadOnlyList<TextMateTokenizedLine>? cached, IStateStack? ruleStack, int maxLineChars,
+        (Registry? Registry, IGrammar? Grammar) tokenizer)
+    {
+        var redo = new WrapChunk<TextMateWrappedLine>(chunk.FirstSourceLine, chunk.SourceLines);
+        for (int i = 0; i < chunk.Count; i++)
+        {
+            string source = chunk.SourceLines[i];
+            TextMateTokenizedLine line = FindCachedLine(cached, chunk.FirstSourceLine + i, source, ruleStack) ??
+                                         TokenizeSourceLine(source, tokenizer, ruleStack);
+            bool converged = Equals(line.RuleStack, tokenized[i].RuleStack);
+            tokenized[i] = line;
+            ruleStack = line.RuleStack;
+            WrapTokenizedLine(redo, line, maxLineChars);
+            if (converged)
+            {
+                break;
+            }
+        }
+
+        for (int i = 0; i < redo.Lines.Count; i++)
+        {
+            chunk.Lines[i] = redo.Lines[i];
+        }
+
+        Log.Debug("TextMate: re-tokenized {lines} of {count} lines from line {first} to reconcile rule state.",
+            redo.Count, chunk.Count, chunk.FirstSourceLine);
+    }
+
+    /// <summary>
+    ///     Returns the cached tokens of line <paramref name="index" /> if its text is unchanged and tokenizing
+    ///     it would start from the same rule state, otherwise null.
+    /// </summary>
+    private static TextMateTokenizedLine? FindCachedLine(IReadOnlyList<TextMateTokenizedLine>? cached, int index,
+        string source, IStateStack? ruleStack)
+    {
+        if (cached is null || index >= cached.Count || cached[index].Source != source)
+        {
+            return null;
+        }
+
+        IStateStack? cachedRuleStack = index == 0 ? null : cached[index - 1].RuleStack;
+        return Equals(ruleStack, cachedRuleStack) ? cached[index] : null;
+    }
+
+    /// <summary>
+    ///     Expands tabs, splits the line at form feeds, and tokenizes the parts starting from
+    ///     <paramref name="ruleStack" />.
+    /// </summary>
+    private TextMateTokenizedLine TokenizeSourceLine(string sourceLine,
+        (Registry? Registry, IGrammar? Grammar) tokenizer, IStateStack? ruleStack)
+    {
+        Interlocked.Increment(ref _tokenizedLineCount);
+        return TokenizeSourceLineCore(sourceLine, tokenizer, ruleStack);
+    }
+
+    // TokenizeSourceLine without counting the line in TokenizedLineCount, for re-tokenizing streamed pages.
+    private TextMateTokenizedLine TokenizeSourceLineCore(string sourceLine,
+        (Registry? Registry, IGrammar? Grammar) tokenizer, IStateStack? ruleStack)
+    {
+        string line = sourceLine;
+        if (ContentSettings!.TabSpaces > 0)
+        {
+            line = line.Replace("\t", new string(' ', ContentSettings.TabSpaces));
+        }
+
+        string[] parts = ContentSettings.NewPageOnFormFeed && line.Contains('\f') ? line.Split('\f') : [line];
+        var tokens = new List<(int Start, int End, Color Foreground, TextMateFontStyle FontStyle)>[parts.Length];
+        for (int i = 0; i < parts.Length; i++)
+        {
+            tokens[i] = TokenizeLine(tokenizer, parts[i], ref ruleStack);
+        }
+
+        return new TextMateTokenizedLine { Source = sourceLine, Parts = parts, Tokens = tokens, RuleStack = ruleStack };
+    }
+
+    private static void WrapTokenizedLine(WrapChunk<TextMateWrappedLine> chunk, TextMateTokenizedLine line,
+        int maxLineChars)
+    {
+        chunk.LineNumber++;
+        for (int i = 0; i < line.Parts.Length; i++)
+        {
+            if (i > 0)
+            {
+                chunk.AddPageBreak();
+            }
+
+            AddTokenizedLine(chunk.Lines, line.Parts[i], chunk.LineNumber, maxLineChars, line.Tokens[i]);
+            if (i < line.Parts.Length - 1)
+            {
+                chunk.LineNumber++;
+            }
+        }
+
+        chunk.EndSourceLine();
+    }
+
+    private static TextMateWrappedLine Renumber(TextMateWrappedLine line, int lineNumberOffset)
+    {
+        if (line.NonWrappedLineNumber > 0)
+        {
+            line.NonWrappedLineNumber += lineNumberOffset;
+        }
+
+        return line;
+    }
+
+    private static void AddTokenizedLine(List<TextMateWrappedLine> wrapped, string line, int lineNumber,
+        int maxLineChars, List<(int Start, int End, Color Foreground, TextMateFontStyle FontStyle)> tokens)
     {
-        List<(int Start, int End, Color Foreground, TextMateFontStyle FontStyle)> tokens =
-            TokenizeLine(line, ref ruleStack);
         if (line.Length == 0)
         {
             wrapped.Add(new TextMateWrappedLine { NonWrappedLineNumber = lineNumber });
@@ -431,20 +984,20 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
         }
     }
 
-    private List<(int Start, int End, Color Foreground, TextMateFontStyle FontStyle)> TokenizeLine(string line,
-        ref IStateStack? ruleStack)
+    private static List<(int Start, int End, Color Foreground, TextMateFontStyle FontStyle)> TokenizeLine(
+        (Registry? Registry, IGrammar? Grammar) tokenizer, string line, ref IStateStack? ruleStack)
     {
-        if (_grammar is null || _registry is null)
+        if (tokenizer.Grammar is null || tokenizer.Registry is null)
         {
             ruleStack = null;
             return [(0, line.Length, Color.Black, TextMateFontStyle.None)];
         }
 
         ITokenizeLineResult2? result =
-            _grammar.TokenizeLine2(new LineText(line), ruleStack, TimeSpan.FromSeconds(1));
+            tokenizer.Grammar.TokenizeLine2(new LineText(line), ruleStack, TimeSpan.FromSeconds(1));
         ruleStack = result.RuleStack;
         int[]? encodedTokens = result.Tokens;
-        string[] colorMap = [.. _registry.GetColorMap()];
+        string[] colorMap = [.. tokenizer.Registry.GetColorMap()];
         var tokens = new List<(int Start, int End, Color Foreground, TextMateFontStyle FontStyle)>();
 
         for (int i = 0; i < encodedTokens.Length; i += 2)
@@ -482,6 +1035,11 @@ public class TextMateCte : ContentTypeEngineBase, IDisposable
         return Enum.TryParse(style, true, out ThemeName theme) ? theme : ThemeName.VisualStudioLight;
     }
 
+    private static int GetLineNumberDigits(int logicalLineCount)
+    {
+        return Math.Max(3, logicalLineCount.ToString(CultureInfo.InvariantCulture).Length);
+    }
+
     private static int CountLogicalLines(string document, bool countFormFeeds)
     {
         if (document.Length == 0)
@@ -0,0 +1,22 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using TextMateSharp.Grammars;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Where a page starts when <see cref="TextMateCte" /> streams from a <see cref="TextFileLineSource" />:
+///     the page is regenerated by tokenizing and wrapping source lines from <paramref name="SourceLine" />,
+///     starting in rule state <paramref name="RuleStack" />, and dropping the first
+///     <paramref name="SkipWrappedLines" /> wrapped lines (the tail of the previous page).
+/// </summary>
+/// <param name="SourceLine">0-based source line whose wrapping produces the page's first line.</param>
+/// <param name="SkipWrappedLines">Wrapped lines of that source line that belong to the previous page.</param>
+/// <param name="LineCount">Line number counter before <paramref name="SourceLine" /> was wrapped.</param>
+/// <param name="RuleStack">Grammar rule state before <paramref name="SourceLine" />.</param>
+internal readonly record struct TextMatePageAnchor(
+    int SourceLine,
+    int SkipWrappedLines,
+    int LineCount,
+    IStateStack? RuleStack);
@@ -0,0 +1,82 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using System.Drawing;
+using WinPrint.Core.Abstractions;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Fonts (by style) and brushes (by color) for painting <see cref="TextMateCte" /> pages, created on
+///     first use and reused across pages instead of per token run. A set is used by one
+///     <see cref="TextMateCte.PaintPage" /> call at a time, and only with graphics contexts like the one it
+///     was created for: fonts depend on the context's resolution and units, and a context only draws with
+///     fonts of its own implementation.
+/// </summary>
+internal sealed class TextMatePaintResources : IDisposable
+{
+    private readonly Dictionary<int, IGraphicsBrush> _brushes = [];
+    private readonly string _family;
+    private readonly Dictionary<GraphicsFontStyle, IGraphicsFont> _fonts = [];
+    private readonly float _size;
+    private readonly GraphicsFontUnit _unit;
+
+    /// <param name="family">Font family of the content font.</param>
+    /// <param name="size">Size of the content font, in <paramref name="unit" />.</param>
+    /// <param name="unit">Unit of <paramref name="size" />.</param>
+    /// <param name="generation">See <see cref="Generation" />.</param>
+    public TextMatePaintResources(string family, float size, GraphicsFontUnit unit, int generation)
+    {
+        _family = family;
+        _size = size;
+        _unit = unit;
+        Generation = generation;
+    }
+
+    /// <summary>
+    ///     Identifies fonts that measure the same way; run widths measured with one set's fonts are reused
+    ///     by every set of the same generation (see <see cref="TextMateWrappedRun.TryGetWidth" />).
+    /// </summary>
+    public int Generation { get; }
+
+    public void Dispose()
+    {
+        foreach (IGraphicsFont font in _fonts.Values)
+        {
+            font.Dispose();
+        }
+
+        foreach (IGraphicsBrush brush in _brushes.Values)
+        {
+            brush.Dispose();
+        }
+
+        _fonts.Clear();
+        _brushes.Clear();
+    }
+
+    /// <summary>Returns the content font in <paramref name="style" />, created with <paramref name="g" />.</summary>
+    public IGraphicsFont GetFont(IGraphicsContext g, GraphicsFontStyle style)
+    {
+        if (!_fonts.TryGetValue(style, out IGraphicsFont? font))
+        {
+            font = g.CreateFont(_family, _size, style, _unit);
+            _fonts.Add(style, font);
+        }
+
+        return font;
+    }
+
+    /// <summary>Returns a solid brush of <paramref name="color" />, created with <paramref name="g" />.</summary>
+    public IGraphicsBrush GetBrush(IGraphicsContext g, Color color)
+    {
+        int argb = color.ToArgb();
+        if (!_brushes.TryGetValue(argb, out IGraphicsBrush? brush))
+        {
+            brush = g.CreateSolidBrush(GraphicsColor.FromArgb(color.A, color.R, color.G, color.B));
+            _brushes.Add(argb, brush);
+        }
+
+        return brush;
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using System.Collections.Concurrent;
+using Serilog;
+using TextMateSharp.Grammars;
+using TextMateSharp.Registry;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Process-wide cache of TextMate registries and grammars, so documents after the first (e.g. a batch
+///     print of every file a glob matches) don't reload grammar and theme JSON or recompile grammar rules.
+///     Registry options, including the parsed grammars and themes, are shared per theme. Grammars aren't
+///     thread-safe, so compiled grammars are pooled per theme and scope: a reflow rents one per worker and
+///     returns it when done.
+/// </summary>
+internal static class TextMateRegistryCache
+{
+    private static readonly ConcurrentDictionary<ThemeName, Lazy<WinPrintRegistryOptions>> s_options = new();
+
+    // Idle tokenizers by theme and scope, each with its own Registry.
+    private static readonly ConcurrentDictionary<(ThemeName Theme, string Scope),
+        ConcurrentBag<(Registry? Registry, IGrammar? Grammar)>> s_tokenizers = new();
+
+    /// <summary>Idle tokenizers kept per theme and scope; one per concurrent reflow worker.</summary>
+    private static int MaxIdle => Environment.ProcessorCount;
+
+    /// <summary>Returns the shared registry options for <paramref name="theme" />.</summary>
+    public static WinPrintRegistryOptions GetOptions(ThemeName theme)
+    {
+        return s_options.GetOrAdd(theme,
+            static t => new Lazy<WinPrintRegistryOptions>(() => new WinPrintRegistryOptions(new RegistryOptions(t))))
+            .Value;
+    }
+
+    /// <summary>
+    ///     Takes an idle tokenizer for <paramref name="scopeName" />, or creates one: a separate
+    ///     <see cref="Registry" /> with its own instance of the grammar. Returns nulls (plain text) for a
+    ///     null scope. Throws if the grammar can't be loaded.
+    /// </summary>
+    public static (Registry? Registry, IGrammar? Grammar) Rent(ThemeName theme, string? scopeName)
+    {
+        if (string.IsNullOrEmpty(scopeName))
+        {
+            return (null, null);
+        }
+
+        if (s_tokenizers.TryGetValue((theme, scopeName),
+                out ConcurrentBag<(Registry? Registry, IGrammar? Grammar)>? idle) &&
+            idle.TryTake(out (Registry? Registry, IGrammar? Grammar) tokenizer))
+        {
+            return tokenizer;
+        }
+
+        var registry = new Registry(GetOptions(theme));
+        return (registry, registry.LoadGrammar(scopeName));
+    }
+
+    /// <summary>Returns a tokenizer from <see cref="Rent" /> to the pool.</summary>
+    public static void Return(ThemeName theme, string? scopeName, (Registry? Registry, IGrammar? Grammar) tokenizer)
+    {
+        if (string.IsNullOrEmpty(scopeName) || tokenizer.Grammar is null)
+        {
+            return;
+        }
+
+        ConcurrentBag<(Registry? Registry, IGrammar? Grammar)> idle = s_tokenizers.GetOrAdd((theme, scopeName),
+            static _ => []);
+        if (idle.Count < MaxIdle)
+        {
+            idle.Add(tokenizer);
+        }
+    }
+
+    /// <summary>
+    ///     Loads and compiles, in the background, the grammars for the most common file types among
+    ///     <paramref name="filePaths" /> (at most <paramref name="maxScopes" />), so the first document of
+    ///     each type doesn't pay for it. Failures are logged and otherwise ignored.
+    /// </summary>
+    /// <returns>The scopes of the grammars loaded.</returns>
+    public static Task<List<string>> WarmUpAsync(ThemeName theme, IEnumerable<string> filePaths, int maxScopes = 4)
+    {
+        List<string> extensions = [.. filePaths
+            .Select(Path.GetExtension)
+            .Where(e => !string.IsNullOrEmpty(e))
+            .GroupBy(e => e!, StringComparer.OrdinalIgnoreCase)
+            .OrderByDescending(g => g.Count())
+            .Select(g => g.Key)];
+        if (extensions.Count == 0)
+        {
+            return Task.FromResult<List<string>>([]);
+        }
+
+        return Task.Run(() =>
+        {
+            List<string> warmed = [];
+            try
+            {
+                WinPrintRegistryOptions options = GetOptions(theme);
+                IEnumerable<string> scopes = extensions
+                    .Select(e => WinPrintGrammars.ResolveScope(e, null, null) ??
+                                 options.Bundled.GetScopeByExtension(e))
+                    .OfType<string>()
+                    .Where(s => s.Length > 0)
+                    .Distinct(StringComparer.Ordinal)
+                    .Take(maxScopes);
+                foreach (string scope in scopes)
+                {
+                    Return(theme, scope, Rent(theme, scope));
+                    warmed.Add(scope);
+                    Log.Debug("TextMate: warmed up grammar {scope} ({theme}).", scope, theme);
+                }
+            }
+            catch (Exception ex)
+            {
+                // Warm-up is only an optimization; rendering reports real grammar failures.
+                Log.Debug(ex, "TextMate: grammar warm-up failed.");
+            }
+
+            return warmed;
+        });
+    }
+
+    /// <summary>Drops all cached registries and grammars.</summary>
+    public static void Clear()
+    {
+        s_tokenizers.Clear();
+        s_options.Clear();
+    }
+}
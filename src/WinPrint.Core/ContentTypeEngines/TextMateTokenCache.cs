@@ -0,0 +1,71 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Process-wide cache of the tokenized lines of the most recently rendered <see cref="TextMateCte" />
+///     documents. Tokens don't depend on page geometry, so a reflow after a margin, font size or layout
+///     change re-wraps cached tokens instead of re-running the grammar. Entries are keyed by the file,
+///     grammar scope, theme and the settings that change what is tokenized (tab expansion and form feed
+///     splitting). The document version is checked per line: a cached line is reused only when its text,
+///     and the rule state it starts in, are unchanged, so after an edit only lines from the first change on
+///     are tokenized again. Entries are never modified once stored, so they can be read concurrently.
+/// </summary>
+internal static class TextMateTokenCache
+{
+    // Number of documents kept; each entry holds the tokens of a whole document.
+    private const int Capacity = 4;
+
+    // Most recently used first.
+    private static readonly List<KeyValuePair<string, IReadOnlyList<TextMateTokenizedLine>>> s_entries = [];
+    private static readonly Lock s_lock = new();
+
+    /// <summary>Returns the tokenized lines last stored for <paramref name="key" />, or null.</summary>
+    public static IReadOnlyList<TextMateTokenizedLine>? Get(string key)
+    {
+        lock (s_lock)
+        {
+            int index = s_entries.FindIndex(e => e.Key == key);
+            if (index < 0)
+            {
+                return null;
+            }
+
+            KeyValuePair<string, IReadOnlyList<TextMateTokenizedLine>> entry = s_entries[index];
+            s_entries.RemoveAt(index);
+            s_entries.Insert(0, entry);
+            return entry.Value;
+        }
+    }
+
+    /// <summary>Stores the tokenized lines of a whole document, replacing any entry for the key.</summary>
+    public static void Set(string key, IReadOnlyList<TextMateTokenizedLine> lines)
+    {
+        lock (s_lock)
+        {
+            s_entries.RemoveAll(e => e.Key == key);
+            s_entries.Insert(0, new KeyValuePair<string, IReadOnlyList<TextMateTokenizedLine>>(key, lines));
+            if (s_entries.Count > Capacity)
+            {
+                s_entries.RemoveRange(Capacity, s_entries.Count - Capacity);
+            }
+        }
+    }
+
+    /// <summary>Builds the cache key for a document.</summary>
+    public static string CreateKey(string? filePath, string? scopeName, string theme, int tabSpaces,
+        bool newPageOnFormFeed)
+    {
+        return $"{scopeName}|{theme}|{tabSpaces}|{newPageOnFormFeed}|{filePath}";
+    }
+
+    /// <summary>Empties the cache.</summary>
+    public static void Clear()
+    {
+        lock (s_lock)
+        {
+            s_entries.Clear();
+        }
+    }
+}
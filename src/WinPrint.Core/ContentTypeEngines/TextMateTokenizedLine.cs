@@ -0,0 +1,27 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using System.Drawing;
+using TextMateSharp.Grammars;
+using TextMateFontStyle = TextMateSharp.Themes.FontStyle;
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     The tokens of one source line, independent of page geometry, so a reflow can re-wrap them without
+///     running the grammar again (see <see cref="TextMateTokenCache" />).
+/// </summary>
+internal sealed class TextMateTokenizedLine
+{
+    /// <summary>The source line as read from the document, used to detect changed lines.</summary>
+    public string Source { get; init; } = string.Empty;
+
+    /// <summary>The line after tab expansion, split at form feeds (one part when there are none).</summary>
+    public string[] Parts { get; init; } = [];
+
+    /// <summary>Tokens of each of <see cref="Parts" />.</summary>
+    public List<(int Start, int End, Color Foreground, TextMateFontStyle FontStyle)>[] Tokens { get; init; } = [];
+
+    /// <summary>Grammar rule state at the end of the line; tokenizing the next line starts from it.</summary>
+    public IStateStack? RuleStack { get; init; }
+}
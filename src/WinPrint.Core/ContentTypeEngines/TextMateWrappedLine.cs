@@ -2,7 +2,7 @@ namespace WinPrint.Core.ContentTypeEngines;
 
 internal sealed class TextMateWrappedLine
 {
-    public int NonWrappedLineNumber { get; init; }
+    public int NonWrappedLineNumber { get; set; }
     public string Text { get; init; } = string.Empty;
     public List<TextMateWrappedRun> Runs { get; } = [];
 }
@@ -5,8 +5,27 @@ namespace WinPrint.Core.ContentTypeEngines;
 
 internal sealed class TextMateWrappedRun
 {
+    // Width measured when the run was first painted, tagged with the TextMatePaintResources generation
+    // whose fonts measured it: generation in the high 32 bits, width bits in the low 32, so that the pair
+    // is read and written atomically by concurrent PaintPage calls. 0 means not measured.
+    private long _measuredWidth;
+
     public int Start { get; init; }
     public int Length { get; init; }
     public Color Foreground { get; init; } = Color.Black;
     public TextMateFontStyle FontStyle { get; init; } = TextMateFontStyle.None;
+
+    /// <summary>Gets the run's width if it was measured with fonts of paint <paramref name="generation" />.</summary>
+    public bool TryGetWidth(int generation, out float width)
+    {
+        long measured = Volatile.Read(ref _measuredWidth);
+        width = BitConverter.Int32BitsToSingle((int)measured);
+        return (int)(measured >> 32) == generation;
+    }
+
+    /// <summary>Records the run's width as measured with fonts of paint <paramref name="generation" />.</summary>
+    public void SetWidth(int generation, float width)
+    {
+        Volatile.Write(ref _measuredWidth, ((long)generation << 32) | (uint)BitConverter.SingleToInt32Bits(width));
+    }
 }
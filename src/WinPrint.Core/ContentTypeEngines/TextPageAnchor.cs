@@ -0,0 +1,14 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Where a page starts when <see cref="TextCte" /> streams from a <see cref="TextFileLineSource" />:
+///     the page is regenerated by re-wrapping source lines from <paramref name="SourceLine" />, dropping the
+///     first <paramref name="SkipWrappedLines" /> wrapped lines (the tail of the previous page).
+/// </summary>
+/// <param name="SourceLine">0-based source line whose wrapping produces the page's first line.</param>
+/// <param name="SkipWrappedLines">Wrapped lines of that source line that belong to the previous page.</param>
+/// <param name="LineCount">Line number counter before <paramref name="SourceLine" /> was wrapped.</param>
+internal readonly record struct TextPageAnchor(int SourceLine, int SkipWrappedLines, int LineCount);
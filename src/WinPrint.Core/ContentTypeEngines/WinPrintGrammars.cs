@@ -13,7 +13,7 @@ namespace WinPrint.Core.ContentTypeEngines;
 ///     WinPrint's own TextMate grammars, bundled as embedded resources for languages that
 ///     <c>TextMateSharp.Grammars</c> doesn't ship (currently the esoteric languages Brainfuck and
 ///     INTERCAL). Resolves a TextMate scope from a file extension / content type / language, and loads
-///     the grammar for a scope on demand.
+///     the grammar for a scope on demand, caching bundled grammars as well as ours.
 /// </summary>
 internal static class WinPrintGrammars
 {
@@ -46,12 +46,15 @@ internal static class WinPrintGrammars
         return null;
     }
 
-    /// <summary>Returns the parsed grammar for one of our scopes, or null if it isn't ours / can't be read.</summary>
-    public static IRawGrammar? GetGrammar(string scopeName)
+    /// <summary>
+    ///     Returns the parsed grammar for <paramref name="scopeName" />: one of ours, or else the one
+    ///     <paramref name="bundledGrammar" /> reads from the TextMateSharp bundle. Either way a grammar is read
+    ///     once per process and shared by every <c>Registry</c> (see <see cref="TextMateRegistryCache" />).
+    /// </summary>
+    public static IRawGrammar? GetGrammar(string scopeName, Func<string, IRawGrammar?> bundledGrammar)
     {
-        return s_resourceByScope.TryGetValue(scopeName, out string? suffix)
-            ? s_cache.GetOrAdd(scopeName, _ => Load(suffix))
-            : null;
+        return s_cache.GetOrAdd(scopeName, static (scope, bundled) =>
+            s_resourceByScope.TryGetValue(scope, out string? suffix) ? Load(suffix) : bundled(scope), bundledGrammar);
     }
 
     private static IRawGrammar? Load(string resourceSuffix)
@@ -1,6 +1,7 @@
 // Copyright Kindel, LLC - http://www.kindel.com
 // Published under the MIT License at https://github.com/tig/winprint
 
+using System.Collections.Concurrent;
 using TextMateSharp.Grammars;
 using TextMateSharp.Internal.Types;
 using TextMateSharp.Registry;
@@ -12,24 +13,32 @@ namespace WinPrint.Core.ContentTypeEngines;
 ///     An <see cref="IRegistryOptions" /> that augments the bundled <see cref="RegistryOptions" /> with
 ///     WinPrint's own grammars (see <see cref="WinPrintGrammars" />). Themes and injections delegate to
 ///     the bundled options; grammar lookups prefer our custom grammars and fall back to the bundle.
+///     Parsed grammars and themes are cached, so one instance can be shared by many registries (see
+///     <see cref="TextMateRegistryCache" />).
 /// </summary>
 internal sealed class WinPrintRegistryOptions : IRegistryOptions
 {
+    private readonly Lazy<IRawTheme> _defaultTheme;
     private readonly RegistryOptions _inner;
+    private readonly ConcurrentDictionary<string, IRawTheme> _themes = new(StringComparer.Ordinal);
 
     public WinPrintRegistryOptions(RegistryOptions inner)
     {
         _inner = inner;
+        _defaultTheme = new Lazy<IRawTheme>(inner.GetDefaultTheme);
     }
 
+    /// <summary>The bundled options, for scope and language lookups.</summary>
+    public RegistryOptions Bundled => _inner;
+
     public IRawTheme GetTheme(string scopeName)
     {
-        return _inner.GetTheme(scopeName);
+        return _themes.GetOrAdd(scopeName, _inner.GetTheme);
     }
 
     public IRawTheme GetDefaultTheme()
     {
-        return _inner.GetDefaultTheme();
+        return _defaultTheme.Value;
     }
 
     public ICollection<string> GetInjections(string scopeName)
@@ -39,6 +48,6 @@ internal sealed class WinPrintRegistryOptions : IRegistryOptions
 
     public IRawGrammar GetGrammar(string scopeName)
     {
-        return WinPrintGrammars.GetGrammar(scopeName) ?? _inner.GetGrammar(scopeName);
+        return WinPrintGrammars.GetGrammar(scopeName, _inner.GetGrammar)!;
     }
 }
@@ -0,0 +1,109 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+namespace WinPrint.Core.ContentTypeEngines;
+
+/// <summary>
+///     Consecutive source lines wrapped independently of the rest of the document, so that chunks can be
+///     wrapped concurrently and stitched back together in order (see
+///     <see cref="ContentTypeEngineBase.WrapChunksAsync{TChunk}" />). The document line number and the page
+///     position at the start of a chunk are not known until the chunks before it are stitched. So lines are
+///     numbered from 1 within the chunk, and form feeds are recorded as page breaks instead of being padded
+///     out. <see cref="Stitch" /> applies both once the chunk's place in the document is known.
+/// </summary>
+/// <typeparam name="TLine">The engine's wrapped line type.</typeparam>
+internal sealed class WrapChunk<TLine>
+{
+    // Indexes into Lines where a form feed pads to the next page, in order.
+    private readonly List<int> _pageBreaks = [];
+
+    // Per wrapped source line: end (exclusive) of its lines, its page breaks, and the line number counter.
+    private readonly List<int> _lineEnds = [];
+    private readonly List<int> _lineNumberEnds = [];
+    private readonly List<int> _pageBreakEnds = [];
+
+    /// <param name="firstSourceLine">0-based index in the document of the chunk's first source line.</param>
+    /// <param name="sourceLines">The chunk's source lines.</param>
+    public WrapChunk(int firstSourceLine, List<string> sourceLines)
+    {
+        FirstSourceLine = firstSourceLine;
+        SourceLines = sourceLines;
+    }
+
+    /// <summary>0-based index in the document of <see cref="SourceLines" />[0].</summary>
+    public int FirstSourceLine { get; }
+
+    /// <summary>The chunk's source lines (before tab expansion).</summary>
+    public List<string> SourceLines { get; }
+
+    /// <summary>Wrapped lines of all source lines wrapped so far, without form feed padding.</summary>
+    public List<TLine> Lines { get; } = [];
+
+    /// <summary>Line number counter within the chunk; the first source line is numbered 1.</summary>
+    public int LineNumber { get; set; }
+
+    /// <summary>Number of source lines wrapped so far.</summary>
+    public int Count => _lineEnds.Count;
+
+    /// <summary>Records a form feed: the next wrapped line starts a new page.</summary>
+    public void AddPageBreak()
+    {
+        _pageBreaks.Add(Lines.Count);
+    }
+
+    /// <summary>Marks the end of the current source line's wrapped lines and page breaks.</summary>
+    public void EndSourceLine()
+    {
+        _lineEnds.Add(Lines.Count);
+        _pageBreakEnds.Add(_pageBreaks.Count);
+        _lineNumberEnds.Add(LineNumber);
+    }
+
+    /// <summary>Line number counter before source line <paramref name="index" /> was wrapped.</summary>
+    public int LineNumberBefore(int index)
+    {
+        return index == 0 ? 0 : _lineNumberEnds[index - 1];
+    }
+
+    /// <summary>
+    ///     Index into <see cref="Lines" /> of the first wrapped line of source line <paramref name="index" />.
+    /// </summary>
+    public int LineStart(int index)
+    {
+        return index == 0 ? 0 : _lineEnds[index - 1];
+    }
+
+    /// <summary>
+    ///     Appends the wrapped lines of source line <paramref name="index" /> to <paramref name="output" />,
+    ///     adding <paramref name="lineNumberOffset" /> to each line number and padding every form feed with
+    ///     blank lines up to the next page boundary.
+    /// </summary>
+    /// <param name="index">Source line within the chunk.</param>
+    /// <param name="lineNumberOffset">Document line number counter before the chunk.</param>
+    /// <param name="output">The list to append to.</param>
+    /// <param name="baseCount">Wrapped lines in the document before <paramref name="output" />[0].</param>
+    /// <param name="linesPerPage">Lines per page, for form feed padding.</param>
+    /// <param name="renumber">Returns a line with the given offset added to its line number (if it has one).</param>
+    /// <param name="blank">Creates a padding line.</param>
+    public void Stitch(int index, int lineNumberOffset, List<TLine> output, int baseCount, int linesPerPage,
+        Func<TLine, int, TLine> renumber, Func<TLine> blank)
+    {
+        int pageBreak = index == 0 ? 0 : _pageBreakEnds[index - 1];
+        int pageBreakEnd = _pageBreakEnds[index];
+        for (int i = LineStart(index); i <= _lineEnds[index]; i++)
+        {
+            for (; pageBreak < pageBreakEnd && _pageBreaks[pageBreak] == i; pageBreak++)
+            {
+                while (linesPerPage > 0 && (baseCount + output.Count) % linesPerPage != 0)
+                {
+                    output.Add(blank());
+                }
+            }
+
+            if (i < _lineEnds[index])
+            {
+                output.Add(renumber(Lines[i], lineNumberOffset));
+            }
+        }
+    }
+}
@@ -36,9 +36,9 @@ public class FileWatcher : IDisposable
         var watcher = new FileSystemSafeWatcher
         {
             Path = Path.GetDirectoryName(path) ?? string.Empty,
-            /* Watch for changes in LastAccess and LastWrite times, and
-               the renaming of files or directories. */
-            NotifyFilter = NotifyFilters.LastWrite,
+            /* Watch for changes in LastWrite time and size (a file being appended to
+               may not update LastWrite until its writer closes it). */
+            NotifyFilter = NotifyFilters.LastWrite | NotifyFilters.Size,
             Filter = Path.GetFileName(path)
         };
 
@@ -82,6 +82,7 @@ public class FileWatcher : IDisposable
                     _fileWatcher.Created -= OnChanged;
                     _fileWatcher.Deleted -= OnChanged;
                     _fileWatcher.Renamed -= OnRenamed;
+                    _fileWatcher.Dispose();
                     _fileWatcher = null;
                 }
             }
@@ -117,6 +117,20 @@ public class Settings : ModelBase
     public string DefaultSyntaxHighlighterCteNameClassName { get; set; } =
         ContentTypeEngineBase.DefaultSyntaxHighlighterCteNameClassName;
 
+    /// <summary>
+    ///     Files at least this large (in bytes) are streamed from disk by the engines that support it
+    ///     (text, TextMate, ANSI) instead of being read into memory in full. 0 disables streaming.
+    /// </summary>
+    [SafeForTelemetry]
+    public long StreamingThresholdBytes { get; set; } = 32 * 1024 * 1024;
+
+    /// <summary>
+    ///     How much of a file (in bytes) is examined to detect its encoding when it is loaded: a byte order mark,
+    ///     valid UTF-8, or else the charset detector. 0 examines the whole file.
+    /// </summary>
+    [SafeForTelemetry]
+    public int EncodingDetectionBytes { get; set; } = 256 * 1024;
+
     /// <summary>
     ///     Content type handlers
     /// </summary>
@@ -645,6 +659,8 @@ public class Settings : ModelBase
         DefaultContentType = src.DefaultContentType;
         DefaultCteClassName = src.DefaultCteClassName;
         DefaultSyntaxHighlighterCteNameClassName = src.DefaultSyntaxHighlighterCteNameClassName;
+        StreamingThresholdBytes = src.StreamingThresholdBytes;
+        EncodingDetectionBytes = src.EncodingDetectionBytes;
 
         foreach (KeyValuePair<string, SheetSettings> sheet in src.Sheets)
         {
@@ -709,6 +725,8 @@ public class Settings : ModelBase
         TelemetryCollector.Add(dictionary, nameof(DefaultCteClassName), DefaultCteClassName);
         TelemetryCollector.Add(dictionary, nameof(DefaultSyntaxHighlighterCteNameClassName),
             DefaultSyntaxHighlighterCteNameClassName);
+        TelemetryCollector.Add(dictionary, nameof(StreamingThresholdBytes), StreamingThresholdBytes);
+        TelemetryCollector.Add(dictionary, nameof(EncodingDetectionBytes), EncodingDetectionBytes);
         TelemetryCollector.Add(dictionary, nameof(NumFilesAssociations), NumFilesAssociations);
         TelemetryCollector.Add(dictionary, nameof(NumLanguages), NumLanguages);
         TelemetryCollector.Add(dictionary, nameof(DiagnosticRulesFont), DiagnosticRulesFont);
@@ -29,6 +29,11 @@ internal static class TelemetryCollector
         dictionary[name] = value.ToString(CultureInfo.InvariantCulture);
     }
 
+    public static void Add(Dictionary<string, string?> dictionary, string name, long value)
+    {
+        dictionary[name] = value.ToString(CultureInfo.InvariantCulture);
+    }
+
     public static void Add(Dictionary<string, string?> dictionary, string name, Guid value)
     {
         dictionary[name] = value.ToString();
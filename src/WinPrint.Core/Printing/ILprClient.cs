@@ -23,9 +23,12 @@ public interface ILprClient
 
     /// <summary>
     ///     Submits a PDF document to the spooler via <c>lpr</c> (written to the process's standard
-    ///     input to avoid temp-file lifetime races). <paramref name="printerName" /> must be a
-    ///     concrete queue name (already resolved via <see cref="ResolveDestination" />).
+    ///     input to avoid temp-file lifetime races). <paramref name="writePdf" /> writes the document to
+    ///     the stream it is given as it renders, so <c>lpr</c> receives pages while later ones are still
+    ///     being painted, and returns the number of sheets and bytes it wrote; if it throws, the submission
+    ///     is abandoned. <paramref name="printerName" /> must be a concrete queue name (already resolved via
+    ///     <see cref="ResolveDestination" />).
     /// </summary>
-    Task<PrintJobResult> SubmitAsync(byte[] pdf, string printerName, string documentName, int sheetCount,
-        CancellationToken cancellationToken = default);
+    Task<PrintJobResult> SubmitAsync(Func<Stream, (int Sheets, long Bytes)> writePdf, string printerName,
+        string documentName, CancellationToken cancellationToken = default);
 }
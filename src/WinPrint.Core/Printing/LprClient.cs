@@ -1,6 +1,7 @@
 using System.Diagnostics;
 using Serilog;
 using WinPrint.Core.Abstractions;
+using WinPrint.Core.Services;
 
 namespace WinPrint.Core.Printing;
 
@@ -111,10 +112,12 @@ public sealed class LprClient : ILprClient
         return PrinterDestinationResult.Ok(printerName!);
     }
 
-    public async Task<PrintJobResult> SubmitAsync(byte[] pdf, string printerName, string documentName,
-        int sheetCount, CancellationToken cancellationToken = default)
+    public async Task<PrintJobResult> SubmitAsync(Func<Stream, (int Sheets, long Bytes)> writePdf,
+        string printerName, string documentName, CancellationToken cancellationToken = default)
     {
+        ArgumentNullException.ThrowIfNull(writePdf);
         ArgumentException.ThrowIfNullOrEmpty(printerName);
+        using DiagnosticsPhase phase = WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.SpoolPhase);
 
         var args = new List<string> { "-P", printerName };
 
@@ -144,12 +147,41 @@ public sealed class LprClient : ILprClient
                 return PrintJobResult.Failed("Failed to start 'lpr'.");
             }
 
-            await using (Stream stdin = process.StandardInput.BaseStream)
+            // Drain stderr while the document is written so a chatty lpr can't block on a full pipe.
+            Task<string> stderrTask = process.StandardError.ReadToEndAsync(CancellationToken.None);
+            int sheetCount;
+            try
             {
-                await stdin.WriteAsync(pdf, cancellationToken).ConfigureAwait(false);
+                // Pages are still being queued while lpr starts; the count is known once they're written.
+                (sheetCount, long bytes) = await Task.Run(() =>
+                {
+                    using Stream stdin = process.StandardInput.BaseStream;
+                    return writePdf(stdin);
+                }, cancellationToken).ConfigureAwait(false);
+                phase.SetPages(sheetCount).SetBytes(bytes);
+            }
+            catch (Exception ex)
+            {
+                // lpr has part of the document; it must not queue it when stdin closes.
+                if (!process.HasExited)
+                {
+                    process.Kill();
+                }
+
+                await process.WaitForExitAsync(CancellationToken.None).ConfigureAwait(false);
+                string lprError = (await stderrTask.ConfigureAwait(false)).Trim();
+                if (ex is OperationCanceledException)
+                {
+                    throw;
+                }
+
+                // A broken pipe means lpr gave up first; its own message says why.
+                return ex is IOException && lprError.Length > 0
+                    ? PrintJobResult.Failed(lprError)
+                    : PrintJobResult.Failed($"Failed to render document to PDF: {ex.Message}");
             }
 
-            string stderr = await process.StandardError.ReadToEndAsync(cancellationToken).ConfigureAwait(false);
+            string stderr = await stderrTask.ConfigureAwait(false);
             await process.WaitForExitAsync(cancellationToken).ConfigureAwait(false);
 
             if (process.ExitCode != 0)
@@ -7,7 +7,7 @@ namespace WinPrint.Core.Printing;
 
 /// <summary>
 ///     Cross-platform <see cref="IPrintJob" /> that renders the queued pages to a PDF with
-///     <see cref="SkiaPdfRenderer" /> and writes it to a file — the whole job, no printer involved.
+///     <see cref="SkiaPdfRenderer" />, streamed page by page into a file — no printer involved.
 ///     The lpr/CUPS submission of <see cref="UnixPrintJob" /> is replaced by a plain file write.
 /// </summary>
 public sealed class PdfFilePrintJob : IPrintJob
@@ -41,30 +41,50 @@ public sealed class PdfFilePrintJob : IPrintJob
             return PrintJobResult.Succeeded(0);
         }
 
-        byte[] pdf;
+        FileStream file;
         try
         {
-            pdf = SkiaPdfRenderer.Render(_pages, _pageSetup);
+            string? dir = Path.GetDirectoryName(_outputPath);
+            if (!string.IsNullOrEmpty(dir))
+            {
+                Directory.CreateDirectory(dir);
+            }
+
+            file = new FileStream(_outputPath, FileMode.Create, FileAccess.Write, FileShare.None, 64 * 1024);
         }
-        catch (Exception ex)
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException or NotSupportedException)
         {
-            return PrintJobResult.Failed($"Failed to render document to PDF: {ex.Message}");
+            return PrintJobResult.Failed($"Failed to write '{_outputPath}': {ex.Message}");
         }
 
+        // Pages are written as they are rendered, so memory doesn't grow with the document.
+        bool written = false;
         try
         {
-            string? dir = Path.GetDirectoryName(_outputPath);
-            if (!string.IsNullOrEmpty(dir))
+            await using (file.ConfigureAwait(false))
             {
-                Directory.CreateDirectory(dir);
+                await Task.Run(() => SkiaPdfRenderer.Render(_pages, _pageSetup, file, cancellationToken),
+                    cancellationToken).ConfigureAwait(false);
             }
 
-            await File.WriteAllBytesAsync(_outputPath, pdf, cancellationToken).ConfigureAwait(false);
+            written = true;
         }
         catch (Exception ex) when (ex is IOException or UnauthorizedAccessException or NotSupportedException)
         {
             return PrintJobResult.Failed($"Failed to write '{_outputPath}': {ex.Message}");
         }
+        catch (Exception ex) when (ex is not OperationCanceledException)
+        {
+            return PrintJobResult.Failed($"Failed to render document to PDF: {ex.Message}");
+        }
+        finally
+        {
+            if (!written)
+            {
+                // Don't leave a truncated PDF behind.
+                File.Delete(_outputPath);
+            }
+        }
 
         return PrintJobResult.Succeeded(_pages.Count);
     }
@@ -30,6 +30,20 @@ public static class PrintPipeline
             .PlanAsync(request, printService.CreateMeasurementContext())
             .ConfigureAwait(false);
 
+        return await PrintAsync(printService, request, plan, cancellationToken).ConfigureAwait(false);
+    }
+
+    /// <summary>
+    ///     Prints the selected sheet range of a request already reflowed by <see cref="PlanAsync" />, so a
+    ///     caller can reflow several documents ahead of the one being printed.
+    /// </summary>
+    public static async Task<PrintJobResult> PrintAsync(IPrintService printService, PrintRequest request,
+        PrintPlan plan, CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(printService);
+        ArgumentNullException.ThrowIfNull(request);
+        ArgumentNullException.ThrowIfNull(plan);
+
         if (plan.SelectedSheets <= 0)
         {
             return PrintJobResult.Succeeded(0);
@@ -37,6 +51,7 @@ public static class PrintPipeline
 
         using IPrintJob job = printService.CreateJob(plan.ResolvedSetup, request.DocumentName);
         job.Begin();
+        job.SetConcurrentPainting(request.SheetViewModel.SupportsConcurrentPainting);
 
         for (int sheet = plan.FromSheet; sheet <= plan.ToSheet; sheet++)
         {
@@ -0,0 +1,17 @@
+namespace WinPrint.Core.Printing;
+
+/// <summary>
+///     How a print job's output flowed to the spooler (see <see cref="UnixPrintJob" />).
+/// </summary>
+/// <param name="Pages">Pages rendered.</param>
+/// <param name="Bytes">Bytes of output handed to the spooler.</param>
+/// <param name="TimeToFirstByte">Time from the start of the job until the spooler received the first byte.</param>
+/// <param name="Elapsed">Time from the start of the job until the spooler accepted the last byte.</param>
+public readonly record struct PrintSpoolStats(int Pages, long Bytes, TimeSpan TimeToFirstByte, TimeSpan Elapsed)
+{
+    /// <summary>Pages rendered per second over the whole job.</summary>
+    public double PagesPerSecond => Elapsed > TimeSpan.Zero ? Pages / Elapsed.TotalSeconds : 0;
+
+    /// <summary>Bytes spooled per second over the whole job.</summary>
+    public double BytesPerSecond => Elapsed > TimeSpan.Zero ? Bytes / Elapsed.TotalSeconds : 0;
+}
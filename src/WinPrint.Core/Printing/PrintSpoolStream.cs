@@ -0,0 +1,218 @@
+using System.Diagnostics;
+using System.Runtime.ExceptionServices;
+using System.Threading.Channels;
+
+namespace WinPrint.Core.Printing;
+
+/// <summary>
+///     Write-only stream that decouples a producer (the PDF renderer) from a slower consumer (the standard
+///     input of <c>lpr</c>). Writes are gathered into chunks and queued; a background task copies them to
+///     the destination in order. At most <c>capacity</c> chunks are queued, after which writes wait for the
+///     destination to catch up, so memory stays bounded. If the destination fails (e.g. a broken pipe), the
+///     next write or <see cref="Complete" /> rethrows its exception.
+/// </summary>
+internal sealed class PrintSpoolStream : Stream
+{
+    /// <summary>Size of the chunks handed to the destination.</summary>
+    public const int ChunkSize = 64 * 1024;
+
+    // Cancelled by the caller's token, or by Dispose when the stream is abandoned.
+    private readonly CancellationTokenSource _cancellation;
+    private readonly CancellationToken _cancellationToken;
+    private readonly Channel<byte[]> _chunks;
+    private readonly Stream _destination;
+    private readonly Task _pump;
+    private readonly long _startTimestamp;
+    private long _bytesWritten;
+    private byte[] _chunk = new byte[ChunkSize];
+    private int _chunkLength;
+    private bool _completed;
+    private volatile ExceptionDispatchInfo? _fault;
+    private long _firstByteTimestamp;
+
+    /// <param name="destination">Stream the queued chunks are copied to; flushed, but not closed.</param>
+    /// <param name="capacity">Maximum number of chunks queued ahead of the destination.</param>
+    /// <param name="startTimestamp">
+    ///     <see cref="Stopwatch" /> timestamp that <see cref="TimeToFirstByte" /> is measured from.
+    /// </param>
+    /// <param name="cancellationToken">Stops the copy; pending and later writes throw.</param>
+    public PrintSpoolStream(Stream destination, int capacity, long startTimestamp,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(destination);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(capacity);
+
+        _destination = destination;
+        _startTimestamp = startTimestamp;
+        _cancellationToken = cancellationToken;
+        _cancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        _chunks = Channel.CreateBounded<byte[]>(new BoundedChannelOptions(capacity)
+        {
+            FullMode = BoundedChannelFullMode.Wait,
+            SingleReader = true,
+            SingleWriter = true,
+        });
+        _pump = Task.Run(PumpAsync, CancellationToken.None);
+    }
+
+    /// <summary>Bytes written to the destination so far.</summary>
+    public long BytesWritten => Interlocked.Read(ref _bytesWritten);
+
+    /// <summary>
+    ///     Time from the start timestamp until the first byte reached the destination, or <c>null</c> if
+    ///     nothing has been written to it yet.
+    /// </summary>
+    public TimeSpan? TimeToFirstByte
+    {
+        get
+        {
+            long firstByte = Interlocked.Read(ref _firstByteTimestamp);
+            return firstByte == 0 ? null : Stopwatch.GetElapsedTime(_startTimestamp, firstByte);
+        }
+    }
+
+    public override bool CanRead => false;
+    public override bool CanSeek => false;
+    public override bool CanWrite => !_completed;
+    public override long Length => throw new NotSupportedException();
+
+    public override long Position
+    {
+        get => throw new NotSupportedException();
+        set => throw new NotSupportedException();
+    }
+
+    /// <summary>
+    ///     Queues any buffered bytes, waits until everything has been copied to the destination and
+    ///     flushes it. Rethrows a destination failure.
+    /// </summary>
+    public void Complete()
+    {
+        if (!_completed)
+        {
+            QueueChunk();
+            _completed = true;
+            _chunks.Writer.TryComplete();
+        }
+
+        _pump.GetAwaiter().GetResult();
+        _cancellationToken.ThrowIfCancellationRequested();
+        _fault?.Throw();
+    }
+
+    public override void Write(byte[] buffer, int offset, int count)
+    {
+        Write(buffer.AsSpan(offset, count));
+    }
+
+    public override void Write(ReadOnlySpan<byte> buffer)
+    {
+        ObjectDisposedException.ThrowIf(_completed, this);
+
+        while (!buffer.IsEmpty)
+        {
+            int count = Math.Min(buffer.Length, _chunk.Length - _chunkLength);
+            buffer[..count].CopyTo(_chunk.AsSpan(_chunkLength));
+            _chunkLength += count;
+            buffer = buffer[count..];
+            if (_chunkLength == _chunk.Length)
+            {
+                QueueChunk();
+            }
+        }
+    }
+
+    /// <summary>Queues the buffered bytes without waiting for them to reach the destination.</summary>
+    public override void Flush()
+    {
+        if (!_completed)
+        {
+            QueueChunk();
+        }
+    }
+
+    public override int Read(byte[] buffer, int offset, int count)
+    {
+        throw new NotSupportedException();
+    }
+
+    public override long Seek(long offset, SeekOrigin origin)
+    {
+        throw new NotSupportedException();
+    }
+
+    public override void SetLength(long value)
+    {
+        throw new NotSupportedException();
+    }
+
+    protected override void Dispose(bool disposing)
+    {
+        if (disposing && !_completed)
+        {
+            // Abandoned (e.g. rendering failed): stop the copy without flushing the partial chunk.
+            _completed = true;
+            _chunks.Writer.TryComplete();
+            _cancellation.Cancel();
+        }
+
+        if (disposing && _pump.IsCompleted)
+        {
+            _cancellation.Dispose();
+        }
+
+        base.Dispose(disposing);
+    }
+
+    private void QueueChunk()
+    {
+        if (_chunkLength == 0)
+        {
+            return;
+        }
+
+        byte[] chunk = _chunkLength == _chunk.Length ? _chunk : _chunk[.._chunkLength];
+        try
+        {
+            // Blocks while the queue is full: this is the back-pressure on the renderer.
+            _chunks.Writer.WriteAsync(chunk, _cancellationToken).AsTask().GetAwaiter().GetResult();
+        }
+        catch (ChannelClosedException)
+        {
+            // The copy stopped; surface why.
+            _cancellationToken.ThrowIfCancellationRequested();
+            _fault?.Throw();
+            throw;
+        }
+
+        _chunk = new byte[ChunkSize];
+        _chunkLength = 0;
+    }
+
+    private async Task PumpAsync()
+    {
+        CancellationToken cancellationToken = _cancellation.Token;
+        try
+        {
+            await foreach (byte[] chunk in _chunks.Reader.ReadAllAsync(cancellationToken).ConfigureAwait(false))
+            {
+                await _destination.WriteAsync(chunk, cancellationToken).ConfigureAwait(false);
+                Interlocked.CompareExchange(ref _firstByteTimestamp, Stopwatch.GetTimestamp(), 0);
+                Interlocked.Add(ref _bytesWritten, chunk.Length);
+            }
+
+            await _destination.FlushAsync(cancellationToken).ConfigureAwait(false);
+        }
+        catch (Exception ex)
+        {
+            // Recorded rather than thrown so an abandoned stream leaves no unobserved exception. Completing
+            // the channel wakes a writer waiting for room, which then rethrows the failure.
+            if (ex is not OperationCanceledException)
+            {
+                _fault = ExceptionDispatchInfo.Capture(ex);
+            }
+
+            _chunks.Writer.TryComplete(ex);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+using System.Runtime.ExceptionServices;
+
+namespace WinPrint.Core.Printing.Skia;
+
+/// <summary>
+///     Write-only wrapper handed to <see cref="SkiaSharp.SKManagedWStream" /> so Skia can write straight
+///     to a managed stream (a file, or a pipe to <c>lpr</c>). Skia writes through a native callback, and an
+///     exception must not unwind through native frames, so a failed write is recorded instead of thrown;
+///     further writes are dropped. <see cref="ThrowIfFaulted" /> rethrows it on the managed side.
+/// </summary>
+internal sealed class SkiaOutputStream : Stream
+{
+    private readonly Stream _inner;
+    private ExceptionDispatchInfo? _fault;
+
+    public SkiaOutputStream(Stream inner)
+    {
+        _inner = inner;
+    }
+
+    public override bool CanRead => false;
+    public override bool CanSeek => false;
+    public override bool CanWrite => true;
+    public override long Length => throw new NotSupportedException();
+
+    public override long Position
+    {
+        get => throw new NotSupportedException();
+        set => throw new NotSupportedException();
+    }
+
+    /// <summary>Bytes written to the underlying stream.</summary>
+    public long BytesWritten { get; private set; }
+
+    /// <summary>Rethrows the first exception a write or flush of the underlying stream threw, if any.</summary>
+    public void ThrowIfFaulted()
+    {
+        _fault?.Throw();
+    }
+
+    public override void Write(byte[] buffer, int offset, int count)
+    {
+        Write(buffer.AsSpan(offset, count));
+    }
+
+    public override void Write(ReadOnlySpan<byte> buffer)
+    {
+        if (_fault is not null)
+        {
+            return;
+        }
+
+        try
+        {
+            _inner.Write(buffer);
+            BytesWritten += buffer.Length;
+        }
+        catch (Exception ex)
+        {
+            _fault = ExceptionDispatchInfo.Capture(ex);
+        }
+    }
+
+    public override void Flush()
+    {
+        if (_fault is not null)
+        {
+            return;
+        }
+
+        try
+        {
+            _inner.Flush();
+        }
+        catch (Exception ex)
+        {
+            _fault = ExceptionDispatchInfo.Capture(ex);
+        }
+    }
+
+    public override int Read(byte[] buffer, int offset, int count)
+    {
+        throw new NotSupportedException();
+    }
+
+    public override long Seek(long offset, SeekOrigin origin)
+    {
+        throw new NotSupportedException();
+    }
+
+    public override void SetLength(long value)
+    {
+        throw new NotSupportedException();
+    }
+}
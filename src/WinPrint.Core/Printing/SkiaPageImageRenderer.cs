@@ -1,3 +1,5 @@
+using System.Collections.Concurrent;
+using System.Runtime.CompilerServices;
 using SkiaSharp;
 using WinPrint.Core.Abstractions;
 using WinPrint.Core.Printing.Skia;
@@ -28,19 +30,45 @@ public static class SkiaPageImageRenderer
     /// </summary>
     public const float DefaultDpi = 300f;
 
+    /// <summary>
+    ///     Number of pages rasterized at once when concurrency is asked for (a <c>maxConcurrency</c> of 0) —
+    ///     only for documents whose engine supports concurrent painting. Each page in flight holds a full-page
+    ///     bitmap (about 35 MB for Letter at <see cref="DefaultDpi" />), so this bounds memory as well as CPU.
+    /// </summary>
+    public static int DefaultMaxConcurrency => Math.Clamp(Environment.ProcessorCount, 1, 4);
+
     /// <summary>
     ///     Renders each supplied page to a PNG bitmap (full physical page, white background) at
-    ///     <paramref name="dpi" /> and returns the encoded bytes in page order. Mirrors
+    ///     <paramref name="dpi" /> and yields the encoded bytes in page order. Mirrors
     ///     <see cref="SkiaPdfRenderer" />'s coordinate handling: user space is hundredths-of-an-inch and
     ///     the canvas is pre-scaled so the render delegate works entirely in those units.
+    ///     <para>
+    ///         Pages are rendered and encoded at most <paramref name="maxConcurrency" /> at a time, into
+    ///         bitmaps that are reused from page to page. A page is yielded as soon as it and every page before
+    ///         it are done; rendering runs ahead of the consumer by at most <paramref name="maxConcurrency" />
+    ///         pages, so memory stays bounded however long the job is. Ask for more than one page at a time only
+    ///         when the render delegates tolerate being called concurrently for different pages (see
+    ///         <see cref="SheetViewModel.SupportsConcurrentPainting" />); most content engines paint through
+    ///         shared state.
+    ///     </para>
     /// </summary>
-    public static IReadOnlyList<byte[]> RenderPages(
+    /// <param name="pages">The pages to render, in output order.</param>
+    /// <param name="pageSetup">Paper size and orientation.</param>
+    /// <param name="dpi">Raster density.</param>
+    /// <param name="maxConcurrency">
+    ///     Pages rendered at once; 1 (the default) renders sequentially, 0 uses <see cref="DefaultMaxConcurrency" />.
+    /// </param>
+    /// <param name="cancellationToken">Stops rendering further pages.</param>
+    public static async IAsyncEnumerable<byte[]> RenderPagesAsync(
         IReadOnlyList<(int PageNumber, Action<IGraphicsContext, int> Render)> pages,
         PrintPageSetup pageSetup,
-        float dpi = DefaultDpi)
+        float dpi = DefaultDpi,
+        int maxConcurrency = 1,
+        [EnumeratorCancellation] CancellationToken cancellationToken = default)
     {
         ArgumentNullException.ThrowIfNull(pages);
         ArgumentNullException.ThrowIfNull(pageSetup);
+        ArgumentOutOfRangeException.ThrowIfNegative(maxConcurrency);
 
         // In landscape the sheet is laid out in swapped dimensions (see SheetViewModel), so the bitmap
         // must be sized to match the long-edge-horizontal content (mirrors SkiaPdfRenderer).
@@ -51,10 +79,50 @@ public static class SkiaPageImageRenderer
         int pixelWidth = (int)Math.Ceiling(widthHundredths * scale);
         int pixelHeight = (int)Math.Ceiling(heightHundredths * scale);
 
-        var images = new List<byte[]>(pages.Count);
-        foreach ((int pageNumber, Action<IGraphicsContext, int> render) in pages)
+        int concurrency = maxConcurrency == 0 ? DefaultMaxConcurrency : maxConcurrency;
+        var bitmaps = new ConcurrentBag<SKBitmap>();
+        var pending = new Queue<Task<byte[]>>();
+        try
+        {
+            foreach ((int pageNumber, Action<IGraphicsContext, int> render) in pages)
+            {
+                if (pending.Count == concurrency)
+                {
+                    yield return await pending.Dequeue().ConfigureAwait(false);
+                }
+
+                cancellationToken.ThrowIfCancellationRequested();
+                pending.Enqueue(Task.Run(() => RenderPage(bitmaps, pixelWidth, pixelHeight, scale, dpi,
+                    pageNumber, render), cancellationToken));
+            }
+
+            while (pending.Count > 0)
+            {
+                yield return await pending.Dequeue().ConfigureAwait(false);
+            }
+        }
+        finally
+        {
+            // Abandoned (consumer stopped, cancelled, or a page failed): let pages in flight finish
+            // before their bitmaps are freed.
+            await ((Task)Task.WhenAll(pending)).ConfigureAwait(ConfigureAwaitOptions.SuppressThrowing);
+            foreach (SKBitmap bitmap in bitmaps)
+            {
+                bitmap.Dispose();
+            }
+        }
+    }
+
+    private static byte[] RenderPage(ConcurrentBag<SKBitmap> bitmaps, int pixelWidth, int pixelHeight,
+        float scale, float dpi, int pageNumber, Action<IGraphicsContext, int> render)
+    {
+        if (!bitmaps.TryTake(out SKBitmap? bitmap))
+        {
+            bitmap = new SKBitmap(pixelWidth, pixelHeight, SKColorType.Rgba8888, SKAlphaType.Premul);
+        }
+
+        try
         {
-            using var bitmap = new SKBitmap(pixelWidth, pixelHeight, SKColorType.Rgba8888, SKAlphaType.Premul);
             using (var canvas = new SKCanvas(bitmap))
             {
                 canvas.Clear(SKColors.White);
@@ -63,11 +131,12 @@ public static class SkiaPageImageRenderer
                 render(context, pageNumber);
             }
 
-            using var image = SKImage.FromBitmap(bitmap);
-            using SKData png = image.Encode(SKEncodedImageFormat.Png, 100);
-            images.Add(png.ToArray());
+            using SKData png = bitmap.Encode(SKEncodedImageFormat.Png, 100);
+            return png.ToArray();
+        }
+        finally
+        {
+            bitmaps.Add(bitmap);
         }
-
-        return images;
     }
 }
@@ -1,6 +1,7 @@
 using SkiaSharp;
 using WinPrint.Core.Abstractions;
 using WinPrint.Core.Printing.Skia;
+using WinPrint.Core.Services;
 
 namespace WinPrint.Core.Printing;
 
@@ -22,9 +23,29 @@ public static class SkiaPdfRenderer
     public static byte[] Render(
         IReadOnlyList<(int PageNumber, Action<IGraphicsContext, int> Render)> pages,
         PrintPageSetup pageSetup)
+    {
+        using var stream = new MemoryStream();
+        Render(pages, pageSetup, stream);
+        return stream.ToArray();
+    }
+
+    /// <summary>
+    ///     Renders the supplied pages as a PDF written to <paramref name="output" /> (e.g. a file, or the
+    ///     standard input of <c>lpr</c>) as the pages are produced, so memory stays flat however long the
+    ///     document is and a reader can start consuming it before the last page is painted. Write failures
+    ///     of <paramref name="output" /> are rethrown and stop rendering. <paramref name="output" /> is
+    ///     flushed but not closed. <paramref name="pages" /> is enumerated once, as the pages are rendered, so
+    ///     it may still be producing pages while earlier ones are written.
+    /// </summary>
+    public static void Render(
+        IEnumerable<(int PageNumber, Action<IGraphicsContext, int> Render)> pages,
+        PrintPageSetup pageSetup,
+        Stream output,
+        CancellationToken cancellationToken = default)
     {
         ArgumentNullException.ThrowIfNull(pages);
         ArgumentNullException.ThrowIfNull(pageSetup);
+        ArgumentNullException.ThrowIfNull(output);
 
         // In landscape the sheet is laid out in swapped dimensions (see SheetViewModel), so the PDF
         // page must be sized to match the long-edge-horizontal content.
@@ -34,26 +55,39 @@ public static class SkiaPdfRenderer
         float pageWidthPts = widthHundredths * HundredthsToPoints;
         float pageHeightPts = heightHundredths * HundredthsToPoints;
 
-        using var stream = new SKDynamicMemoryWStream();
-        using (var document = SKDocument.CreatePdf(stream))
+        using DiagnosticsPhase phase = WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.PdfPhase);
+        int rendered = 0;
+        var guarded = new SkiaOutputStream(output);
+        using (var stream = new SKManagedWStream(guarded))
         {
-            foreach ((int pageNumber, Action<IGraphicsContext, int> render) in pages)
+            using (var document = SKDocument.CreatePdf(stream))
             {
-                SKCanvas canvas = document.BeginPage(pageWidthPts, pageHeightPts);
+                foreach ((int pageNumber, Action<IGraphicsContext, int> render) in pages)
+                {
+                    cancellationToken.ThrowIfCancellationRequested();
+                    SKCanvas canvas = document.BeginPage(pageWidthPts, pageHeightPts);
+
+                    // Pre-scale so the render delegate can work entirely in hundredths-of-an-inch.
+                    canvas.Scale(HundredthsToPoints);
+
+                    var context = new SkiaGraphicsContext(canvas, pageSetup.DpiX, pageSetup.DpiY);
+                    render(context, pageNumber);
 
-                // Pre-scale so the render delegate can work entirely in hundredths-of-an-inch.
-                canvas.Scale(HundredthsToPoints);
+                    document.EndPage();
+                    rendered++;
 
-                var context = new SkiaGraphicsContext(canvas, pageSetup.DpiX, pageSetup.DpiY);
-                render(context, pageNumber);
+                    // Stop as soon as the reader has gone away (e.g. lpr exited).
+                    guarded.ThrowIfFaulted();
+                }
 
-                document.EndPage();
+                document.Close();
             }
 
-            document.Close();
+            stream.Flush();
         }
 
-        using SKData data = stream.DetachAsData();
-        return data.ToArray();
+        guarded.ThrowIfFaulted();
+        output.Flush();
+        phase.SetPages(rendered).SetBytes(guarded.BytesWritten);
     }
 }
@@ -1,19 +1,34 @@
+using System.Diagnostics;
+using System.Threading.Channels;
+using Serilog;
 using WinPrint.Core.Abstractions;
 
 namespace WinPrint.Core.Printing;
 
 /// <summary>
-///     Cross-platform <see cref="IPrintJob" /> for Unix-like systems. Queues pages, renders them to a
-///     PDF with <see cref="SkiaPdfRenderer" />, then submits the PDF to CUPS via an
+///     Cross-platform <see cref="IPrintJob" /> for Unix-like systems. Pages are rendered to a PDF with
+///     <see cref="SkiaPdfRenderer" /> and streamed into the CUPS submission made via an
 ///     <see cref="ILprClient" />. Page rendering and reflow both use SkiaSharp, so measurement and
 ///     output stay consistent.
+///     The job is a pipeline: the first queued page starts <c>lpr</c> and the renderer, which paints pages
+///     as they are queued while a spool buffer (<see cref="SpoolBufferSize" /> bytes at most) feeds the
+///     rendered output to <c>lpr</c>. Painting waits when the buffer is full. <see cref="EndAsync" /> waits
+///     for the last page to be spooled and records <see cref="Stats" />.
 /// </summary>
 public sealed class UnixPrintJob : IPrintJob
 {
+    /// <summary>Bytes of rendered PDF that may be queued ahead of <c>lpr</c> before painting waits.</summary>
+    public const int SpoolBufferSize = 16 * PrintSpoolStream.ChunkSize;
+
+    private readonly CancellationTokenSource _cancellation = new();
     private readonly PrintPageSetup _pageSetup;
     private readonly string _documentName;
     private readonly ILprClient _lprClient;
-    private readonly List<(int PageNumber, Action<IGraphicsContext, int> Render)> _pages = [];
+    private Channel<(int PageNumber, Action<IGraphicsContext, int> Render)> _pages = CreatePageQueue();
+    private int _pagesRendered;
+    private Task<PrintJobResult>? _spool;
+    private PrintSpoolStream? _spoolStream;
+    private long _startTimestamp = Stopwatch.GetTimestamp();
     private bool _disposed;
 
     public UnixPrintJob(PrintPageSetup pageSetup, string documentName, ILprClient lprClient)
@@ -23,53 +38,132 @@ public sealed class UnixPrintJob : IPrintJob
         _lprClient = lprClient ?? throw new ArgumentNullException(nameof(lprClient));
     }
 
+    /// <summary>Timing of the last successfully spooled job, or <c>null</c>.</summary>
+    public PrintSpoolStats? Stats { get; private set; }
+
     public void Begin()
     {
-        _pages.Clear();
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        _pages = CreatePageQueue();
+        _pagesRendered = 0;
+        _spool = null;
+        _spoolStream = null;
+        Stats = null;
+        _startTimestamp = Stopwatch.GetTimestamp();
     }
 
     public void PrintPage(int pageNumber, Action<IGraphicsContext, int> renderPage)
     {
-        _pages.Add((pageNumber, renderPage));
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        _pages.Writer.TryWrite((pageNumber, renderPage));
+        _spool ??= StartSpool();
     }
 
     public async Task<PrintJobResult> EndAsync(CancellationToken cancellationToken = default)
     {
-        if (_pages.Count == 0)
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        // No more pages: the renderer finishes the document once it has painted the queued ones.
+        _pages.Writer.TryComplete();
+        if (_spool is null)
         {
             return PrintJobResult.Succeeded(0);
         }
 
-        // Resolve before Skia render — no destination ⇒ fail fast without painting the document.
-        PrinterDestinationResult destination = _lprClient.ResolveDestination(_pageSetup.PrinterName);
-        if (!destination.Success)
+        PrintJobResult result;
+        using (cancellationToken.Register(_cancellation.Cancel))
         {
-            return PrintJobResult.Failed(destination.Error!);
+            result = await _spool.ConfigureAwait(false);
         }
 
-        byte[] pdf;
-        try
+        if (!result.Success || _spoolStream is null)
         {
-            pdf = SkiaPdfRenderer.Render(_pages, _pageSetup);
-        }
-        catch (Exception ex)
-        {
-            return PrintJobResult.Failed($"Failed to render document to PDF: {ex.Message}");
+            return result;
         }
 
-        return await _lprClient
-            .SubmitAsync(pdf, destination.PrinterName!, _documentName, _pages.Count, cancellationToken)
-            .ConfigureAwait(false);
+        var stats = new PrintSpoolStats(_pagesRendered, _spoolStream.BytesWritten,
+            _spoolStream.TimeToFirstByte ?? TimeSpan.Zero, Stopwatch.GetElapsedTime(_startTimestamp));
+        Stats = stats;
+        Log.Information(
+            "Spooled {document}: {pages} pages, {bytes} bytes; first byte after {ttfb:F0} ms, " +
+            "done after {elapsed:F0} ms ({pagesPerSecond:F1} pages/s, {kbPerSecond:F0} KB/s)",
+            _documentName, stats.Pages, stats.Bytes, stats.TimeToFirstByte.TotalMilliseconds,
+            stats.Elapsed.TotalMilliseconds, stats.PagesPerSecond, stats.BytesPerSecond / 1024);
+
+        // Pages were still being queued when lpr was started; report the final count.
+        return PrintJobResult.Succeeded(_pagesRendered);
     }
 
     public void Dispose()
     {
         if (!_disposed)
         {
-            _pages.Clear();
+            // An unfinished job is abandoned: lpr is killed rather than handed a partial document.
+            _pages.Writer.TryComplete();
+            if (_spool is { IsCompleted: false })
+            {
+                _cancellation.Cancel();
+                _ = _spool.ContinueWith(_ => _cancellation.Dispose(), CancellationToken.None,
+                    TaskContinuationOptions.ExecuteSynchronously, TaskScheduler.Default);
+            }
+            else
+            {
+                _cancellation.Dispose();
+            }
+
             _disposed = true;
         }
 
         GC.SuppressFinalize(this);
     }
+
+    private static Channel<(int PageNumber, Action<IGraphicsContext, int> Render)> CreatePageQueue()
+    {
+        // Unbounded: queued pages are only delegates; back-pressure applies to the rendered bytes.
+        return Channel.CreateUnbounded<(int PageNumber, Action<IGraphicsContext, int> Render)>(
+            new UnboundedChannelOptions { SingleReader = true, SingleWriter = true });
+    }
+
+    private Task<PrintJobResult> StartSpool()
+    {
+        // Resolve before Skia render — no destination ⇒ fail fast without painting the document.
+        PrinterDestinationResult destination = _lprClient.ResolveDestination(_pageSetup.PrinterName);
+        if (!destination.Success)
+        {
+            _pages.Writer.TryComplete();
+            return Task.FromResult(PrintJobResult.Failed(destination.Error!));
+        }
+
+        ChannelReader<(int PageNumber, Action<IGraphicsContext, int> Render)> pages = _pages.Reader;
+        long startTimestamp = _startTimestamp;
+        CancellationToken cancellationToken = _cancellation.Token;
+
+        // Pages go to lpr as they are rendered; the client reports render failures.
+        return Task.Run(() => _lprClient.SubmitAsync(stdin =>
+            {
+                using var spool = new PrintSpoolStream(stdin, SpoolBufferSize / PrintSpoolStream.ChunkSize,
+                    startTimestamp, cancellationToken);
+                _spoolStream = spool;
+                SkiaPdfRenderer.Render(ReadPages(pages, cancellationToken), _pageSetup, spool, cancellationToken);
+                spool.Complete();
+                return (_pagesRendered, spool.BytesWritten);
+            }, destination.PrinterName!, _documentName, cancellationToken), CancellationToken.None);
+    }
+
+    // Yields pages as PrintPage queues them, waiting for the next one until EndAsync completes the queue.
+    private IEnumerable<(int PageNumber, Action<IGraphicsContext, int> Render)> ReadPages(
+        ChannelReader<(int PageNumber, Action<IGraphicsContext, int> Render)> pages,
+        CancellationToken cancellationToken)
+    {
+        while (pages.WaitToReadAsync(cancellationToken).AsTask().GetAwaiter().GetResult())
+        {
+            while (pages.TryRead(out (int PageNumber, Action<IGraphicsContext, int> Render) page))
+            {
+                _pagesRendered++;
+                yield return page;
+            }
+        }
+    }
 }
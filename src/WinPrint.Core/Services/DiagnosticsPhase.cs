@@ -0,0 +1,68 @@
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+
+namespace WinPrint.Core.Services;
+
+/// <summary>
+///     One timed phase started by <see cref="WinPrintDiagnostics.StartPhase" />. Disposing it records the
+///     elapsed time and ends its activity. The content type tags both the activity and the measurement; pages
+///     and bytes, which vary per document, tag only the activity.
+/// </summary>
+public sealed class DiagnosticsPhase : IDisposable
+{
+    private readonly Activity? _activity;
+    private readonly Histogram<double> _duration;
+    private readonly long _start = Stopwatch.GetTimestamp();
+    private string? _contentType;
+    private bool _disposed;
+
+    internal DiagnosticsPhase(Activity? activity, Histogram<double> duration)
+    {
+        _activity = activity;
+        _duration = duration;
+    }
+
+    /// <summary>Tags the phase with the document's content type.</summary>
+    public DiagnosticsPhase SetContentType(string? contentType)
+    {
+        _contentType = contentType;
+        _activity?.SetTag(WinPrintDiagnostics.ContentTypeTag, contentType);
+        return this;
+    }
+
+    /// <summary>Tags the phase with the number of pages it handled.</summary>
+    public DiagnosticsPhase SetPages(int pages)
+    {
+        _activity?.SetTag(WinPrintDiagnostics.PagesTag, pages);
+        return this;
+    }
+
+    /// <summary>Tags the phase with the number of bytes it read or wrote.</summary>
+    public DiagnosticsPhase SetBytes(long bytes)
+    {
+        _activity?.SetTag(WinPrintDiagnostics.BytesTag, bytes);
+        return this;
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        double elapsed = Stopwatch.GetElapsedTime(_start).TotalMilliseconds;
+        if (_contentType is null)
+        {
+            _duration.Record(elapsed);
+        }
+        else
+        {
+            _duration.Record(elapsed, new KeyValuePair<string, object?>(WinPrintDiagnostics.ContentTypeTag,
+                _contentType));
+        }
+
+        _activity?.Dispose();
+    }
+}
@@ -0,0 +1,96 @@
+using System.Collections.Frozen;
+using WinPrint.Core.Models;
+
+namespace WinPrint.Core.Services;
+
+/// <summary>
+///     Immutable, case-insensitive lookup tables built once from a <see cref="FileTypeMapping" />, so
+///     resolving a file's content type is a couple of hash lookups instead of a scan of every extension of
+///     every content type. <see cref="WinPrintServices.FileTypeMappingIndex" /> rebuilds it when the
+///     mapping is reloaded or its collections are replaced.
+/// </summary>
+public sealed class FileTypeMappingIndex
+{
+    // FilesAssociations pattern ("*.ext" or "*filename") -> content type id, as written.
+    private readonly FrozenDictionary<string, string> _associations;
+
+    // Content type id (any case) -> the id as it appears in ContentTypes (the first one, if repeated).
+    private readonly FrozenDictionary<string, string> _ids;
+
+    // ContentType.Extensions entry -> id of the first content type listing it. "*.ext" is stored as
+    // ".ext", so an extension matches either form with one lookup.
+    private readonly FrozenDictionary<string, string> _patterns;
+
+    private readonly Dictionary<string, string> _sourceAssociations;
+    private readonly IList<ContentType> _sourceContentTypes;
+
+    private FileTypeMappingIndex(FileTypeMapping mapping)
+    {
+        _sourceAssociations = mapping.FilesAssociations;
+        _sourceContentTypes = mapping.ContentTypes;
+
+        _associations = _sourceAssociations.ToFrozenDictionary(StringComparer.OrdinalIgnoreCase);
+
+        var ids = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+        var patterns = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+        foreach (ContentType contentType in _sourceContentTypes)
+        {
+            if (string.IsNullOrEmpty(contentType.Id))
+            {
+                continue;
+            }
+
+            ids.TryAdd(contentType.Id, contentType.Id);
+            foreach (string extension in contentType.Extensions ?? [])
+            {
+                patterns.TryAdd(extension.StartsWith("*.", StringComparison.Ordinal) ? extension[1..] : extension,
+                    contentType.Id);
+            }
+        }
+
+        _ids = ids.ToFrozenDictionary(StringComparer.OrdinalIgnoreCase);
+        _patterns = patterns.ToFrozenDictionary(StringComparer.OrdinalIgnoreCase);
+    }
+
+    /// <summary>Builds the index for <paramref name="mapping" />.</summary>
+    public static FileTypeMappingIndex Create(FileTypeMapping mapping)
+    {
+        ArgumentNullException.ThrowIfNull(mapping);
+        return new FileTypeMappingIndex(mapping);
+    }
+
+    /// <summary>
+    ///     True if the index reflects <paramref name="mapping" />'s current collections (they are replaced,
+    ///     not edited, when the mapping changes).
+    /// </summary>
+    public bool IsBuiltFrom(FileTypeMapping mapping)
+    {
+        return ReferenceEquals(_sourceAssociations, mapping.FilesAssociations) &&
+               ReferenceEquals(_sourceContentTypes, mapping.ContentTypes);
+    }
+
+    /// <summary>
+    ///     Returns the content type id for a file extension (e.g. <c>.cs</c>), or <c>null</c> if there is
+    ///     none. A <c>FilesAssociations</c> entry wins; it must name a known content type.
+    /// </summary>
+    public string? FindByExtension(string extension)
+    {
+        if (_associations.TryGetValue("*" + extension, out string? associated))
+        {
+            return _ids.GetValueOrDefault(associated);
+        }
+
+        return _patterns.GetValueOrDefault(extension);
+    }
+
+    /// <summary>
+    ///     Returns the content type id for a file name without an extension (e.g. <c>Makefile</c>), or
+    ///     <c>null</c> if there is none. A <c>FilesAssociations</c> entry wins and is used as written.
+    /// </summary>
+    public string? FindByFileName(string fileName)
+    {
+        return _associations.TryGetValue("*" + fileName, out string? associated)
+            ? associated
+            : _patterns.GetValueOrDefault(fileName);
+    }
+}
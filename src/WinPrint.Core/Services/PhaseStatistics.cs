@@ -0,0 +1,78 @@
+using System.Diagnostics.Metrics;
+using System.Globalization;
+using System.Text;
+
+namespace WinPrint.Core.Services;
+
+/// <summary>
+///     Collects the <see cref="WinPrintDiagnostics" /> phase durations recorded while it is alive, for a
+///     per-phase breakdown (<c>wp print --stats</c>). Measurements from every thread are counted, so phases
+///     that overlap (files prepared in parallel) add up to more than the wall-clock time.
+/// </summary>
+public sealed class PhaseStatistics : IDisposable
+{
+    private readonly MeterListener _listener = new();
+    private readonly Lock _lock = new();
+    private readonly Dictionary<string, PhaseTotals> _totals = new(StringComparer.Ordinal);
+
+    public PhaseStatistics()
+    {
+        var phases = WinPrintDiagnostics.Phases.ToDictionary(WinPrintDiagnostics.GetInstrumentName, p => p);
+        _listener.InstrumentPublished = (instrument, listener) =>
+        {
+            if (instrument.Meter.Name == WinPrintDiagnostics.SourceName &&
+                phases.TryGetValue(instrument.Name, out string? phase))
+            {
+                listener.EnableMeasurementEvents(instrument, phase);
+            }
+        };
+        _listener.SetMeasurementEventCallback<double>((_, elapsed, _, state) => Add((string)state!, elapsed));
+        _listener.Start();
+    }
+
+    /// <summary>
+    ///     The phases measured so far, in pipeline order: how many times each ran, and the total and longest
+    ///     time it took.
+    /// </summary>
+    public IReadOnlyList<(string Phase, int Count, TimeSpan Total, TimeSpan Max)> Snapshot()
+    {
+        lock (_lock)
+        {
+            return [.. WinPrintDiagnostics.Phases
+                .Where(_totals.ContainsKey)
+                .Select(p => (p, _totals[p].Count, TimeSpan.FromMilliseconds(_totals[p].TotalMilliseconds),
+                    TimeSpan.FromMilliseconds(_totals[p].MaxMilliseconds)))];
+        }
+    }
+
+    /// <summary>Formats <see cref="Snapshot" /> as a table, one phase per line.</summary>
+    public string Format()
+    {
+        var sb = new StringBuilder();
+        sb.AppendLine(CultureInfo.InvariantCulture,
+            $"{"Phase",-10}{"Count",7}{"Total ms",12}{"Mean ms",12}{"Max ms",12}");
+        foreach ((string phase, int count, TimeSpan total, TimeSpan max) in Snapshot())
+        {
+            double totalMs = total.TotalMilliseconds;
+            sb.AppendLine(CultureInfo.InvariantCulture,
+                $"{phase,-10}{count,7}{totalMs,12:F1}{totalMs / count,12:F1}{max.TotalMilliseconds,12:F1}");
+        }
+
+        return sb.ToString();
+    }
+
+    public void Dispose()
+    {
+        _listener.Dispose();
+    }
+
+    private void Add(string phase, double milliseconds)
+    {
+        lock (_lock)
+        {
+            PhaseTotals totals = _totals.GetValueOrDefault(phase);
+            _totals[phase] = new PhaseTotals(totals.Count + 1, totals.TotalMilliseconds + milliseconds,
+                Math.Max(totals.MaxMilliseconds, milliseconds));
+        }
+    }
+}
@@ -0,0 +1,7 @@
+namespace WinPrint.Core.Services;
+
+/// <summary>The durations <see cref="PhaseStatistics" /> has collected for one phase.</summary>
+/// <param name="Count">How many times the phase ran.</param>
+/// <param name="TotalMilliseconds">The sum of its durations.</param>
+/// <param name="MaxMilliseconds">The longest duration.</param>
+internal readonly record struct PhaseTotals(int Count, double TotalMilliseconds, double MaxMilliseconds);
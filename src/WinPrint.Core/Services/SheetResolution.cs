@@ -25,4 +25,29 @@ public static class SheetResolution
 
         return settings.DefaultSheet;
     }
+
+    /// <summary>
+    ///     Finds a sheet definition by its settings key or its name, as <c>--sheet</c> selects one. Returns null
+    ///     when none matches.
+    /// </summary>
+    public static SheetSettings? FindSheet(Settings settings, string? nameOrId)
+    {
+        ArgumentNullException.ThrowIfNull(settings);
+
+        if (string.IsNullOrEmpty(nameOrId))
+        {
+            return null;
+        }
+
+        foreach (KeyValuePair<string, SheetSettings> sheet in settings.Sheets)
+        {
+            if (string.Equals(sheet.Key, nameOrId, StringComparison.OrdinalIgnoreCase) ||
+                string.Equals(sheet.Value.Name, nameOrId, StringComparison.OrdinalIgnoreCase))
+            {
+                return sheet.Value;
+            }
+        }
+
+        return null;
+    }
 }
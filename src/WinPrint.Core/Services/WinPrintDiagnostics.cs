@@ -0,0 +1,85 @@
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+
+namespace WinPrint.Core.Services;
+
+/// <summary>
+///     The <see cref="ActivitySource" /> and <see cref="Meter" /> (both named <see cref="SourceName" />) that time
+///     the phases of getting a document onto paper: loading (and detecting the encoding of) a file, reflowing
+///     it, painting each sheet, rendering the PDF and submitting it to <c>lpr</c>. Each phase is traced as an
+///     activity (<c>winprint.&lt;phase&gt;</c>, tagged with the content type, page count and byte size where
+///     known) and recorded in a <c>winprint.&lt;phase&gt;.duration</c> histogram in milliseconds, tagged with
+///     the content type. Nothing is collected unless a listener is attached: <c>dotnet-counters</c>,
+///     <c>dotnet-trace</c>, an OpenTelemetry exporter, or <see cref="PhaseStatistics" /> (<c>wp print
+///     --stats</c>).
+/// </summary>
+public static class WinPrintDiagnostics
+{
+    /// <summary>Name of the <see cref="ActivitySource" /> and <see cref="Meter" />.</summary>
+    public const string SourceName = "WinPrint";
+
+    /// <summary>Reading a file and creating its content type engine.</summary>
+    public const string LoadPhase = "load";
+
+    /// <summary>Detecting a file's encoding (part of <see cref="LoadPhase" />).</summary>
+    public const string EncodingPhase = "encoding";
+
+    /// <summary>Laying the document out into pages (<c>RenderAsync</c>).</summary>
+    public const string ReflowPhase = "reflow";
+
+    /// <summary>Painting one sheet.</summary>
+    public const string PaintPhase = "paint";
+
+    /// <summary>Rendering sheets to PDF.</summary>
+    public const string PdfPhase = "pdf";
+
+    /// <summary>Submitting a PDF to <c>lpr</c>, including rendering it into the pipe.</summary>
+    public const string SpoolPhase = "spool";
+
+    /// <summary>Tag: the document's content type (e.g. <c>text/x-csharp</c>).</summary>
+    public const string ContentTypeTag = "winprint.content_type";
+
+    /// <summary>Tag: pages laid out, painted or rendered.</summary>
+    public const string PagesTag = "winprint.pages";
+
+    /// <summary>Tag: bytes read or written.</summary>
+    public const string BytesTag = "winprint.bytes";
+
+    private static readonly string? s_version = typeof(WinPrintDiagnostics).Assembly.GetName().Version?.ToString();
+
+    private static readonly string[] s_phases =
+        [LoadPhase, EncodingPhase, ReflowPhase, PaintPhase, PdfPhase, SpoolPhase];
+
+    private static readonly Meter s_meter = new(SourceName, s_version);
+
+    private static readonly Dictionary<string, Histogram<double>> s_durations = s_phases.ToDictionary(p => p,
+        p => s_meter.CreateHistogram<double>(GetInstrumentName(p), "ms", $"Duration of the {p} phase."));
+
+    /// <summary>Every phase, in pipeline order.</summary>
+    public static IReadOnlyList<string> Phases => s_phases;
+
+    /// <summary>Traces each phase.</summary>
+    public static ActivitySource ActivitySource { get; } = new(SourceName, s_version);
+
+    /// <summary>Records the duration of each phase.</summary>
+    public static Meter Meter => s_meter;
+
+    /// <summary>The name of the duration histogram of <paramref name="phase" />.</summary>
+    public static string GetInstrumentName(string phase)
+    {
+        return $"winprint.{phase}.duration";
+    }
+
+    /// <summary>
+    ///     Starts timing <paramref name="phase" /> (one of <see cref="Phases" />); disposing the result records it.
+    /// </summary>
+    public static DiagnosticsPhase StartPhase(string phase)
+    {
+        if (!s_durations.TryGetValue(phase, out Histogram<double>? duration))
+        {
+            throw new ArgumentOutOfRangeException(nameof(phase), phase, "Unknown phase.");
+        }
+
+        return new DiagnosticsPhase(ActivitySource.StartActivity($"winprint.{phase}"), duration);
+    }
+}
@@ -12,6 +12,7 @@ public sealed class WinPrintServices
 
     private Settings? _settings;
     private FileTypeMapping? _fileTypeMapping;
+    private FileTypeMappingIndex? _fileTypeMappingIndex;
 
     private WinPrintServices()
     {
@@ -42,6 +43,26 @@ public sealed class WinPrintServices
 
     public FileTypeMapping FileTypeMapping => _fileTypeMapping ??= FileTypeMappingService.Load();
 
+    /// <summary>
+    ///     Lookup index over <see cref="FileTypeMapping" />, rebuilt only when the mapping's collections have
+    ///     been replaced since it was built.
+    /// </summary>
+    public FileTypeMappingIndex FileTypeMappingIndex
+    {
+        get
+        {
+            FileTypeMapping mapping = FileTypeMapping;
+            FileTypeMappingIndex? index = Volatile.Read(ref _fileTypeMappingIndex);
+            if (index is null || !index.IsBuiltFrom(mapping))
+            {
+                index = FileTypeMappingIndex.Create(mapping);
+                Volatile.Write(ref _fileTypeMappingIndex, index);
+            }
+
+            return index;
+        }
+    }
+
     /// <summary>
     ///     Ensures a live <see cref="Settings" /> instance exists when settings failed to load at startup.
     /// </summary>
@@ -7,6 +7,7 @@ using System.Runtime.CompilerServices;
 using Serilog;
 using WinPrint.Core.Abstractions;
 using WinPrint.Core.ContentTypeEngines;
+using WinPrint.Core.Helpers;
 using WinPrint.Core.Models;
 using WinPrint.Core.Services;
 
@@ -36,8 +37,16 @@ namespace WinPrint.Core.ViewModels;
 /// </summary>
 public sealed class AppViewModel : INotifyPropertyChanged
 {
+    /// <summary>
+    ///     How long <see cref="ReflowAsync" /> waits for further settings changes before reflowing, so a
+    ///     burst of them reflows once.
+    /// </summary>
+    private static readonly TimeSpan s_reflowDelay = TimeSpan.FromMilliseconds(50);
+
     private readonly SheetViewModel? _sheetVM;
     private readonly PrintPageSetup _pageSetup;
+    private readonly Settings? _settings;
+    private readonly ReflowScheduler _reflows = new();
 
     private readonly List<string> _sheetKeys = [];
     private SheetSettings? _currentSheet;
@@ -52,6 +61,12 @@ public sealed class AppViewModel : INotifyPropertyChanged
     private int _currentPage;
     private int _totalPages;
 
+    // Watches the active file while Follow is on; _followPath is its full path (empty when not watching).
+    private readonly Lock _followLock = new();
+    private bool _follow;
+    private string _followPath = string.Empty;
+    private FileWatcher? _followWatcher;
+
     private string? _selectedPrinter;
     private string? _selectedPaperSize;
 
@@ -81,11 +96,24 @@ public sealed class AppViewModel : INotifyPropertyChanged
     ///     and the settings mutators still update the live <see cref="CurrentSheet" /> model (so changes
     ///     persist on save); file load / reflow / preview are no-ops.
     /// </summary>
-    public AppViewModel(PrintPageSetup pageSetup, SheetViewModel? sheetVM = null)
+    /// <param name="pageSetup">The page setup the sheets are laid out on.</param>
+    /// <param name="sheetVM">The preview/reflow engine, if any.</param>
+    /// <param name="settings">
+    ///     The settings whose sheets are selected and edited; defaults to the shared
+    ///     <see cref="WinPrintServices.Settings" />. A copy keeps option overrides applied for one file (e.g. by
+    ///     the headless print command) out of the sheets other files are using.
+    /// </param>
+    public AppViewModel(PrintPageSetup pageSetup, SheetViewModel? sheetVM = null, Settings? settings = null)
     {
         _pageSetup = pageSetup ?? throw new ArgumentNullException(nameof(pageSetup));
         _sheetVM = sheetVM;
+        _settings = settings;
         SheetNames = [];
+
+        if (_sheetVM is not null)
+        {
+            _sheetVM.ReflowProgress += OnSheetReflowProgress;
+        }
     }
 
     public event PropertyChangedEventHandler? PropertyChanged;
@@ -106,11 +134,26 @@ public sealed class AppViewModel : INotifyPropertyChanged
     /// </summary>
     public event EventHandler? ReflowCompleted;
 
+    /// <summary>
+    ///     Raised during a progressive reflow when more sheets have been laid out.
+    ///     <see cref="TotalPages"/> is the provisional count so far; the first sheets can be previewed
+    ///     before <see cref="ReflowCompleted"/>. May fire on a background thread.
+    /// </summary>
+    public event EventHandler? PagesAvailable;
+
+    /// <summary>
+    ///     Raised when lines appended to the followed <see cref="ActiveFile"/> (see <see cref="Follow"/>)
+    ///     have been laid out after the existing sheets and <see cref="TotalPages"/> is up to date. Only the
+    ///     last sheet's content changed, but headers and footers showing the page count did too. May fire on a
+    ///     background thread.
+    /// </summary>
+    public event EventHandler? DocumentAppended;
+
     /// <summary>The preview/reflow engine, or <see langword="null" /> for preview-less front ends.</summary>
     public SheetViewModel? SheetViewModel => _sheetVM;
 
     public PrintPageSetup CurrentPageSetup => _pageSetup;
-    public Settings Settings => WinPrintServices.Current.Settings;
+    public Settings Settings => _settings ?? WinPrintServices.Current.Settings;
 
     public IReadOnlyList<string> SheetKeys => _sheetKeys;
     public ObservableCollection<string> SheetNames { get; }
@@ -148,6 +191,27 @@ public sealed class AppViewModel : INotifyPropertyChanged
         set => SetField(ref _currentPage, value);
     }
 
+    /// <summary>
+    ///     Follows the active file: while true, the file is watched and lines appended to it are laid out
+    ///     after the existing sheets (raising <see cref="DocumentAppended"/>) instead of reloading it, so a
+    ///     growing log file can be tailed. A file that is truncated or rewritten is reloaded.
+    /// </summary>
+    public bool Follow
+    {
+        get => _follow;
+        set
+        {
+            if (SetField(ref _follow, value))
+            {
+                UpdateFollowWatcher();
+                if (value)
+                {
+                    _ = FollowAsync();
+                }
+            }
+        }
+    }
+
     public int TotalPages
     {
         get => _totalPages;
@@ -537,11 +601,16 @@ public sealed class AppViewModel : INotifyPropertyChanged
     ///     status message (or an <c>"Error:"</c>-prefixed message on failure) and reflows.
     ///     Returns true on success.
     /// </summary>
+    /// <param name="filePath">The file to load.</param>
+    /// <param name="cancellationToken">
+    ///     Abandons the load and its reflow; an <see cref="OperationCanceledException" /> is thrown rather
+    ///     than reported as an error.
+    /// </param>
     /// <remarks>
     ///     The "Error:" prefix is part of the contract — the MAUI preview drawable looks
     ///     for it to render the message as an overlay.
     /// </remarks>
-    public async Task<bool> LoadFileAsync(string filePath)
+    public async Task<bool> LoadFileAsync(string filePath, CancellationToken cancellationToken = default)
     {
         if (string.IsNullOrWhiteSpace(filePath))
         {
@@ -584,6 +653,8 @@ public sealed class AppViewModel : INotifyPropertyChanged
             }
         }
 
+        // A reflow of the previous document is moot; don't let it race the load.
+        _reflows.Cancel();
         IsBusy = true;
         StatusText = $"Loading {Path.GetFileName(filePath)}...";
 
@@ -592,7 +663,10 @@ public sealed class AppViewModel : INotifyPropertyChanged
             ActiveFile = filePath;
             OnPropertyChanged(nameof(IsFileLoaded));
 
-            bool loaded = await _sheetVM!.LoadFileAsync(filePath).ConfigureAwait(false);
+            SheetViewModel sheetVM = _sheetVM;
+            bool loaded = await _reflows
+                .RunExclusiveAsync(() => sheetVM.LoadFileAsync(filePath, cancellationToken: cancellationToken))
+                .ConfigureAwait(false);
             if (!loaded)
             {
                 StatusText = $"Error: Failed to load file: {filePath}";
@@ -602,16 +676,35 @@ public sealed class AppViewModel : INotifyPropertyChanged
                 return false;
             }
 
-            _sheetVM.SetPrinterPageSettings(_pageSetup);
-            await _sheetVM.ReflowAsync().ConfigureAwait(false);
+            // If a settings change supersedes this reflow, that change's reflow publishes the page count.
+            await _reflows.RunAsync(async supersededToken =>
+            {
+                using var reflowCancellation =
+                    CancellationTokenSource.CreateLinkedTokenSource(supersededToken, cancellationToken);
+                sheetVM.SetPrinterPageSettings(_pageSetup);
+                await sheetVM.ReflowAsync(reflowCancellation.Token).ConfigureAwait(false);
+                reflowCancellation.Token.ThrowIfCancellationRequested();
+
+                TotalPages = sheetVM.NumSheets;
+                CurrentPage = TotalPages > 0 ? 1 : 0;
+                StatusText = FormatSheetCount(filePath);
+                PreviewInvalidated?.Invoke(this, EventArgs.Empty);
+                ReflowCompleted?.Invoke(this, EventArgs.Empty);
+            }, TimeSpan.Zero).ConfigureAwait(false);
+
+            // Lines appended while the file was loading came before the watcher, or before the layout.
+            UpdateFollowWatcher();
+            if (_follow)
+            {
+                _ = FollowAsync();
+            }
 
-            TotalPages = _sheetVM.NumSheets;
-            CurrentPage = TotalPages > 0 ? 1 : 0;
-            StatusText = $"{Path.GetFileName(filePath)} — {TotalPages} sheet{(TotalPages == 1 ? "" : "s")}";
-            PreviewInvalidated?.Invoke(this, EventArgs.Empty);
-            ReflowCompleted?.Invoke(this, EventArgs.Empty);
             return true;
         }
+        catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+        {
+            throw;
+        }
         catch (Exception ex)
         {
             Log.Error(ex, "AppViewModel.LoadFileAsync failed for {file}", filePath);
@@ -623,9 +716,104 @@ public sealed class AppViewModel : INotifyPropertyChanged
         finally
         {
             IsBusy = false;
+            UpdateFollowWatcher();
         }
     }
 
+    /// <summary>
+    ///     Lays out the lines appended to <see cref="ActiveFile"/> since it was loaded (see
+    ///     <see cref="SheetViewModel.FollowAsync"/>) and raises <see cref="DocumentAppended"/>, or reloads the
+    ///     file if it was truncated or rewritten, or can't be extended in place. Runs whenever the file changes
+    ///     while <see cref="Follow"/> is on; never concurrently with a load or reflow. Failures are logged.
+    /// </summary>
+    public async Task FollowAsync()
+    {
+        if (_sheetVM is not { } sheetVM || !IsFileLoaded)
+        {
+            return;
+        }
+
+        string filePath = _activeFile;
+        try
+        {
+            FollowResult result = await _reflows.RunExclusiveAsync(async () =>
+            {
+                FollowResult followed = await sheetVM.FollowAsync().ConfigureAwait(false);
+                if (followed == FollowResult.Appended)
+                {
+                    TotalPages = sheetVM.NumSheets;
+                    StatusText = FormatSheetCount(filePath);
+                    DocumentAppended?.Invoke(this, EventArgs.Empty);
+                }
+
+                return followed;
+            }).ConfigureAwait(false);
+
+            if (result is FollowResult.Truncated or FollowResult.ReloadRequired)
+            {
+                await LoadFileAsync(filePath).ConfigureAwait(false);
+            }
+        }
+        catch (Exception ex)
+        {
+            Log.Error(ex, "AppViewModel.FollowAsync failed for {file}", filePath);
+        }
+    }
+
+    // Watches ActiveFile while Follow is on. The watcher is kept across reloads of the same file.
+    private void UpdateFollowWatcher()
+    {
+        string path = _follow && _sheetVM is not null && IsFileLoaded ? Path.GetFullPath(_activeFile) : string.Empty;
+        lock (_followLock)
+        {
+            if (string.Equals(path, _followPath, StringComparison.Ordinal))
+            {
+                return;
+            }
+
+            if (_followWatcher is not null)
+            {
+                _followWatcher.ChangedEvent -= OnFollowedFileChanged;
+                _followWatcher.Dispose();
+                _followWatcher = null;
+            }
+
+            _followPath = path;
+            if (path.Length > 0)
+            {
+                _followWatcher = new FileWatcher(path);
+                _followWatcher.ChangedEvent += OnFollowedFileChanged;
+            }
+        }
+    }
+
+    private void OnFollowedFileChanged(object? sender, EventArgs e)
+    {
+        _ = FollowAsync();
+    }
+
+    private string FormatSheetCount(string filePath)
+    {
+        return $"{Path.GetFileName(filePath)} — {TotalPages} sheet{(TotalPages == 1 ? "" : "s")}";
+    }
+
+    private void OnSheetReflowProgress(object? sender, string msg)
+    {
+        // Progress is only reported when the engine publishes more pages (throttled by the engine).
+        if (_sheetVM is not { IsPageCountProvisional: true, Ready: true } sheetVM || sheetVM.NumSheets == 0)
+        {
+            return;
+        }
+
+        TotalPages = sheetVM.NumSheets;
+        if (_currentPage == 0 && TotalPages > 0)
+        {
+            CurrentPage = 1;
+        }
+
+        PagesAvailable?.Invoke(this, EventArgs.Empty);
+    }
+
     public async Task<bool> RefreshAsync()
     {
         if (!IsFileLoaded)
@@ -637,7 +825,10 @@ public sealed class AppViewModel : INotifyPropertyChanged
     }
 
     /// <summary>
-    ///     Re-applies the current page setup to the sheet view model and reflows.
+    ///     Re-applies the current page setup to the sheet view model and reflows. Calls in quick succession
+    ///     coalesce: each cancels the reflow started (or scheduled) by the one before, and only the newest
+    ///     updates <see cref="TotalPages" /> and raises <see cref="ReflowCompleted" />. A superseded call
+    ///     returns without waiting for the newer reflow.
     /// </summary>
     public async Task ReflowAsync()
     {
@@ -647,6 +838,15 @@ public sealed class AppViewModel : INotifyPropertyChanged
         }
 
         IsBusy = true;
+        if (await _reflows.RunAsync(ct => ReflowCoreAsync(sheetVM, ct), s_reflowDelay).ConfigureAwait(false))
+        {
+            // A superseded call leaves IsBusy to the reflow that replaced it.
+            IsBusy = false;
+        }
+    }
+
+    private async Task ReflowCoreAsync(SheetViewModel sheetVM, CancellationToken cancellationToken)
+    {
         try
         {
             sheetVM.SetPrinterPageSettings(_pageSetup);
@@ -658,7 +858,8 @@ public sealed class AppViewModel : INotifyPropertyChanged
                 sheetVM.ContentEngine.ContentSettings.CopyPropertiesFrom(sheetVM.ContentSettings);
             }
 
-            await sheetVM.ReflowAsync().ConfigureAwait(false);
+            await sheetVM.ReflowAsync(cancellationToken).ConfigureAwait(false);
+            cancellationToken.ThrowIfCancellationRequested();
             TotalPages = sheetVM.NumSheets;
             if (_currentPage > TotalPages)
             {
@@ -668,15 +869,11 @@ public sealed class AppViewModel : INotifyPropertyChanged
             PreviewInvalidated?.Invoke(this, EventArgs.Empty);
             ReflowCompleted?.Invoke(this, EventArgs.Empty);
         }
-        catch (Exception ex)
+        catch (Exception ex) when (ex is not OperationCanceledException)
         {
             Log.Error(ex, "AppViewModel.ReflowAsync failed");
             StatusText = $"Reflow error: {ex.Message}";
         }
-        finally
-        {
-            IsBusy = false;
-        }
     }
 
     // ----- Sheet property mutators -----
@@ -0,0 +1,27 @@
+namespace WinPrint.Core.ViewModels;
+
+/// <summary>
+///     What <see cref="SheetViewModel.FollowAsync" /> found when it checked the loaded file for text appended
+///     since it was loaded (following a growing log file).
+/// </summary>
+public enum FollowResult
+{
+    /// <summary>No complete line has been appended; the layout is unchanged.</summary>
+    Unchanged,
+
+    /// <summary>The appended lines were laid out after the existing pages.</summary>
+    Appended,
+
+    /// <summary>
+    ///     The text that was loaded changed: the file was truncated, rotated or rewritten. Load it again; its
+    ///     sheets are not the ones laid out so far.
+    /// </summary>
+    Truncated,
+
+    /// <summary>
+    ///     Text was appended, but the layout can't be extended in place (e.g. the file was streamed from disk,
+    ///     or the engine can't append). Load the file again; the text laid out so far is unchanged, so only
+    ///     the sheets after the full ones already laid out are new.
+    /// </summary>
+    ReloadRequired
+}
@@ -0,0 +1,101 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+namespace WinPrint.Core.ViewModels;
+
+/// <summary>
+///     Runs reflows one at a time, newest wins. Each <see cref="RunAsync" /> cancels the reflow before it
+///     (whether still waiting out its delay or already running), so a burst of settings changes (dragging a
+///     margin, stepping through paper sizes) coalesces into a single reflow of the final settings instead of
+///     one full reflow per change queued behind each other. Reflows never overlap: a run starts only after the
+///     one it superseded has observed cancellation and unwound, since engines lay out into shared state.
+/// </summary>
+internal sealed class ReflowScheduler
+{
+    private readonly SemaphoreSlim _gate = new(1, 1);
+    private readonly Lock _lock = new();
+    private CancellationTokenSource? _latest;
+
+    /// <summary>Cancels the pending or running reflow, if any, without starting another.</summary>
+    public void Cancel()
+    {
+        lock (_lock)
+        {
+            _latest?.Cancel();
+        }
+    }
+
+    /// <summary>
+    ///     Runs <paramref name="action" /> once the running reflow, if any, has unwound, without canceling it
+    ///     or superseding pending ones. For work that changes the layout a reflow reads, such as loading a
+    ///     file or appending to a followed one.
+    /// </summary>
+    public async Task<T> RunExclusiveAsync<T>(Func<Task<T>> action)
+    {
+        await _gate.WaitAsync().ConfigureAwait(false);
+        try
+        {
+            return await action().ConfigureAwait(false);
+        }
+        finally
+        {
+            _gate.Release();
+        }
+    }
+
+    /// <summary>
+    ///     Cancels the previous reflow, waits <paramref name="delay" /> for further requests, then runs
+    ///     <paramref name="reflow" /> once the previous one has unwound.
+    /// </summary>
+    /// <param name="reflow">The reflow; should observe its token and throw when canceled.</param>
+    /// <param name="delay">How long to wait for a newer request before starting; may be zero.</param>
+    /// <returns>
+    ///     <c>true</c> if <paramref name="reflow" /> ran to completion; <c>false</c> if a newer request (or
+    ///     <see cref="Cancel" />) superseded it.
+    /// </returns>
+    public async Task<bool> RunAsync(Func<CancellationToken, Task> reflow, TimeSpan delay)
+    {
+        var cts = new CancellationTokenSource();
+        lock (_lock)
+        {
+            _latest?.Cancel();
+            _latest = cts;
+        }
+
+        try
+        {
+            if (delay > TimeSpan.Zero)
+            {
+                await Task.Delay(delay, cts.Token).ConfigureAwait(false);
+            }
+
+            await _gate.WaitAsync(cts.Token).ConfigureAwait(false);
+            try
+            {
+                await reflow(cts.Token).ConfigureAwait(false);
+                return true;
+            }
+            finally
+            {
+                _gate.Release();
+            }
+        }
+        catch (OperationCanceledException) when (cts.IsCancellationRequested)
+        {
+            return false;
+        }
+        finally
+        {
+            // Cleared under the lock so a later request never cancels a disposed source.
+            lock (_lock)
+            {
+                if (ReferenceEquals(_latest, cts))
+                {
+                    _latest = null;
+                }
+            }
+
+            cts.Dispose();
+        }
+    }
+}
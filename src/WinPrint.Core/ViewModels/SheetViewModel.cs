@@ -1,3 +1,4 @@
+using System.Buffers;
 using System.ComponentModel;
 using System.Drawing;
 #if WINDOWS
@@ -7,6 +8,7 @@ using System.Drawing.Printing;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Text;
+using System.Text.Unicode;
 using Serilog;
 using UtfUnknown;
 using WinPrint.Core.Abstractions;
@@ -24,15 +26,33 @@ namespace WinPrint.Core;
 /// </summary>
 public class SheetViewModel : ViewModelBase
 {
+    // Bytes before the followed offset compared by FollowAsync to tell an append from a rewrite.
+    private const int FollowTailBytes = 64;
+
+    // Encodings recognized by their byte order mark, checked in this order.
+    private static readonly Encoding[] s_bomEncodings =
+    [
+        Encoding.UTF8, Encoding.UTF32, new UTF32Encoding(true, true), Encoding.Unicode, Encoding.BigEndianUnicode
+    ];
+
     private Rectangle _bounds;
     private int _cols;
     private RectangleF _contentBounds;
     private ContentTypeEngineBase? _contentEngine;
     private ContentSettings _contentSettings = new();
     private string? _contentType;
+
+    // Streaming source for files over Settings.StreamingThresholdBytes; owned here, shared with the engine.
+    private TextFileLineSource? _documentSource;
     private Encoding? _encoding;
     private string? _file;
 
+    // Byte offset in File up to which the document has been loaded or followed, and the bytes just before
+    // it (see FollowAsync); -1 when the document was not loaded from File.
+    private long _followOffset = -1;
+    private byte[] _followTail = [];
+    private bool _isPageCountProvisional;
+
     private FooterViewModel _footerVM = null!;
 
     private HeaderViewModel _headerVM = null!;
@@ -44,6 +64,7 @@ public class SheetViewModel : ViewModelBase
     // These properties are all defined by user and sync'd with the Sheet model
     private PrintMargins _margins = new(0, 0, 0, 0);
 
+    // Published from the reflow worker while the UI thread reads it; always accessed through Volatile.
     private int _numPages;
     private int _padding;
     private bool _pageSeparator;
@@ -194,7 +215,7 @@ public class SheetViewModel : ViewModelBase
                 return 0;
             }
 
-            return (int)Math.Ceiling((double)_numPages / (Rows * Columns));
+            return (int)Math.Ceiling((double)Volatile.Read(ref _numPages) / (Rows * Columns));
         }
     }
 
@@ -275,15 +296,43 @@ public class SheetViewModel : ViewModelBase
     /// </summary>
     public bool Ready
     {
-        get => _ready;
+        get => Volatile.Read(ref _ready);
         set
         {
-            if (value != _ready)
+            if (value == Volatile.Read(ref _ready))
+            {
+                return;
+            }
+
+            OnReadyChanged(value);
+            Volatile.Write(ref _ready, value);
+            OnPropertyChanged();
+        }
+    }
+
+    /// <summary>
+    ///     True if sheets may be printed concurrently, each to its own graphics context: the content engine
+    ///     supports concurrent painting (see <see cref="ContentTypeEngineBase.SupportsConcurrentPainting" />).
+    /// </summary>
+    public bool SupportsConcurrentPainting => ContentEngine?.SupportsConcurrentPainting == true;
+
+    /// <summary>
+    ///     True while a reflow is still laying out pages. <see cref="Ready" /> may already be true (the
+    ///     first pages can be previewed), but <see cref="NumSheets" /> is a lower bound that grows until
+    ///     <see cref="ReflowAsync" /> completes.
+    /// </summary>
+    public bool IsPageCountProvisional
+    {
+        get => Volatile.Read(ref _isPageCountProvisional);
+        private set
+        {
+            if (value == Volatile.Read(ref _isPageCountProvisional))
             {
-                OnReadyChanged(value);
+                return;
             }
 
-            SetField(ref _ready, value);
+            Volatile.Write(ref _isPageCountProvisional, value);
+            OnPropertyChanged();
         }
     }
 
@@ -317,6 +366,10 @@ public class SheetViewModel : ViewModelBase
         PageSettingsSet?.Invoke(this, EventArgs.Empty);
     }
 
+    /// <summary>
+    ///     Raised as a reflow progresses. While <see cref="IsPageCountProvisional" /> is true,
+    ///     <see cref="NumSheets" /> reflects the sheets laid out so far.
+    /// </summary>
     public event EventHandler<string>? ReflowProgress;
 
     protected void OnReflowProgress(string msg)
@@ -352,7 +405,11 @@ public class SheetViewModel : ViewModelBase
             ContentEngine = null;
         }
 
-        _numPages = 0;
+        _documentSource?.Dispose();
+        _documentSource = null;
+        Volatile.Write(ref _numPages, 0);
+        _followOffset = -1;
+        _followTail = [];
     }
 
     /// <summary>
@@ -438,8 +495,10 @@ public class SheetViewModel : ViewModelBase
     /// </summary>
     /// <param name="filePath">Fully qualified path to File to load.</param>
     /// <param name="contentType">If null or empty, the file extension will be used to determine content type engine.</param>
+    /// <param name="cancellationToken">Abandons reading the file.</param>
     /// <returns>True if content type engine was initialized. False otherwise.</returns>
-    public async Task<bool> LoadFileAsync(string filePath, string? contentType = null)
+    public async Task<bool> LoadFileAsync(string filePath, string? contentType = null,
+        CancellationToken cancellationToken = default)
     {
         LogService.TraceMessage($"{filePath} - {contentType}");
         File = filePath ?? "";
@@ -453,6 +512,8 @@ public class SheetViewModel : ViewModelBase
             contentType = ContentTypeEngineBase.GetContentType(File);
         }
 
+        using DiagnosticsPhase phase = WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.LoadPhase)
+            .SetContentType(contentType);
 
         // If there's no file, this sets things up with an empty file which is good for 
         // print preview during startup.
@@ -464,49 +525,260 @@ public class SheetViewModel : ViewModelBase
         }
         // LoadAsync will throw FNFE if file was not found. Loading will remain true in this case...
 
-        using FileStream fileStream = System.IO.File.OpenRead(File);
-        DetectionDetail? detected = CharsetDetector.DetectFromStream(fileStream).Detected;
-        if (detected != null)
-        {
-            Log.Debug("File encoding detected: {encoding}", detected);
-            Encoding = detected.Encoding;
-        }
-        else
+        // Shared with writers, so a log file can be loaded (and followed) while it is being written.
+        using FileStream fileStream = OpenShared(File);
+        phase.SetBytes(fileStream.Length);
+
+        // Only a prefix of the file is examined; the whole file is read once, when it is decoded below.
+        int limit = WinPrintServices.Current.Settings.EncodingDetectionBytes;
+        long examined = limit > 0 ? Math.Min(fileStream.Length, limit) : fileStream.Length;
+        using (WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.EncodingPhase).SetContentType(contentType)
+                   .SetBytes(examined))
         {
-            // Not detected. We know CharsetDetector gets confused on ANSI encoded files (rightfully so).
-            // Does this file have ESC[ sequences?
-            if (fileStream.Length != 0 && !StreamHasAnsiEsc(fileStream))
+            (Encoding? detected, bool ansi) = limit > 0
+                ? await DetectEncodingAsync(fileStream, (int)examined, cancellationToken).ConfigureAwait(true)
+                : DetectEncoding(fileStream);
+            if (detected != null)
+            {
+                Log.Debug("File encoding detected: {encoding}", detected.WebName);
+                Encoding = detected;
+            }
+            else
             {
-                throw new InvalidOperationException(
-                    $"This file is not supported by winprint; could not determine the file encoding of '{Path.GetFullPath(File)}'.");
+                // Not detected. We know CharsetDetector gets confused on ANSI encoded files (rightfully so).
+                // Does this file have ESC[ sequences?
+                if (fileStream.Length != 0 && !ansi)
+                {
+                    throw new InvalidOperationException(
+                        $"This file is not supported by winprint; could not determine the file encoding of '{Path.GetFullPath(File)}'.");
+                }
+
+                Log.Debug("File encoding NOT detected, looks ANSI; using default: {encoding}", Encoding);
             }
+        }
 
-            Log.Debug("File encoding NOT detected, looks ANSI; using default: {encoding}", Encoding);
+        // Very large files are streamed from disk rather than read into one string.
+        cancellationToken.ThrowIfCancellationRequested();
+        long threshold = WinPrintServices.Current.Settings.StreamingThresholdBytes;
+        if (threshold > 0 && fileStream.Length >= threshold)
+        {
+            Log.Debug("Streaming {file} ({length} bytes) from disk.", File, fileStream.Length);
+            long streamed = fileStream.Length;
+            byte[] streamedTail = ReadTail(fileStream, streamed);
+            var source = new TextFileLineSource(File, Encoding);
+            bool streamedLoaded = await LoadDocumentAsync(null, source, contentType).ConfigureAwait(true);
+
+            // A streamed document can't be extended in place, but FollowAsync still tells whether it grew.
+            _followOffset = streamed;
+            _followTail = streamedTail;
+            return streamedLoaded;
         }
 
         fileStream.Position = 0;
         using var streamReader = new StreamReader(fileStream, Encoding);
-        document = await streamReader.ReadToEndAsync().ConfigureAwait(true);
+        document = await streamReader.ReadToEndAsync(cancellationToken).ConfigureAwait(true);
+
+        // The file may have grown while it was read; what was read is what FollowAsync continues from.
+        long loaded = fileStream.Position;
+        byte[] tail = ReadTail(fileStream, loaded);
+        bool retval = await LoadStringAsync(document, contentType).ConfigureAwait(true);
+        _followOffset = loaded;
+        _followTail = tail;
+        return retval;
+    }
+
+    /// <summary>
+    ///     Lays out the lines appended to <see cref="File" /> since it was loaded (or last followed) after the
+    ///     existing pages, reading only the appended bytes, so a growing log file can be tailed without
+    ///     reloading and reflowing all of it. Finished pages are untouched and <see cref="NumSheets" /> grows.
+    ///     An incomplete last line is left for a later call. Does nothing until the document has been
+    ///     reflowed; must not run concurrently with a load or <see cref="ReflowAsync" />.
+    /// </summary>
+    /// <param name="cancellationToken">Abandons laying out the appended lines; the layout is unchanged.</param>
+    /// <returns>
+    ///     <see cref="FollowResult.Truncated" /> when the text that was loaded changed (the file was truncated or
+    ///     rewritten); <see cref="FollowResult.ReloadRequired" /> when text was appended but the document can't
+    ///     be extended in place: it was streamed from disk, its encoding's line feed isn't the byte 0x0A, or the
+    ///     engine can't append (see <see cref="ContentTypeEngineBase.AppendAsync" />).
+    /// </returns>
+    public async Task<FollowResult> FollowAsync(CancellationToken cancellationToken = default)
+    {
+        // A file that has gone away is usually being rotated; wait for it to come back.
+        if (ContentEngine is not { } engine || !Ready || Loading || string.IsNullOrEmpty(File) ||
+            !System.IO.File.Exists(File))
+        {
+            return FollowResult.Unchanged;
+        }
+
+        // Only a load that failed part way leaves no offset to compare with.
+        if (_followOffset < 0)
+        {
+            return FollowResult.ReloadRequired;
+        }
+
+        using FileStream fileStream = OpenShared(File);
+        long length = fileStream.Length;
+        if (length == _followOffset)
+        {
+            return FollowResult.Unchanged;
+        }
+
+        if (length < _followOffset || !ReadTail(fileStream, _followOffset).AsSpan().SequenceEqual(_followTail))
+        {
+            Log.Debug("{file} was truncated or rewritten; reloading.", File);
+            return FollowResult.Truncated;
+        }
+
+        if (_documentSource is not null || length - _followOffset > Array.MaxLength || Encoding is null ||
+            !Encoding.GetBytes("\n").AsSpan().SequenceEqual("\n"u8))
+        {
+            Log.Debug("{file} grew, but can't be extended in place; reloading.", File);
+            return FollowResult.ReloadRequired;
+        }
+
+        byte[] appended = new byte[length - _followOffset];
+        fileStream.Position = _followOffset;
+        await fileStream.ReadExactlyAsync(appended, cancellationToken).ConfigureAwait(false);
+        int end = appended.AsSpan().LastIndexOf((byte)'\n') + 1;
+        if (end == 0)
+        {
+            return FollowResult.Unchanged;
+        }
+
+        string text = Encoding.GetString(appended, 0, end);
+        using (DiagnosticsPhase phase = WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.ReflowPhase)
+                   .SetContentType(ContentType).SetBytes(end))
+        {
+            int pages = await engine.AppendAsync(text, (_, msg) => OnReflowProgress(msg), cancellationToken)
+                .ConfigureAwait(false);
+            if (pages < 0)
+            {
+                return FollowResult.ReloadRequired;
+            }
+
+            Volatile.Write(ref _numPages, pages);
+            phase.SetPages(pages);
+        }
+
+        _followOffset += end;
+        _followTail = ReadTail(fileStream, _followOffset);
+        Log.Debug("Followed {bytes} appended bytes of {file}; {pages} pages.", end, File, Volatile.Read(ref _numPages));
+        return FollowResult.Appended;
+    }
+
+    private static FileStream OpenShared(string path)
+    {
+        return new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
+    }
+
+    // Returns the (up to) FollowTailBytes bytes of the stream before offset end.
+    private static byte[] ReadTail(Stream stream, long end)
+    {
+        byte[] tail = new byte[(int)Math.Min(FollowTailBytes, end)];
+        stream.Position = end - tail.Length;
+        stream.ReadExactly(tail);
+        return tail;
+    }
 
-        return await LoadStringAsync(document, contentType).ConfigureAwait(true);
+    // Detects the encoding from the first `length` bytes of the stream: a byte order mark, then text that
+    // is valid UTF-8, then CharsetDetector. When none of them recognizes it, `Ansi` says whether the prefix
+    // has the ANSI escape marker.
+    private static async Task<(Encoding? Encoding, bool Ansi)> DetectEncodingAsync(Stream stream, int length,
+        CancellationToken cancellationToken)
+    {
+        byte[] buffer = ArrayPool<byte>.Shared.Rent(length);
+        try
+        {
+            stream.Position = 0;
+            await stream.ReadExactlyAsync(buffer.AsMemory(0, length), cancellationToken).ConfigureAwait(false);
+            ReadOnlySpan<byte> prefix = buffer.AsSpan(0, length);
+            if (GetBomEncoding(prefix) is { } bom)
+            {
+                return (bom, false);
+            }
+
+            // NULs are valid UTF-8, but mean UTF-16 or UTF-32 without a byte order mark; leave those to
+            // CharsetDetector.
+            if (prefix.IndexOf((byte)0) < 0 && Utf8.IsValid(TrimPartialUtf8(prefix, length < stream.Length)))
+            {
+                return (Encoding.UTF8, false);
+            }
+
+            Encoding? detected = CharsetDetector.DetectFromBytes(buffer, 0, length).Detected?.Encoding;
+            return (detected, detected is null && prefix.IndexOf(AnsiMarker) >= 0);
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
     }
 
-    private bool StreamHasAnsiEsc(Stream stream)
+    // Detects the encoding from the whole stream (Settings.EncodingDetectionBytes is 0).
+    private static (Encoding? Encoding, bool Ansi) DetectEncoding(Stream stream)
     {
-        bool containsStr = false;
-        byte[] streamBytes = new byte[stream.Length];
         stream.Position = 0;
-        stream.ReadExactly(streamBytes);
-        string stringOfStream = Encoding.UTF8.GetString(streamBytes);
-        // Look for the Default foreground color esc sequence
-        // Note, just looking for the ESC[ sequence is not enough as PDF files
-        // include.
-        if (stringOfStream.Contains("\u001B[39;00m"))
+        Encoding? detected = CharsetDetector.DetectFromStream(stream).Detected?.Encoding;
+        return (detected, detected is null && StreamHasAnsiEsc(stream));
+    }
+
+    private static Encoding? GetBomEncoding(ReadOnlySpan<byte> bytes)
+    {
+        // UTF-32 LE comes before UTF-16 LE, whose byte order mark is a prefix of it.
+        foreach (Encoding encoding in s_bomEncodings)
+        {
+            if (bytes.StartsWith(encoding.Preamble))
+            {
+                return encoding;
+            }
+        }
+
+        return null;
+    }
+
+    // Drops a multi-byte UTF-8 sequence the prefix of a longer file may end partway through.
+    private static ReadOnlySpan<byte> TrimPartialUtf8(ReadOnlySpan<byte> bytes, bool truncated)
+    {
+        if (!truncated)
+        {
+            return bytes;
+        }
+
+        int lead = bytes.Length - 1;
+        while (lead >= 0 && lead > bytes.Length - 4 && (bytes[lead] & 0xC0) == 0x80)
         {
-            containsStr = true;
+            lead--;
         }
 
-        return containsStr;
+        return lead >= 0 && bytes[lead] >= 0xC0 ? bytes[..lead] : bytes;
+    }
+
+    // Look for the Default foreground color esc sequence
+    // Note, just looking for the ESC[ sequence is not enough as PDF files
+    // include.
+    private static ReadOnlySpan<byte> AnsiMarker => "\u001B[39;00m"u8;
+
+    private static bool StreamHasAnsiEsc(Stream stream)
+    {
+        ReadOnlySpan<byte> marker = AnsiMarker;
+
+        // Scan in chunks (overlapping by the marker length) so large files aren't read into memory.
+        byte[] buffer = new byte[64 * 1024];
+        int carry = 0;
+        stream.Position = 0;
+        int read;
+        while ((read = stream.Read(buffer, carry, buffer.Length - carry)) > 0)
+        {
+            int end = carry + read;
+            if (buffer.AsSpan(0, end).IndexOf(marker) >= 0)
+            {
+                return true;
+            }
+
+            carry = Math.Min(marker.Length - 1, end);
+            Buffer.BlockCopy(buffer, end - carry, buffer, 0, carry);
+        }
+
+        return false;
     }
 
     /// <summary>
@@ -517,15 +789,27 @@ public class SheetViewModel : ViewModelBase
     /// <returns>True if content type engine was initialized. False otherwise.</returns>
     public async Task<bool> LoadStringAsync(string document, string? contentType)
     {
-        bool retval = false;
-        LogService.TraceMessage();
         if (document == null)
         {
             // TODO: Determine what could cause this and what user-friendly message would be
             throw new ArgumentNullException("Document can't be null.");
         }
 
+        return await LoadDocumentAsync(document, null, contentType).ConfigureAwait(true);
+    }
+
+    /// <summary>
+    ///     Creates and initializes the content type engine from either an in-memory
+    ///     <paramref name="document" /> or a streaming <paramref name="source" />. Takes ownership of
+    ///     <paramref name="source" />; if the engine can't stream, the source is read into memory instead.
+    /// </summary>
+    private async Task<bool> LoadDocumentAsync(string? document, TextFileLineSource? source, string? contentType)
+    {
+        bool retval = false;
+        LogService.TraceMessage();
+
         Reset();
+        _documentSource = source;
         Loading = true;
 
         try
@@ -553,7 +837,22 @@ public class SheetViewModel : ViewModelBase
             ContentEngine.MeasurementContext = MeasurementContext;
             ContentEngine.Encoding = Encoding;
             ContentEngine.SourceFileName = File;
-            retval = await ContentEngine.SetDocumentAsync(document).ConfigureAwait(true);
+            if (source is not null && ContentEngine.SupportsDocumentSource)
+            {
+                retval = await ContentEngine.SetDocumentSourceAsync(source).ConfigureAwait(true);
+            }
+            else
+            {
+                if (source is not null)
+                {
+                    Log.Debug("{cte} can't stream; reading {file} into memory.", ContentEngine.GetType().Name, File);
+                    document = source.ReadToEnd();
+                    _documentSource = null;
+                    source.Dispose();
+                }
+
+                retval = await ContentEngine.SetDocumentAsync(document!).ConfigureAwait(true);
+            }
         }
         catch
         {
@@ -788,7 +1087,11 @@ public class SheetViewModel : ViewModelBase
     ///     Reflows the sheet based on page settings. Caches those settings
     ///     for performance (and for platform independence).
     /// </summary>
-    public async Task ReflowAsync()
+    /// <param name="cancellationToken">
+    ///     Abandons the reflow when a newer one supersedes it; the sheet stays not <see cref="Ready" /> (or
+    ///     ready with the pages published so far) until that one completes.
+    /// </param>
+    public async Task ReflowAsync(CancellationToken cancellationToken = default)
     {
         LogService.TraceMessage();
         if (Loading)
@@ -799,18 +1102,50 @@ public class SheetViewModel : ViewModelBase
 
         Ready = false;
 
-        if (ContentEngine is null)
+        if (ContentEngine is not { } engine)
         {
             LogService.TraceMessage("SheetViewModel.ReflowAsync - ContentEngine is null");
             return;
         }
 
-        _numPages = await ContentEngine.RenderAsync(PrinterResolution, ReflowProgress).ConfigureAwait(false);
+        Volatile.Write(ref _numPages, 0);
+        IsPageCountProvisional = true;
+        using (DiagnosticsPhase phase = WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.ReflowPhase)
+                   .SetContentType(ContentType))
+        {
+            try
+            {
+                int pages = await engine.RenderAsync(PrinterResolution, OnEngineReflowProgress, cancellationToken)
+                    .ConfigureAwait(false);
+                Volatile.Write(ref _numPages, pages);
+                phase.SetPages(pages);
+            }
+            finally
+            {
+                IsPageCountProvisional = false;
+            }
+        }
 
         CheckPrintOutsideHardMargins();
-        Log.Debug("SheetView Model is ready. {n} pages {w}x{h}\"", _numPages, Bounds.Width / 100F,
+        Log.Debug("SheetView Model is ready. {n} pages {w}x{h}\"", Volatile.Read(ref _numPages), Bounds.Width / 100F,
             Bounds.Height / 100F);
         Ready = true;
+        return;
+
+        // Engines that reflow progressively publish pages as they are laid out. Those pages are
+        // paintable right away, so become Ready with a provisional page count that grows until
+        // RenderAsync completes.
+        void OnEngineReflowProgress(object? sender, string msg)
+        {
+            int available = engine.AvailablePages;
+            if (IsPageCountProvisional && available > Volatile.Read(ref _numPages))
+            {
+                Volatile.Write(ref _numPages, available);
+                Ready = true;
+            }
+
+            OnReflowProgress(msg);
+        }
     }
 
     public bool CheckPrintOutsideHardMargins()
@@ -1132,6 +1467,8 @@ public class SheetViewModel : ViewModelBase
         }
 
         int pagesPerSheet = _rows * _cols;
+        using DiagnosticsPhase phase = WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.PaintPhase)
+            .SetContentType(ContentType).SetPages(pagesPerSheet);
         int startPage = (sheetNum - 1) * pagesPerSheet + 1;
         int endPage = startPage + pagesPerSheet - 1;
 
@@ -1160,7 +1497,8 @@ public class SheetViewModel : ViewModelBase
             // Clip content to page boundaries (prevents text overflow in multi-column layouts)
             g.SetClip(new GraphicsRectF(0, 0, w, h));
 
-            if (ContentEngine != null)
+            // While reflow is in progress only pages that have been laid out are painted.
+            if (ContentEngine != null && (!IsPageCountProvisional || pageOnSheet <= Volatile.Read(ref _numPages)))
             {
                 ContentEngine.PaintPage(g, pageOnSheet);
             }
@@ -1218,6 +1556,8 @@ public class SheetViewModel : ViewModelBase
         }
 
         int pagesPerSheet = _rows * _cols;
+        using DiagnosticsPhase phase = WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.PaintPhase)
+            .SetContentType(ContentType).SetPages(pagesPerSheet);
         // 1-based; assume 4-up...
         int startPage = (sheetNum - 1) * pagesPerSheet + 1;
         int endPage = startPage + pagesPerSheet - 1;
@@ -1253,7 +1593,8 @@ public class SheetViewModel : ViewModelBase
                 }
             }
 
-            if (ContentEngine != null)
+            // While reflow is in progress only pages that have been laid out are painted.
+            if (ContentEngine != null && (!IsPageCountProvisional || pageOnSheet <= Volatile.Read(ref _numPages)))
             {
                 ContentEngine.PaintPage(graphicsContext, pageOnSheet);
             }
@@ -34,6 +34,9 @@ public sealed class WindowsSkiaPrintJob : IPrintJob
     private readonly List<(int PageNumber, Action<IGraphicsContext, int> Render)> _pages = [];
     private bool _disposed;
 
+    // 0 (SkiaPageImageRenderer.DefaultMaxConcurrency) once the document's engine supports concurrent painting.
+    private int _maxConcurrency = 1;
+
     public WindowsSkiaPrintJob(PrintPageSetup pageSetup, string documentName)
     {
         _pageSetup = pageSetup;
@@ -50,21 +53,33 @@ public sealed class WindowsSkiaPrintJob : IPrintJob
         _pages.Add((pageNumber, renderPage));
     }
 
-    public Task<PrintJobResult> EndAsync(CancellationToken cancellationToken = default)
+    public void SetConcurrentPainting(bool supported)
+    {
+        _maxConcurrency = supported ? 0 : 1;
+    }
+
+    public async Task<PrintJobResult> EndAsync(CancellationToken cancellationToken = default)
     {
         if (_pages.Count == 0)
         {
-            return Task.FromResult(PrintJobResult.Succeeded(0));
+            return PrintJobResult.Succeeded(0);
         }
 
-        IReadOnlyList<byte[]> pageImages;
+        // Pages are rasterized (concurrently, if the engine allows); the FixedDocument needs all of them first.
+        var pageImages = new List<byte[]>(_pages.Count);
         try
         {
-            pageImages = SkiaPageImageRenderer.RenderPages(_pages, _pageSetup);
+            await foreach (byte[] png in SkiaPageImageRenderer
+                               .RenderPagesAsync(_pages, _pageSetup, maxConcurrency: _maxConcurrency,
+                                   cancellationToken: cancellationToken)
+                               .ConfigureAwait(false))
+            {
+                pageImages.Add(png);
+            }
         }
         catch (Exception ex)
         {
-            return Task.FromResult(PrintJobResult.Failed($"Failed to render document: {ex.Message}"));
+            return PrintJobResult.Failed($"Failed to render document: {ex.Message}");
         }
 
         // Value snapshot for the STA spool thread — a bare reference assignment would race if the
@@ -73,10 +88,10 @@ public sealed class WindowsSkiaPrintJob : IPrintJob
         string documentName = _documentName;
         int sheetCount = _pages.Count;
 
-        return StaTaskRunner.RunAsync(
+        return await StaTaskRunner.RunAsync(
             () => Spool(pageImages, setup, documentName, sheetCount),
             ex => PrintJobResult.Failed(ex.Message),
-            cancellationToken);
+            cancellationToken).ConfigureAwait(false);
     }
 
     /// <summary>
@@ -0,0 +1,106 @@
+using TgColor = Terminal.Gui.Drawing.Color;
+
+namespace WinPrint.TUI.Graphics;
+
+/// <summary>
+///     Least-recently-used cache of page rasters produced by <see cref="PageRenderer" />, so paging back
+///     to a page the preview already showed (or prefetched) doesn't rasterize it again. Bounded by total
+///     pixels rather than entries, since a raster's size follows the viewport and zoom. Thread-safe:
+///     prefetched pages are added from background renders.
+/// </summary>
+public sealed class PageRasterCache
+{
+    /// <summary>Default <see cref="MaxPixels" />: roughly a dozen full-screen rasters.</summary>
+    public const long DefaultMaxPixels = 32_000_000;
+
+    private readonly Dictionary<PageRasterKey, LinkedListNode<(PageRasterKey Key, TgColor[,] Pixels)>> _entries = [];
+    private readonly Lock _lock = new();
+
+    // Most recently used last.
+    private readonly LinkedList<(PageRasterKey Key, TgColor[,] Pixels)> _lru = new();
+    private long _pixels;
+
+    public PageRasterCache(long maxPixels = DefaultMaxPixels)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(maxPixels);
+        MaxPixels = maxPixels;
+    }
+
+    /// <summary>Most pixels kept across all cached rasters.</summary>
+    public long MaxPixels { get; }
+
+    /// <summary>Number of cached rasters.</summary>
+    public int Count
+    {
+        get
+        {
+            lock (_lock)
+            {
+                return _entries.Count;
+            }
+        }
+    }
+
+    /// <summary>Looks up a raster, marking it most recently used.</summary>
+    public bool TryGet(PageRasterKey key, out TgColor[,] pixels)
+    {
+        lock (_lock)
+        {
+            if (_entries.TryGetValue(key, out LinkedListNode<(PageRasterKey Key, TgColor[,] Pixels)>? node))
+            {
+                _lru.Remove(node);
+                _lru.AddLast(node);
+                pixels = node.Value.Pixels;
+                return true;
+            }
+        }
+
+        pixels = null!;
+        return false;
+    }
+
+    /// <summary>
+    ///     Adds (or replaces) a raster, evicting least recently used ones over <see cref="MaxPixels" />. A
+    ///     raster larger than the whole budget isn't kept.
+    /// </summary>
+    public void Add(PageRasterKey key, TgColor[,] pixels)
+    {
+        ArgumentNullException.ThrowIfNull(pixels);
+        long size = (long)pixels.GetLength(0) * pixels.GetLength(1);
+        if (size > MaxPixels)
+        {
+            return;
+        }
+
+        lock (_lock)
+        {
+            RemoveLocked(key);
+            _entries[key] = _lru.AddLast((key, pixels));
+            _pixels += size;
+            while (_pixels > MaxPixels && _lru.First is { } oldest)
+            {
+                RemoveLocked(oldest.Value.Key);
+            }
+        }
+    }
+
+    /// <summary>Drops every raster.</summary>
+    public void Clear()
+    {
+        lock (_lock)
+        {
+            _entries.Clear();
+            _lru.Clear();
+            _pixels = 0;
+        }
+    }
+
+    private void RemoveLocked(PageRasterKey key)
+    {
+        if (_entries.Remove(key, out LinkedListNode<(PageRasterKey Key, TgColor[,] Pixels)>? node))
+        {
+            _lru.Remove(node);
+            _pixels -= (long)node.Value.Pixels.GetLength(0) * node.Value.Pixels.GetLength(1);
+        }
+    }
+}
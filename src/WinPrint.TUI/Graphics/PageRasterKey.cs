@@ -0,0 +1,8 @@
+namespace WinPrint.TUI.Graphics;
+
+/// <summary>
+///     Identifies a page raster in a <see cref="PageRasterCache" />: the zero-based sheet, the viewport it
+///     was fitted to (pixels), the render scale, and the preview's settings version (bumped whenever the
+///     document is re-bound or its settings change, so rasters of an older layout never match).
+/// </summary>
+public readonly record struct PageRasterKey(int Sheet, int Width, int Height, float Scale, int SettingsVersion);
@@ -0,0 +1,16 @@
+using WinPrint.Core.Abstractions;
+
+namespace WinPrint.TUI;
+
+/// <summary>
+///     A file that <see cref="PrintCommand" /> has loaded and reflowed, waiting for its turn to print.
+/// </summary>
+/// <param name="File">The input file, as given on the command line.</param>
+/// <param name="PrintService">The backend the file's settings resolved to.</param>
+/// <param name="Request">The print request, or <c>null</c> when the file produced no active document.</param>
+/// <param name="Plan">The reflowed sheet range.</param>
+internal sealed record PreparedPrintFile(
+    string File,
+    IPrintService PrintService,
+    PrintRequest? Request,
+    PrintPlan Plan);
@@ -3,9 +3,12 @@ using Terminal.Gui.App;
 using Terminal.Gui.Cli;
 using WinPrint.Core;
 using WinPrint.Core.Abstractions;
+using WinPrint.Core.ContentTypeEngines;
 using WinPrint.Core.Helpers;
 using WinPrint.Core.Models;
 using WinPrint.Core.Printing;
+using WinPrint.Core.Services;
+using WinPrint.Core.ViewModels;
 
 namespace WinPrint.TUI;
 
@@ -17,6 +20,15 @@ namespace WinPrint.TUI;
 ///     touching a printer; <c>--pdf &lt;file&gt;</c> writes a PDF file instead of printing (no printer
 ///     involved on any platform; named <c>--pdf</c> because the host owns <c>--output</c> for
 ///     redirecting a command's text output).
+///     <c>--parallel N</c> loads and reflows up to N files at once; rendering and submitting the jobs stay
+///     sequential, one file at a time in argument order, so the spooler and the output see the same order
+///     either way. A file that fails to load cancels the files being prepared alongside it.
+///     Rendered Mermaid diagrams and fetched remote images are kept in the on-disk
+///     <see cref="RenderDiskCache" /> across runs; <c>--no-render-cache</c> turns it off. <c>--stats</c>
+///     appends how long loading, reflowing, painting, PDF rendering and spooling took (see
+///     <see cref="PhaseStatistics" />). <c>--watch</c> follows a single growing file (e.g. a log): each sheet
+///     prints as soon as the text has moved on to the next one, and the last, partly filled sheet prints
+///     when the command is stopped (Ctrl+C).
 /// </summary>
 public sealed class PrintCommand : IHeadlessCliCommand
 {
@@ -46,7 +58,18 @@ public sealed class PrintCommand : IHeadlessCliCommand
             new CommandOptionDescriptor(o.Name, o.Short?.ToString(), o.ValueType, o.Help, false, null)),
         new("what-if", "w", typeof(bool), "Report how many sheets would print, without printing.", false, null),
         new("pdf", null, typeof(string),
-            "Write the output to a PDF file instead of printing (no printer involved).", false, null)
+            "Write the output to a PDF file instead of printing (no printer involved).", false, null),
+        new("parallel", null, typeof(int),
+            "Load and reflow up to N files at once; they still render and print one at a time, in order" +
+            " (default 1).", false, null),
+        new("no-render-cache", null, typeof(bool),
+            "Don't read or write the on-disk cache of rendered diagrams and fetched images.", false, null),
+        new("stats", null, typeof(bool),
+            "After printing, report the time spent loading, reflowing, painting, rendering and spooling.", false,
+            null),
+        new("watch", null, typeof(bool),
+            "Follow one growing file: print each sheet as it fills, and the last one when stopped (Ctrl+C).",
+            false, null)
     ];
 
     /// <inheritdoc />
@@ -75,15 +98,25 @@ public sealed class PrintCommand : IHeadlessCliCommand
         // Fail fast on bad option values (e.g. --to-sheet 2--printer) *before* expanding files or
         // opening a printer — otherwise the first real file prints to the default (PDF) and the
         // mis-parsed token is treated as a second file.
+        int parallel;
         try
         {
             _ = CommandOptionsBinder.ToOptions(options, options.Arguments);
+            parallel = options.CommandOptions.ContainsKey("parallel")
+                ? CommandOptionsBinder.GetIntOrThrow(options, "parallel")
+                : 1;
         }
         catch (InvalidOperationException ex)
         {
             return new CommandResult(CommandStatus.Error, null, "BadOption", ex.Message);
         }
 
+        if (parallel < 1)
+        {
+            return new CommandResult(CommandStatus.Error, null, "BadOption",
+                $"Invalid value for --parallel: '{parallel}' (expected 1 or more).");
+        }
+
         bool whatIf = CommandOptionsBinder.GetFlag(options, "what-if");
         string? pdfPath = CommandOptionsBinder.GetString(options, "pdf");
         if (pdfPath is not null && CommandOptionsBinder.GetString(options, "printer") is not null)
@@ -92,6 +125,13 @@ public sealed class PrintCommand : IHeadlessCliCommand
                 "--pdf writes a file instead of printing; it cannot be combined with --printer.");
         }
 
+        bool watch = CommandOptionsBinder.GetFlag(options, "watch");
+        if (watch && (whatIf || pdfPath is not null))
+        {
+            return new CommandResult(CommandStatus.Error, null, "WatchOutput",
+                "--watch prints sheets as the file grows; it cannot be combined with --what-if or --pdf.");
+        }
+
         IReadOnlyList<string> files;
         try
         {
@@ -110,6 +150,12 @@ public sealed class PrintCommand : IHeadlessCliCommand
                 "--pdf writes one PDF; specify exactly one input file.");
         }
 
+        if (watch && files.Count > 1)
+        {
+            return new CommandResult(CommandStatus.Error, null, "WatchOneFile",
+                "--watch follows one file; specify exactly one input file.");
+        }
+
         // Validate every path exists before printing any of them — avoids partial jobs that hit
         // the default printer then die on a later bogus argument (mis-parsed --printer value).
         foreach (string file in files)
@@ -123,16 +169,26 @@ public sealed class PrintCommand : IHeadlessCliCommand
             }
         }
 
+        RenderDiskCache.Current = CommandOptionsBinder.GetFlag(options, "no-render-cache")
+            ? null
+            : RenderDiskCache.CreateDefault();
+
+        if (files.Count > 1)
+        {
+            // Load the grammars the batch needs while the first file is being read.
+            _ = TextMateCte.WarmUpGrammarsAsync(files, SheetStyles(options));
+        }
+
+        using PhaseStatistics? stats = CommandOptionsBinder.GetFlag(options, "stats") ? new PhaseStatistics() : null;
         var output = new StringBuilder();
-        int totalSheets = 0;
+        int totalSheets;
 
         try
         {
-            foreach (string file in files)
-            {
-                cancellationToken.ThrowIfCancellationRequested();
-                totalSheets += await PrintOneAsync(file, options, whatIf, pdfPath, output).ConfigureAwait(false);
-            }
+            totalSheets = watch
+                ? await WatchAsync(files[0], options, output, cancellationToken).ConfigureAwait(false)
+                : await PrintBatchAsync(files, options, whatIf, pdfPath, parallel, output,
+                    cancellationToken).ConfigureAwait(false);
         }
         catch (Exception ex) when (ex is InvalidOperationException or IOException or UnauthorizedAccessException)
         {
@@ -140,33 +196,229 @@ public sealed class PrintCommand : IHeadlessCliCommand
         }
 
         string verb = whatIf ? "would print" : "printed";
-        output.Append($"{files.Count} file(s) {verb} {totalSheets} sheet(s).");
+        output.AppendLine($"{files.Count} file(s) {verb} {totalSheets} sheet(s).");
+        if (stats is not null)
+        {
+            output.AppendLine().Append(stats.Format());
+        }
+
         return new CommandResult(CommandStatus.Ok, output.ToString().TrimEnd(), null, null);
     }
 
-    // Loads one file, applies the options, and either prints it, writes it to a PDF (--pdf), or
-    // (for --what-if) counts its sheets. Returns the number of sheets printed / that would print,
-    // and appends a per-file line to output.
-    private static async Task<int> PrintOneAsync(
-        string file, CommandRunOptions options, bool whatIf, string? pdfPath, StringBuilder output)
+    // Prints the files in order. Up to `parallel` files are loaded and reflowed ahead of the one being
+    // submitted; rendering and submitting stay sequential. The first failure (or cancellation) cancels the
+    // files being prepared and stops the batch. Returns the total number of sheets printed / that would print.
+    private static async Task<int> PrintBatchAsync(IReadOnlyList<string> files, CommandRunOptions options,
+        bool whatIf, string? pdfPath, int parallel, StringBuilder output, CancellationToken cancellationToken)
+    {
+        using var batchCancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        CancellationToken prepareToken = batchCancellation.Token;
+        var pending = new Queue<Task<PreparedPrintFile>>();
+        int next = 0;
+        int totalSheets = 0;
+
+        try
+        {
+            while (next < files.Count || pending.Count > 0)
+            {
+                while (next < files.Count && pending.Count < parallel)
+                {
+                    string file = files[next++];
+                    pending.Enqueue(Task.Run(async () =>
+                    {
+                        try
+                        {
+                            return await PrepareAsync(file, options, pdfPath, prepareToken).ConfigureAwait(false);
+                        }
+                        catch (Exception ex) when (ex is not OperationCanceledException)
+                        {
+                            // Don't keep loading the files after this one; the batch stops here.
+                            await batchCancellation.CancelAsync().ConfigureAwait(false);
+                            throw;
+                        }
+                    }, prepareToken));
+                }
+
+                cancellationToken.ThrowIfCancellationRequested();
+                PreparedPrintFile prepared;
+                try
+                {
+                    prepared = await pending.Dequeue().ConfigureAwait(false);
+                }
+                catch (OperationCanceledException) when (!cancellationToken.IsCancellationRequested)
+                {
+                    // A file queued after this one failed and canceled the rest; report that failure.
+                    await Task.WhenAll(pending).ConfigureAwait(false);
+                    throw;
+                }
+
+                totalSheets += await SubmitAsync(prepared, whatIf, pdfPath, output, cancellationToken)
+                    .ConfigureAwait(false);
+            }
+        }
+        finally
+        {
+            // Don't leave files loading in the background after the command has returned.
+            await batchCancellation.CancelAsync().ConfigureAwait(false);
+            await ((Task)Task.WhenAll(pending)).ConfigureAwait(ConfigureAwaitOptions.SuppressThrowing);
+        }
+
+        return totalSheets;
+    }
+
+    // --watch: prints the file's full sheets, then follows it as it grows (see FollowAndPrintAsync). Returns
+    // the number of sheets printed.
+    private static async Task<int> WatchAsync(string file, CommandRunOptions options, StringBuilder output,
+        CancellationToken cancellationToken)
+    {
+        (_, IPrintService printService, PrintRequest? request, PrintPlan plan) =
+            await PrepareAsync(file, options, null, cancellationToken).ConfigureAwait(false);
+        if (request is null)
+        {
+            output.AppendLine($"{file}: printed 0 sheet(s).");
+            return 0;
+        }
+
+        using var changed = new SemaphoreSlim(0);
+        using var watcher = new FileWatcher(Path.GetFullPath(file));
+        EventHandler onChanged = (_, _) => changed.Release();
+        watcher.ChangedEvent += onChanged;
+        try
+        {
+            return await FollowAndPrintAsync(printService, request, plan, file, changed.WaitAsync, output,
+                cancellationToken).ConfigureAwait(false);
+        }
+        finally
+        {
+            watcher.ChangedEvent -= onChanged;
+        }
+    }
+
+    // Prints the full sheets of a file prepared for printing, then, each time `changed` completes, prints
+    // the further sheets (as one job) once the text has moved on past them. A file that grew but couldn't
+    // be extended in place (e.g. streamed from disk) is loaded again and continues after the sheets already
+    // printed; one that was truncated or rewritten is printed again from its first sheet. When the command
+    // is cancelled the last, partly filled sheet prints too. Returns the number of sheets printed.
+    internal static async Task<int> FollowAndPrintAsync(IPrintService printService, PrintRequest request,
+        PrintPlan plan, string file, Func<CancellationToken, Task> changed, StringBuilder output,
+        CancellationToken cancellationToken)
+    {
+        SheetViewModel sheet = request.SheetViewModel;
+
+        // Sheets of the current text already printed, and in total across truncations.
+        int printed = 0;
+        int totalSheets = 0;
+        try
+        {
+            while (true)
+            {
+                int count = await PrintSheetsAsync(printService, request, plan, file, printed + 1,
+                    sheet.NumSheets - 1, output, cancellationToken).ConfigureAwait(false);
+                printed += count;
+                totalSheets += count;
+
+                await changed(cancellationToken).ConfigureAwait(false);
+                FollowResult result = await sheet.FollowAsync(cancellationToken).ConfigureAwait(false);
+                if (result is FollowResult.Unchanged or FollowResult.Appended)
+                {
+                    continue;
+                }
+
+                if (!await sheet.LoadFileAsync(file, cancellationToken: cancellationToken).ConfigureAwait(false))
+                {
+                    throw new IOException($"Could not load '{file}'.");
+                }
+
+                plan = await PrintPipeline.PlanAsync(printService, request).ConfigureAwait(false);
+                if (result == FollowResult.Truncated)
+                {
+                    output.AppendLine($"{file}: truncated or rewritten; printing it again from the first sheet.");
+                    printed = 0;
+                }
+            }
+        }
+        catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
+        {
+            // Stopped: the last sheet is as full as it is going to get.
+            totalSheets += await PrintSheetsAsync(printService, request, plan, file, printed + 1,
+                sheet.NumSheets, output, CancellationToken.None).ConfigureAwait(false);
+        }
+
+        return totalSheets;
+    }
+
+    // Prints sheets from..to (1-based, inclusive) of a followed file as one job and appends a line to
+    // output. Returns the number of sheets printed (0 when the range is empty).
+    private static async Task<int> PrintSheetsAsync(IPrintService printService, PrintRequest request,
+        PrintPlan plan, string file, int from, int to, StringBuilder output, CancellationToken cancellationToken)
+    {
+        if (to < from)
+        {
+            return 0;
+        }
+
+        PrintJobResult result = await PrintPipeline.PrintAsync(printService, request,
+            new PrintPlan(plan.ResolvedSetup, to, from, to), cancellationToken).ConfigureAwait(false);
+        if (!result.Success)
+        {
+            throw new InvalidOperationException($"{file}: {result.Error ?? "print failed."}");
+        }
+
+        output.AppendLine($"{file}: printed sheet(s) {from}-{to}.");
+        return result.SheetsPrinted;
+    }
+
+    // Loads one file, applies the options and reflows it for printing.
+    private static async Task<PreparedPrintFile> PrepareAsync(
+        string file, CommandRunOptions options, string? pdfPath, CancellationToken cancellationToken)
     {
         var bound = CommandOptionsBinder.ToOptions(options, [file]);
-        var context = SettingsContext.Create(bound,
-            pdfPath is null ? null : new PdfFilePrintService(pdfPath));
 
-        if (!await context.App.LoadFileAsync(file).ConfigureAwait(false))
+        // Loading selects the sheet for the file's content type and applies the options to it; each file gets
+        // its own copy of the settings so files prepared at the same time don't edit (and reflow) each other's
+        // sheets.
+        var settings = new Settings();
+        settings.CopyPropertiesFrom(WinPrintServices.Current.Settings);
+        var context = SettingsContext.Create(bound, pdfPath is null ? null : new PdfFilePrintService(pdfPath),
+            settings);
+
+        if (!await context.App.LoadFileAsync(file, cancellationToken).ConfigureAwait(false))
         {
             throw new IOException($"Could not load '{file}'.");
         }
 
+        cancellationToken.ThrowIfCancellationRequested();
+        (PrintRequest? request, PrintPlan plan) =
+            await PrintOrchestrator.PrepareAsync(context.PrintService, context).ConfigureAwait(false);
+        return new PreparedPrintFile(file, context.PrintService, request, plan);
+    }
+
+    // The content style (TextMate theme) of the sheet a file of a given content type prints with: the --sheet
+    // one, or the one its content type selects when loaded.
+    private static Func<string, string?> SheetStyles(CommandRunOptions options)
+    {
+        Settings settings = WinPrintServices.Current.Settings;
+        SheetSettings? selected = SheetResolution.FindSheet(settings, CommandOptionsBinder.GetString(options, "sheet"));
+        return contentType => (selected ?? SheetResolution.FindSheet(settings,
+            SheetResolution.ResolveSheetForOpen(settings, contentType).ToString()))?.ContentSettings?.Style;
+    }
+
+    // Either prints a prepared file, writes it to a PDF (--pdf), or (for --what-if) reports its sheet
+    // count. Returns the number of sheets printed / that would print, and appends a per-file line to output.
+    private static async Task<int> SubmitAsync(PreparedPrintFile prepared, bool whatIf, string? pdfPath,
+        StringBuilder output, CancellationToken cancellationToken)
+    {
+        (string file, IPrintService printService, PrintRequest? request, PrintPlan plan) = prepared;
         if (whatIf)
         {
-            PrintPlan plan = await PrintOrchestrator.PlanAsync(context.PrintService, context).ConfigureAwait(false);
             output.AppendLine($"{file}: {plan.SelectedSheets} of {plan.TotalSheets} sheet(s) would print.");
             return plan.SelectedSheets;
         }
 
-        PrintJobResult result = await PrintOrchestrator.PrintAsync(context.PrintService, context).ConfigureAwait(false);
+        PrintJobResult result = request is null
+            ? PrintJobResult.Succeeded(0)
+            : await PrintPipeline.PrintAsync(printService, request, plan, cancellationToken)
+                .ConfigureAwait(false);
         if (!result.Success)
         {
             throw new InvalidOperationException($"{file}: {result.Error ?? "print failed."}");
@@ -33,17 +33,31 @@ public static class PrintOrchestrator
     ///     the engine behind <c>wp print --what-if</c> (count sheets without touching a printer).
     /// </summary>
     public static async Task<PrintPlan> PlanAsync(IPrintService printService, SettingsContext context)
+    {
+        (_, PrintPlan plan) = await PrepareAsync(printService, context).ConfigureAwait(false);
+        return plan;
+    }
+
+    /// <summary>
+    ///     Loads and reflows the active file for printing without starting a job. The request (null when
+    ///     no file is active) can then be printed with
+    ///     <see cref="PrintPipeline.PrintAsync(IPrintService, PrintRequest, PrintPlan, CancellationToken)" />;
+    ///     batch printing prepares several files at once this way and prints them in order.
+    /// </summary>
+    public static async Task<(PrintRequest? Request, PrintPlan Plan)> PrepareAsync(
+        IPrintService printService, SettingsContext context)
     {
         ArgumentNullException.ThrowIfNull(printService);
         ArgumentNullException.ThrowIfNull(context);
 
         if (string.IsNullOrWhiteSpace(context.App.ActiveFile))
         {
-            return new PrintPlan(context.App.CurrentPageSetup, 0, 0, 0);
+            return (null, new PrintPlan(context.App.CurrentPageSetup, 0, 0, 0));
         }
 
         PrintRequest request = await BuildRequestAsync(context).ConfigureAwait(false);
-        return await PrintPipeline.PlanAsync(printService, request).ConfigureAwait(false);
+        PrintPlan plan = await PrintPipeline.PlanAsync(printService, request).ConfigureAwait(false);
+        return (request, plan);
     }
 
     private static async Task<PrintRequest> BuildRequestAsync(SettingsContext context)
@@ -59,9 +59,11 @@ public sealed class SettingsContext
     /// <summary>
     ///     Creates a context over the real loaded settings and applies command-line
     ///     <paramref name="options" /> (sheet, orientation, printer, paper size, print range, file)
-    ///     through the same <see cref="AppViewModel.ApplyOptions" /> path MAUI uses.
+    ///     through the same <see cref="AppViewModel.ApplyOptions" /> path MAUI uses. Pass a copy of the
+    ///     settings as <paramref name="settings" /> to keep the options out of the shared sheet definitions.
     /// </summary>
-    public static SettingsContext Create(Options? options, IPrintService? printService = null)
+    public static SettingsContext Create(Options? options, IPrintService? printService = null,
+        Settings? settings = null)
     {
         var renderer = new PageRenderer();
 
@@ -88,7 +90,7 @@ public sealed class SettingsContext
         // preview honours the same invariant by painting with Skia, the engine that measured it.)
         sheetVM.MeasurementContext = renderer.CreateMeasurementContext();
 
-        var app = new AppViewModel(pageSetup, sheetVM);
+        var app = new AppViewModel(pageSetup, sheetVM, settings);
         app.LoadSheets();
 
         // Restore the remembered ("sticky") printer / paper size into the page setup BEFORE applying
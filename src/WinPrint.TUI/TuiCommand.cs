@@ -50,6 +50,8 @@ public sealed class TuiCommand : IViewerCommand
             new CommandOptionDescriptor(o.Name, o.Short?.ToString(), o.ValueType, o.Help, false, null)),
         new("view", null, typeof(string), "Show a single catalogued view instead of the full app.",
             false, null),
+        new("watch", null, typeof(bool),
+            "Follow the file as it grows: lay out appended lines and keep the last sheet in view.", false, null),
         new("width", null, typeof(int), "Grid width in cells for --cat (0 = terminal width).", false, null),
         new("height", null, typeof(int), "Grid height in cells for --cat (0 = terminal height).", false, null)
     ];
@@ -169,8 +171,10 @@ public sealed class TuiCommand : IViewerCommand
             ? FileArgumentExpander.ExpandSingle(options.Arguments)
             : null;
 
-        return new MainView(context: SettingsContext.Create(
-            CommandOptionsBinder.ToOptions(options, file is null ? null : [file])));
+        SettingsContext context =
+            SettingsContext.Create(CommandOptionsBinder.ToOptions(options, file is null ? null : [file]));
+        context.App.Follow = CommandOptionsBinder.GetFlag(options, "watch");
+        return new MainView(context: context);
     }
 
     // --width/--height for --cat; fall back to the real terminal size, then a sane default.
@@ -113,12 +113,25 @@ public sealed class MainView : View
             }
         };
 
+        // Set once PagesAvailable has bound the preview during the current reflow, so the user may
+        // already have paged ahead; completing that reflow must not send them back to the first page.
+        var progressivelyBound = false;
+
         // ReflowCompleted/PreviewInvalidated may fire from background threads; marshal to UI.
         app.ReflowCompleted += (_, _) =>
         {
             GetApp()?.Invoke(() =>
             {
-                Preview.Bind(context.SheetVM, app.TotalPages, context.Renderer.Dpi);
+                if (progressivelyBound)
+                {
+                    progressivelyBound = false;
+                    Preview.CompleteReflow(app.TotalPages);
+                }
+                else
+                {
+                    Preview.Bind(context.SheetVM, app.TotalPages, context.Renderer.Dpi);
+                }
+
                 Title = string.IsNullOrEmpty(app.ActiveFile)
                     ? "<no file>"
                     : Path.GetFileName(app.ActiveFile);
@@ -126,6 +139,39 @@ public sealed class MainView : View
         };
         app.PreviewInvalidated += (_, _) => { GetApp()?.Invoke(() => { Preview.Refresh(); }); };
 
+        // Progressive reflow: show the first sheets while the rest of the file is still being laid out.
+        app.PagesAvailable += (_, _) =>
+        {
+            GetApp()?.Invoke(() =>
+            {
+                if (!progressivelyBound)
+                {
+                    progressivelyBound = true;
+                    Preview.Bind(context.SheetVM, app.TotalPages, context.Renderer.Dpi);
+                }
+                else
+                {
+                    Preview.UpdateTotalPages(app.TotalPages);
+                }
+            });
+        };
+
+        // Follow mode (--watch): lines appended to the file were laid out after the existing sheets.
+        app.DocumentAppended += (_, _) =>
+        {
+            GetApp()?.Invoke(() =>
+            {
+                if (Preview.TotalPages == 0)
+                {
+                    Preview.Bind(context.SheetVM, app.TotalPages, context.Renderer.Dpi);
+                }
+                else
+                {
+                    Preview.ShowAppended(app.TotalPages);
+                }
+            });
+        };
+
         // The HeaderFooterEditor mutates the model directly (via PushFromChildren) rather than
         // raising ValueChanged. Changes propagate through Model.PropertyChanged → HeaderFooterVM →
         // SheetVM.SettingsChanged. Subscribe here to trigger preview updates for that path.
@@ -18,6 +18,12 @@ namespace WinPrint.TUI.Views;
 ///     raster <see cref="ImageView" />. Supports page navigation (PgUp/PgDn) and debounced
 ///     re-render on resize or settings changes.
 ///     <para>
+///         Rendered pages are kept in a <see cref="PageRasterCache" />, so paging back to a page already
+///         seen shows it immediately, and the pages either side of the current one are prefetched in the
+///         background. Renders run one at a time (content engines don't paint concurrently); moving to
+///         another page cancels renders that haven't started yet.
+///     </para>
+///     <para>
 ///         Terminal.Gui's raster output (PR #5460) handles sixel encoding, clipping, Z-order, and
 ///         invalidation natively — no manual pixel-budget or suspend/resume workarounds needed.
 ///     </para>
@@ -31,11 +37,15 @@ public sealed class PreviewPane : View
     private static readonly TgColor s_canvasBackgroundColor = new(224, 224, 224);
     private static readonly TgColor s_canvasForegroundColor = new(0, 0);
 
+    private readonly PageRasterCache _rasters = new();
+    private readonly SemaphoreSlim _renderGate = new(1, 1);
     private SheetViewModel? _sheetVm;
     private PageRenderer? _renderer;
     private int _currentPage;
     private CancellationTokenSource? _debounceCts;
+    private CancellationTokenSource? _renderCts;
     private int _renderVersion;
+    private int _settingsVersion;
 
     /// <summary>Creates the preview pane.</summary>
     public PreviewPane()
@@ -142,7 +152,11 @@ public sealed class PreviewPane : View
             if (clamped != _currentPage)
             {
                 _currentPage = clamped;
-                RequestRender();
+                // A page that is already rendered (seen or prefetched) is shown without the debounce.
+                if (!TryShowCachedPage())
+                {
+                    RequestRender();
+                }
             }
         }
     }
@@ -159,6 +173,7 @@ public sealed class PreviewPane : View
             if (_renderer is not null)
             {
                 _renderer.Dpi = value;
+                InvalidateRasters();
                 RequestRender();
             }
         }
@@ -174,12 +189,59 @@ public sealed class PreviewPane : View
         TotalPages = totalPages;
         _currentPage = 0;
         _renderer = new PageRenderer(dpi);
+        InvalidateRasters();
+        RenderCurrentPage();
+    }
+
+    /// <summary>
+    ///     Updates the page count while a progressive reflow is still laying out pages, keeping the
+    ///     current page. Re-renders only if the current page has just become available.
+    /// </summary>
+    public void UpdateTotalPages(int totalPages)
+    {
+        bool wasAvailable = _currentPage < TotalPages;
+        TotalPages = totalPages;
+        if (!wasAvailable && _currentPage < TotalPages)
+        {
+            RequestRender();
+        }
+    }
+
+    /// <summary>
+    ///     Sets the final page count once a progressive reflow completes. The page the user paged to while
+    ///     pages were still being laid out is kept (clamped to the final count), and every cached page is
+    ///     dropped, since headers and footers showing the page count change.
+    /// </summary>
+    public void CompleteReflow(int totalPages)
+    {
+        TotalPages = totalPages;
+        _currentPage = Math.Clamp(_currentPage, 0, Math.Max(0, TotalPages - 1));
+        InvalidateRasters();
         RenderCurrentPage();
     }
 
-    /// <summary>Forces an immediate re-render of the current page.</summary>
+    /// <summary>
+    ///     Updates the page count after lines were appended to a followed file. Every cached page is dropped,
+    ///     since headers and footers showing the page count change; a preview on the last page moves to the new
+    ///     last page so the end of the file stays in view.
+    /// </summary>
+    public void ShowAppended(int totalPages)
+    {
+        bool onLastPage = _currentPage >= TotalPages - 1;
+        TotalPages = totalPages;
+        if (onLastPage)
+        {
+            _currentPage = Math.Max(0, TotalPages - 1);
+        }
+
+        InvalidateRasters();
+        RequestRender();
+    }
+
+    /// <summary>Forces an immediate re-render of the current page, discarding every cached page.</summary>
     public void Refresh()
     {
+        InvalidateRasters();
         RenderCurrentPage();
     }
 
@@ -402,6 +464,50 @@ public sealed class PreviewPane : View
         }, token, TaskContinuationOptions.OnlyOnRanToCompletion, TaskScheduler.Default);
     }
 
+    // Rasters of the previous layout or settings can never be shown again.
+    private void InvalidateRasters()
+    {
+        Interlocked.Increment(ref _settingsVersion);
+        _rasters.Clear();
+    }
+
+    private PageRasterKey GetRasterKey(int page)
+    {
+        (int width, int height) = GetPreviewPixelSize();
+        return new PageRasterKey(page, width, height, GetRenderScale(width, height),
+            Volatile.Read(ref _settingsVersion));
+    }
+
+    private bool TryShowCachedPage()
+    {
+        if (_sheetVm is null || _renderer is null)
+        {
+            return false;
+        }
+
+        try
+        {
+            PageRasterKey key = GetRasterKey(_currentPage);
+            if (!_rasters.TryGet(key, out TgColor[,] pixels))
+            {
+                return false;
+            }
+
+            // Supersede any render or debounce still pending for the page we left.
+            _debounceCts?.Cancel();
+            Interlocked.Increment(ref _renderVersion);
+            CancellationToken token = RestartRenders();
+            SetRenderingVisible(false);
+            ShowPixels(pixels);
+            Prefetch(_sheetVm, _renderer, key, token);
+            return true;
+        }
+        catch (InvalidOperationException)
+        {
+            return false;
+        }
+    }
+
     private void RenderCurrentPage()
     {
         if (_sheetVm is null || _renderer is null)
@@ -411,16 +517,12 @@ public sealed class PreviewPane : View
 
         SheetViewModel sheetVm = _sheetVm;
         PageRenderer renderer = _renderer;
-        int page = _currentPage;
         int version = Interlocked.Increment(ref _renderVersion);
-        int width;
-        int height;
-        float renderScale;
+        PageRasterKey key;
 
         try
         {
-            (width, height) = GetPreviewPixelSize();
-            renderScale = GetRenderScale(width, height);
+            key = GetRasterKey(_currentPage);
 
             // Only show the spinner when there is nothing to display yet (initial load). For a refine
             // re-render (zoom settle, settings change, page nav) keep the current image visible and swap
@@ -433,21 +535,78 @@ public sealed class PreviewPane : View
             return;
         }
 
-        Task.Run(() => renderer.RenderPageForViewport(sheetVm, page, width, height, renderScale))
+        CancellationToken token = RestartRenders();
+        Task.Run(() => RenderRasterAsync(sheetVm, renderer, key, token), token)
             .ContinueWith(task =>
             {
                 IApplication? app = GetApp();
                 if (app is null || !app.Initialized)
                 {
-                    CompleteRender(task, version);
+                    CompleteRender(task, version, sheetVm, renderer, key, token);
                     return;
                 }
 
-                app.Invoke(() => CompleteRender(task, version));
+                app.Invoke(() => CompleteRender(task, version, sheetVm, renderer, key, token));
             }, TaskScheduler.Default);
     }
 
-    private void CompleteRender(Task<TgColor[,]> task, int version)
+    // Cancels renders queued for the previous page (a render already running finishes and is cached).
+    private CancellationToken RestartRenders()
+    {
+        _renderCts?.Cancel();
+        _renderCts = new CancellationTokenSource();
+        return _renderCts.Token;
+    }
+
+    private async Task<TgColor[,]> RenderRasterAsync(SheetViewModel sheetVm, PageRenderer renderer,
+        PageRasterKey key, CancellationToken token)
+    {
+        await _renderGate.WaitAsync(token).ConfigureAwait(false);
+        try
+        {
+            // A prefetch may have rendered this page while we waited.
+            if (_rasters.TryGet(key, out TgColor[,] cached))
+            {
+                return cached;
+            }
+
+            token.ThrowIfCancellationRequested();
+            TgColor[,] pixels = renderer.RenderPageForViewport(sheetVm, key.Sheet, key.Width, key.Height, key.Scale);
+
+            // Rasters of a layout or settings invalidated while this one rendered could never be shown.
+            if (key.SettingsVersion == Volatile.Read(ref _settingsVersion))
+            {
+                _rasters.Add(key, pixels);
+            }
+
+            return pixels;
+        }
+        finally
+        {
+            _renderGate.Release();
+        }
+    }
+
+    // Renders the next and previous pages into the cache, after the current one, unless already cached.
+    private void Prefetch(SheetViewModel sheetVm, PageRenderer renderer, PageRasterKey current,
+        CancellationToken token)
+    {
+        foreach (int page in new[] { current.Sheet + 1, current.Sheet - 1 })
+        {
+            PageRasterKey key = current with { Sheet = page };
+            if (page < 0 || page >= TotalPages || _rasters.TryGet(key, out _))
+            {
+                continue;
+            }
+
+            _ = Task.Run(() => RenderRasterAsync(sheetVm, renderer, key, token), token)
+                .ContinueWith(t => _ = t.Exception, CancellationToken.None,
+                    TaskContinuationOptions.OnlyOnFaulted, TaskScheduler.Default);
+        }
+    }
+
+    private void CompleteRender(Task<TgColor[,]> task, int version, SheetViewModel sheetVm, PageRenderer renderer,
+        PageRasterKey key, CancellationToken token)
     {
         if (version != _renderVersion)
         {
@@ -467,7 +626,13 @@ public sealed class PreviewPane : View
             return;
         }
 
-        Image.Image = task.Result;
+        ShowPixels(task.Result);
+        Prefetch(sheetVm, renderer, key, token);
+    }
+
+    private void ShowPixels(TgColor[,] pixels)
+    {
+        Image.Image = pixels;
         Image.SetNeedsDraw();
         PageLabel.Visible = false;
     }
@@ -428,7 +428,7 @@ namespace libvt100
          }
       }
 
-      protected override void OnCharacters( char[] _characters )
+      protected override void OnCharacters( ReadOnlySpan<char> _characters )
       {
          foreach ( IAnsiDecoderClient client in m_listeners )
          {
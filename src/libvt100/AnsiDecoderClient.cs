@@ -14,11 +14,11 @@ namespace libvt100
         public delegate void CharactersDelegate ( AnsiDecoderClient _client, char[] _chars );
         public event CharactersDelegate Characters;
         
-        void IAnsiDecoderClient.Characters ( IAnsiDecoder _sender, char[] _chars )
+        void IAnsiDecoderClient.Characters ( IAnsiDecoder _sender, ReadOnlySpan<char> _chars )
         {
             if ( Characters != null )
             {
-                Characters ( this, _chars );
+                Characters ( this, _chars.ToArray() );
             }
         }
         
@@ -33,9 +33,35 @@ namespace libvt100 {
         /// A line of Ansi encoded text. 
         /// Helps keep track of which lines are 'real' and thus get a printed line number
         /// and which are the result of wrapping.
+        /// The characters live in a growable buffer (Text is materialized on demand and cached) and
+        /// the Runs are kept contiguous and ordered by Start, so appends are amortized O(1) and a column
+        /// is found with a binary search over the runs.
         /// </summary>
         public class Line {
-            public string Text { get; set; } = string.Empty;
+            private char[] _chars = Array.Empty<char>();
+            private int _length;
+            private string _text = string.Empty;
+
+            public string Text {
+                get {
+                    return _text ??= new string(_chars, 0, _length);
+                }
+                set {
+                    _text = value ?? string.Empty;
+                    _chars = _text.ToCharArray();
+                    _length = _text.Length;
+                }
+            }
+
+            /// <summary>
+            /// The number of characters in the line (the length of Text).
+            /// </summary>
+            public int Length {
+                get {
+                    return _length;
+                }
+            }
+
             /// <summary>
             /// The line number that will be printed next to the line.
             /// If 0 the line exists because of line wrapping and no number will be printed.
@@ -56,77 +82,99 @@ namespace libvt100 {
                 }
                 set {
                     // See if this makes the line longer
-                    if (col >= Text.Length) {
-                        // TODO: Modify Character to support IsEqual and extend run
-
+                    if (col >= _length) {
                         // Pad with spaces
-                        if (col - Text.Length > 0) {
-                            Runs.Add(new Run() { Start = Runs.Sum(r => r.Length), Length = col - Text.Length });
-                            Text += new string(' ', col - Text.Length);
+                        if (col > _length) {
+                            Runs.Add(new Run() { Start = RunsEnd, Length = col - _length });
+                            Append(' ', col - _length);
                         }
 
                         // Start a new run
                         Runs.Add(new Run() { Attributes = value.Attributes, Length = 1, Start = col });
-                        Text += value.Char;
+                        Append(value.Char, 1);
                     }
                     else {
                         // Setting an existing value
                         CheckColumn(col);
-                        var run = 0;
-                        for (; run < Runs.Count && (col - Runs.ToArray()[0..(run + 1)].Sum(r => r.Length)) >= 0; run++) {
+                        var run = IndexOfRun(col);
+                        if (run < 0) {
+                            throw new ArgumentOutOfRangeException($"No run holds column {col} ({Runs.Count} runs)");
                         }
 
-                        if (run > Runs.Count) {
-                            throw new ArgumentOutOfRangeException($"The run ({run}) is larger than the number of runs ({Runs.Count})");
-                        }
+                        _chars[col] = value.Char;
+                        _text = null;
 
-                        if (Runs[run].Length == 1) {
+                        var existing = Runs[run];
+                        if (existing.Length == 1) {
                             // Just overwrite it
-                            Runs[run].Attributes = value.Attributes;
-                            var sb = new StringBuilder(Text);
-                            sb[col] = value.Char;
-                            Text = sb.ToString();
+                            existing.Attributes = value.Attributes;
                         }
                         else {
                             var newRun = new Run() { Attributes = value.Attributes, Length = 1, Start = col };
-                            if (col == 0) {
-                                Runs[run].Length -= 1;
-                                Runs[run].Start++;
-                                Runs.Insert(0, newRun);
+                            if (col == existing.Start) {
+                                existing.Start++;
+                                existing.Length--;
+                                Runs.Insert(run, newRun);
                             }
                             else {
                                 // Need to split this run into two and insert a new one between
-                                var splitStart = Runs.ToArray()[0..(run + 1)].Sum(r => r.Length) - col;
-                                var splitRun = new Run() { Attributes = Runs[run].Attributes, Length = splitStart - 1, Start = col + 1 };
-                                Runs[run].Length -= splitStart;
+                                var tail = existing.Start + existing.Length - col - 1;
+                                existing.Length = col - existing.Start;
                                 Runs.Insert(run + 1, newRun);
-                                Runs.Insert(run + 2, splitRun);
+                                if (tail > 0) {
+                                    Runs.Insert(run + 2, new Run() { Attributes = existing.Attributes, Length = tail, Start = col + 1, HasTab = existing.HasTab });
+                                }
                             }
-                            // Overwrite the char
-                            var sb = new StringBuilder(Text);
-                            sb[col] = value.Char;
-                            Text = sb.ToString();
-
                         }
                     }
                 }
             }
 
+            /// <summary>
+            /// The column just past the last run (where the next run starts).
+            /// </summary>
+            internal int RunsEnd {
+                get {
+                    if (Runs.Count == 0) {
+                        return 0;
+                    }
+                    var last = Runs[^1];
+                    return last.Start + last.Length;
+                }
+            }
+
+            /// <summary>
+            /// Appends a character to the last run, starting a run with the given attributes first if
+            /// there is none, the last one holds a tab, or (when startRun is set) the attributes differ.
+            /// </summary>
+            internal void Append(char ch, GraphicAttributes attributes, bool startRun) {
+                if (Runs.Count == 0 || Runs[^1].HasTab || (startRun && !Runs[^1].Attributes.Equals(attributes))) {
+                    Runs.Add(new Run() { Attributes = attributes, Start = RunsEnd });
+                }
+                AppendToLastRun(ch);
+            }
+
+            /// <summary>
+            /// Appends a character to the last run, which must exist.
+            /// </summary>
+            internal void AppendToLastRun(char ch) {
+                Append(ch, 1);
+                Runs[^1].Length++;
+            }
+
             /// <summary>
             /// Returns the Run that holds the chracter at column col.
             /// </summary>
             /// <param name="col"></param>
             /// <returns></returns>
             public Run RunFromColumn(int col) {
-                if (Runs.Count == 0 || col >= Text.Length) {
+                if (Runs.Count == 0 || col >= _length) {
                     return null;
                 }
 
-                var run = 0;
-                for (; run < Runs.Count && (col - Runs.ToArray()[0..(run + 1)].Sum(r => r.Length)) >= 0; run++) ;
-
-                if (run >= Runs.Count) {
-                    throw new ArgumentOutOfRangeException($"The run ({run}) is larger than the number of runs ({Runs.Count})");
+                var run = IndexOfRun(col);
+                if (run < 0) {
+                    throw new ArgumentOutOfRangeException($"No run holds column {col} ({Runs.Count} runs)");
                 }
 
                 return Runs[run];
@@ -135,29 +183,110 @@ namespace libvt100 {
             public Character CharacterFromColumn(int col) {
                 var run = RunFromColumn(col);
                 if (run != null) {
-                    return new Character((col < Text.Length) ? Text[col] : (char)0) { Attributes = run.Attributes };
+                    return new Character((col < _length) ? _chars[col] : (char)0) { Attributes = run.Attributes };
                 }
                 return null;
             }
 
             protected void CheckColumn(int column) {
-                if (column >= Text.Length) {
-                    throw new ArgumentOutOfRangeException($"The column number ({column}) is larger than the width ({Text.Length})");
+                if (column >= _length) {
+                    throw new ArgumentOutOfRangeException($"The column number ({column}) is larger than the width ({_length})");
+                }
+            }
+
+            // Binary search for the run holding col: the last run starting at or before it, provided it
+            // reaches col (runs are contiguous and ordered by Start). -1 if there is none.
+            private int IndexOfRun(int col) {
+                int lo = 0;
+                int hi = Runs.Count - 1;
+                int found = -1;
+                while (lo <= hi) {
+                    int mid = lo + ((hi - lo) >> 1);
+                    if (Runs[mid].Start <= col) {
+                        found = mid;
+                        lo = mid + 1;
+                    }
+                    else {
+                        hi = mid - 1;
+                    }
+                }
+
+                if (found >= 0 && col >= Runs[found].Start + Runs[found].Length) {
+                    return -1;
+                }
+                return found;
+            }
+
+            private void Append(char ch, int count) {
+                if (_length + count > _chars.Length) {
+                    Array.Resize(ref _chars, Math.Max(_length + count, Math.Max(16, _chars.Length * 2)));
                 }
+                _chars.AsSpan(_length, count).Fill(ch);
+                _length += count;
+                _text = null;
             }
         }
 
         /// <summary>
-        /// All of the lines in the doc (wrapped).
+        /// Decoder-independent state of a DynamicScreen at the start of an empty line, from which
+        /// decoding can be resumed with a new screen (see CreateCheckpoint).
+        /// </summary>
+        public sealed class Checkpoint {
+            internal Checkpoint(int line, int lineNumber, int numLines, GraphicAttributes attributes,
+                Point savedCursorPosition, bool showCursor, bool newRun) {
+                Line = line;
+                LineNumber = lineNumber;
+                NumLines = numLines;
+                Attributes = attributes;
+                SavedCursorPosition = savedCursorPosition;
+                ShowCursor = showCursor;
+                NewRun = newRun;
+            }
+
+            /// <summary>
+            /// Index of the (empty) line the cursor is on, counting released lines.
+            /// </summary>
+            public int Line { get; }
+            internal int LineNumber { get; }
+            internal int NumLines { get; }
+            internal GraphicAttributes Attributes { get; }
+            internal Point SavedCursorPosition { get; }
+            internal bool ShowCursor { get; }
+            internal bool NewRun { get; }
+        }
+
+        /// <summary>
+        /// All of the lines in the doc (wrapped), less any that were released (see ReleaseLines).
         /// </summary>
         public List<Line> Lines { get; set; } = new List<Line>() { new Line() { LineNumber = 1 } };
 
+        /// <summary>
+        /// Number of lines released from the top of Lines; Lines[0] is line FirstLine of the doc.
+        /// </summary>
+        public int FirstLine { get; private set; }
+
         /// <summary>
         /// Number of lines with line #s in document
         /// </summary>
         public int NumLines { get; set; } = 1;
 
+        /// <summary>
+        /// How many lines above the last line the cursor may move to (up, to a row, or back to a saved
+        /// position); a movement further up stops at that line. Unlimited by default. A screen that
+        /// releases lines (see ReleaseLines) limits it, so where the cursor goes depends on the input
+        /// alone and not on which lines happen to be held.
+        /// </summary>
+        public int ScrollbackLines { get; set; } = int.MaxValue;
+
+        /// <summary>
+        /// The topmost line (counting released lines) the cursor has been on since the screen was
+        /// created or ResetTopmostCursorLine was last called.
+        /// </summary>
+        public int TopmostCursorLine { get; private set; }
+
         protected Point _cursorPosition;
+
+        // Y counts released lines.
         protected Point _savedCursorPosition;
         protected bool _showCursor;
         //protected Character[,] m_screen;
@@ -186,6 +315,7 @@ namespace libvt100 {
             }
             set {
                 if (_cursorPosition != value) {
+                    TopmostCursorLine = Math.Min(TopmostCursorLine, FirstLine + value.Y);
                     ////Add a new line if needed.
                     //if (value.Y >= Lines.Count)
                     //{
@@ -241,6 +371,66 @@ namespace libvt100 {
             _currentAttributes.Reset();
         }
 
+        /// <summary>
+        /// Creates a screen that continues from _checkpoint: it holds just the checkpoint's empty
+        /// line, and decoding the input that followed the checkpoint produces the same lines.
+        /// </summary>
+        public DynamicScreen(int width, Checkpoint _checkpoint) : this(width) {
+            FirstLine = _checkpoint.Line;
+            TopmostCursorLine = FirstLine;
+            Lines = new List<Line>() { new Line() { LineNumber = _checkpoint.LineNumber } };
+            NumLines = _checkpoint.NumLines;
+            _currentAttributes = _checkpoint.Attributes;
+            _savedCursorPosition = _checkpoint.SavedCursorPosition;
+            _showCursor = _checkpoint.ShowCursor;
+            _newRun = _checkpoint.NewRun;
+        }
+
+        /// <summary>
+        /// Captures the state needed to resume decoding here, or returns null unless the cursor is
+        /// at the start of the last line and that line is empty (e.g. right after a \n).
+        /// </summary>
+        public Checkpoint CreateCheckpoint() {
+            if (_cursorPosition.X != 0 || _cursorPosition.Y != Lines.Count - 1
+                || Lines[^1].Length != 0 || Lines[^1].Runs.Count != 0 || _nextNewLineIsContinuation) {
+                return null;
+            }
+
+            return new Checkpoint(FirstLine + _cursorPosition.Y, Lines[^1].LineNumber, NumLines, _currentAttributes,
+                _savedCursorPosition, _showCursor, _newRun);
+        }
+
+        /// <summary>
+        /// Starts tracking TopmostCursorLine again from the cursor's line.
+        /// </summary>
+        public void ResetTopmostCursorLine() {
+            TopmostCursorLine = FirstLine + _cursorPosition.Y;
+        }
+
+        // The topmost line (counting released lines) the cursor may move to.
+        private int TopLine => ScrollbackLines == int.MaxValue
+            ? FirstLine
+            : Math.Max(FirstLine, FirstLine + Lines.Count - 1 - ScrollbackLines);
+
+        /// <summary>
+        /// Drops up to _count lines from the top of Lines (e.g. lines that have been printed), so
+        /// memory is bounded by the lines still held rather than the doc. The cursor's line and the
+        /// lines after it are always kept. Rows, including the cursor's, shift up by the number of
+        /// lines released; the cursor can no longer move above the first line held.
+        /// </summary>
+        /// <returns>The number of lines released.</returns>
+        public int ReleaseLines(int _count) {
+            _count = Math.Min(_count, Math.Min(_cursorPosition.Y, Lines.Count - 1));
+            if (_count <= 0) {
+                return 0;
+            }
+
+            Lines.RemoveRange(0, _count);
+            FirstLine += _count;
+            _cursorPosition.Y -= _count;
+            return _count;
+        }
+
         protected void CheckColumnRow(int column, int row) {
             CheckColumn(column);
             CheckRow(row);
@@ -281,9 +471,13 @@ namespace libvt100 {
         }
 
         public void CursorUp() {
-            if (_cursorPosition.Y - 1 < 0) {
+            if (_cursorPosition.Y - 1 < 0 && FirstLine == 0) {
                 throw new Exception("Can not move further up!");
             }
+            if (FirstLine + _cursorPosition.Y - 1 < TopLine) {
+                // The line above was released, or is further up than the cursor may move.
+                return;
+            }
             CursorPosition = new Point(_cursorPosition.X, _cursorPosition.Y - 1);
         }
 
@@ -320,7 +514,7 @@ namespace libvt100 {
         }
 
         #region IAnsiDecoderClient Implementation
-        void IAnsiDecoderClient.Characters(IAnsiDecoder _sender, char[] _chars) {
+        void IAnsiDecoderClient.Characters(IAnsiDecoder _sender, ReadOnlySpan<char> _chars) {
             foreach (char ch in _chars) {
                 if (ch == '\n') {
                     if (CursorPosition.Y < Lines.Count || !_nextNewLineIsContinuation) {
@@ -347,21 +541,21 @@ namespace libvt100 {
                         Lines.Add(new Line() { LineNumber = (_nextNewLineIsContinuation ? 0 : ++NumLines) });
                     }
 
-                    if (this[CursorPosition.Y].Runs.Count == 0
+                    Line line = this[CursorPosition.Y];
+                    if (line.Runs.Count == 0
                         || _newRun
-                        || !this[CursorPosition.Y].Runs[^1].HasTab) {
-                        int start = this[CursorPosition.Y].Runs.Count == 0 ? 0 : Lines[CursorPosition.Y].Runs.Sum(r => r.Length);
-                        Lines[CursorPosition.Y].Runs.Add(new Run() { Attributes = _currentAttributes, Start = start, HasTab = true });
+                        || !line.Runs[^1].HasTab) {
+                        int start = line.RunsEnd;
+                        line.Runs.Add(new Run() { Attributes = _currentAttributes, Start = start, HasTab = true });
 
                         // how many columns to the right is the next tabstop or right margin?
                         colsToNextTabStop = TabSpaces - (start % TabSpaces);
                     }
                     else {
-                        colsToNextTabStop = TabSpaces - this[CursorPosition.Y].Runs[^1].Length;
+                        colsToNextTabStop = TabSpaces - line.Runs[^1].Length;
                     }
                     while (colsToNextTabStop > 0) {
-                        this[CursorPosition.Y].Text += " "; ;
-                        this[CursorPosition.Y].Runs[^1].Length++;
+                        line.AppendToLastRun(' ');
                         colsToNextTabStop--;
 
                         if (CursorPosition.X + 1 >= Width) {
@@ -385,14 +579,9 @@ namespace libvt100 {
                         Lines.Add(new Line() { LineNumber = (_nextNewLineIsContinuation ? 0 : ++NumLines) });
                     }
 
-                    if (this[CursorPosition.Y].Runs.Count == 0 || _newRun) {
-                        int start = this[CursorPosition.Y].Runs.Count == 0 ? 0 : Lines[CursorPosition.Y].Runs.Sum(r => r.Length);
-                        Lines[CursorPosition.Y].Runs.Add(new Run() { Attributes = _currentAttributes, Start = start });
-                        _newRun = false;
-                    }
-
-                    this[CursorPosition.Y].Text += ch;
-                    this[CursorPosition.Y].Runs[^1].Length++;
+                    // Coalesces into the current run unless an SGR sequence changed the attributes.
+                    this[CursorPosition.Y].Append(ch, _currentAttributes, _newRun);
+                    _newRun = false;
 
                     if (CursorPosition.X + 1 >= Width) {
                         // Wrap
@@ -408,11 +597,11 @@ namespace libvt100 {
         }
 
         void IAnsiDecoderClient.SaveCursor(IAnsiDecoder _sernder) {
-            _savedCursorPosition = _cursorPosition;
+            _savedCursorPosition = new Point(_cursorPosition.X, FirstLine + _cursorPosition.Y);
         }
 
         void IAnsiDecoderClient.RestoreCursor(IAnsiDecoder _sender) {
-            CursorPosition = _savedCursorPosition;
+            CursorPosition = new Point(_savedCursorPosition.X, Math.Max(_savedCursorPosition.Y, TopLine) - FirstLine);
         }
 
         Size IAnsiDecoderClient.GetSize(IAnsiDecoder _sender) {
@@ -474,9 +663,12 @@ namespace libvt100 {
         }
 
         void IAnsiDecoderClient.MoveCursorTo(IAnsiDecoder _sender, Point _position) {
-            CheckColumnRow(_position.X, _position.Y);
+            // Rows count from the first line of the doc, released or not; one further up than the cursor
+            // may move stops at the topmost line it may move to.
+            int row = Math.Max(_position.Y, TopLine) - FirstLine;
+            CheckColumnRow(_position.X, row);
 
-            CursorPosition = _position;
+            CursorPosition = new Point(_position.X, row);
         }
 
         void IAnsiDecoderClient.ClearScreen(IAnsiDecoder _sender, ClearDirection _direction) {
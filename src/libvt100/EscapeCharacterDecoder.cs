@@ -3,6 +3,7 @@
 // http://www.apache.org/licenses/LICENSE-2.0
 
 using System;
+using System.Buffers;
 using System.Text;
 using System.Collections.Generic;
 
@@ -13,6 +14,9 @@ namespace libvt100 {
         public const byte XonCharacter = 17;
         public const byte XoffCharacter = 19;
 
+        private static readonly SearchValues<char> s_specials = SearchValues.Create("\u001B");
+        private static readonly SearchValues<char> s_specialsWithXonXoff = SearchValues.Create("\u001B\u0011\u0013");
+
         /// <summary>
         /// Used by Input() to determine whether the current run of input is part of
         /// a command or is normal text.
@@ -26,7 +30,10 @@ namespace libvt100 {
         protected Encoding m_encoding;
         protected Decoder m_decoder;
         protected Encoder m_encoder;
-        private List<byte> m_commandBuffer;
+        // Characters after the escape of an incomplete command; m_commandLength of them are in use.
+        private char[] m_commandBuffer;
+        private int m_commandLength;
+        private bool m_insideQuotes;
         protected bool m_supportXonXoff;
         protected bool m_xOffReceived;
         protected List<byte[]> m_outBuffer;
@@ -44,10 +51,17 @@ namespace libvt100 {
             }
         }
 
+        bool IDecoder.IsIdle {
+            get {
+                // GetCharCount does not change the decoder's state; flushing counts pending bytes.
+                return m_state == State.Normal && m_decoder.GetCharCount(ReadOnlySpan<byte>.Empty, true) == 0;
+            }
+        }
+
         public EscapeCharacterDecoder() {
             m_state = State.Normal;
             (this as IDecoder).Encoding = Encoding.ASCII;
-            m_commandBuffer = new List<byte>();
+            m_commandBuffer = new char[32];
             m_supportXonXoff = true;
             m_xOffReceived = false;
             m_outBuffer = new List<byte[]>();
@@ -58,194 +72,128 @@ namespace libvt100 {
             return (Char.IsNumber(_c) || _c == ';' || _c == '"' || _c == '?');
         }
 
-        protected void AddToCommandBuffer(byte _byte) {
-            if (m_supportXonXoff) {
-                if (_byte == XonCharacter || _byte == XoffCharacter) {
-                    return;
-                }
-            }
-
-            m_commandBuffer.Add(_byte);
-        }
-
-        protected void AddToCommandBuffer(byte[] _bytes) {
-            if (m_supportXonXoff) {
-                foreach (byte b in _bytes) {
-                    if (!(b == XonCharacter || b == XoffCharacter)) {
-                        m_commandBuffer.Add(b);
-                    }
-                }
-            }
-            else {
-                m_commandBuffer.AddRange(_bytes);
-            }
-        }
-
         protected virtual bool IsValidOneCharacterCommand(char _command) {
             return false;
         }
 
         /// <summary>
-        /// Processs m_commandBuffer which is a List<byte> (of chars).
+        /// Processes decoded text, looking for ANSI Escape Commands. Runs of normal text between
+        /// escape characters are found with a vectorized search and handed to OnCharacters as
+        /// slices of _text, without copying. Only an escape sequence that is still incomplete at the
+        /// end of _text is buffered (its characters after the escape), to be finished by the next call.
         /// </summary>
-        /// 
-        protected void ProcessCommandBuffer() {
-            // We keep getting called with more data added to m_commandBuffer
-            // We're either in the middle of processing command data (State.Command)
-            // or normal data (State.Normal). 
-            while (m_commandBuffer.Count > 0) {
-                // Move forward, processing normal input until we hit an EscapeChar
-                if (m_state == State.Normal && m_commandBuffer[0] != EscapeCharacter) {
-                    ProcessNormalInput(m_commandBuffer[0]);
-                    m_commandBuffer.RemoveAt(0);
-                    continue;
-                }
-
-                // m_commandBuffer starts with a command and we're in State.Command mode
-                if (m_state == State.Normal && m_commandBuffer[0] == EscapeCharacter) {
-                    m_state = State.Command;
-                }
-
-                int start = 1;
-
-                // ======== Decode escape code
-                // Escape code types:
-                // - Single char: "\x001B=" or "\x001B>"
-                // - One byte:    "\x001B123m"
-                // - Two byte:    "\x001B[123m"
-                if (start >= m_commandBuffer.Count) {
-                    // we need more data
-                    return;
-                }
-
-                if (m_commandBuffer[start] == LeftBracketCharacter) {
-                    start++;
-
-                    // It is a two byte escape code, but we still need more data
-                    if (m_commandBuffer.Count < 3) {
+        protected void ProcessInput(ReadOnlySpan<char> _text) {
+            SearchValues<char> specials = m_supportXonXoff ? s_specialsWithXonXoff : s_specials;
+            while (!_text.IsEmpty) {
+                if (m_state == State.Normal) {
+                    int index = _text.IndexOfAny(specials);
+                    if (index < 0) {
+                        OnCharacters(_text);
                         return;
                     }
-                }
-
-                // "\x001B123m"
-                //        ^
-                //        start
-                // or
-                // "\x001B[123m"
-                //         ^
-                //        start
-
-                // Decode parameter, including quoted parts
-                // Handle quotes in the command, e.g.: "\x001B[\"This string is part of the command\"123b"
-                int end = start;
-                bool insideQuotes = false;
-
-                // "\x001B\"This string is part of the command\"123b"
-                //        ^
-                //        end
-                // or
-                // "\x001B[\"This string is part of the command\"123b"
-                //         ^
-                //         end
-                while (end < m_commandBuffer.Count && (IsValidParameterCharacter((char)m_commandBuffer[end]) || insideQuotes)) {
-                    if (m_commandBuffer[end] == '"') {
-                        insideQuotes = !insideQuotes;
+                    if (index > 0) {
+                        OnCharacters(_text.Slice(0, index));
                     }
-                    end++;
-                }
 
-                if (insideQuotes) {
-                    // need more data
-                    return;
+                    char special = _text[index];
+                    _text = _text.Slice(index + 1);
+                    if (special == EscapeCharacter) {
+                        m_state = State.Command;
+                        m_commandLength = 0;
+                        m_insideQuotes = false;
+                    }
+                    else {
+                        ProcessFlowControl(special);
+                    }
+                    continue;
                 }
 
-                // "\x001B[\"This string is part of the command\"123b"
-                //                                                  ^
-                //                                                  end
-
-                // Single char: Deal with the case where command is "\x001B=" or "\x001B>" 
-                // "\x001B="
-                //        ^
-                //    start
-                //      end^
-                if (m_commandBuffer.Count == 2 && IsValidOneCharacterCommand((char)m_commandBuffer[start])) {
-                    end = m_commandBuffer.Count - 1;
+                // State.Command: feed the sequence one character at a time until it is complete.
+                int consumed = 0;
+                while (consumed < _text.Length && m_state == State.Command) {
+                    char c = _text[consumed++];
+                    if (m_supportXonXoff && (c == XonCharacter || c == XoffCharacter)) {
+                        ProcessFlowControl(c);
+                    }
+                    else {
+                        ProcessCommandCharacter(c);
+                    }
                 }
+                _text = _text.Slice(consumed);
+            }
+        }
 
-                if (end == m_commandBuffer.Count) {
-                    // More data needed for parameter
+        // Escape code types:
+        // - Single char: "\x001B=" or "\x001B>"
+        // - One byte:    "\x001B123m"
+        // - Two byte:    "\x001B[123m"
+        // Parameters may include quoted parts, e.g.: "\x001B[\"This string is part of the command\"123b"
+        private void ProcessCommandCharacter(char _c) {
+            if (m_commandLength == 0) {
+                if (_c == (char)LeftBracketCharacter) {
+                    AddToCommandBuffer(_c);
                     return;
                 }
-
-                // `start` and `end` now bracket a suppopsedly valid sequence
-                // "\x001B[\"This string is part of the command\"123b"
-                //         ^
-                //         start
-                //                                                  ^
-                //                                                  end
-                Decoder decoder = (this as IDecoder).Encoding.GetDecoder();
-
-                // Copy parameter data (end-start chrars) to a temp buffer so we can call ProcessCommand
-                byte[] parameterData = new byte[end - start];
-                for (int i = 0; i < parameterData.Length; i++) {
-                    parameterData[i] = m_commandBuffer[start + i];
+                if (IsValidOneCharacterCommand(_c)) {
+                    ExecuteCommand(_c);
+                    return;
                 }
-                int parameterLength = decoder.GetCharCount(parameterData, 0, parameterData.Length);
-                char[] parameterChars = new char[parameterLength];
-                decoder.GetChars(parameterData, 0, parameterData.Length, parameterChars, 0);
-                String parameter = new String(parameterChars);
+            }
 
-                byte command = m_commandBuffer[end];
-                // Eat exceptions thrown by ProcessCommand so the decoder survives invalid/unsupported
-                // sequences and keeps processing subsequent bytes (per the IDecoder contract).
-                try {
-                    ProcessCommand(command, parameter);
-                }
-                catch (InvalidCommandException) {
-                }
-                catch (InvalidParameterException) {
-                }
-                catch (ArgumentException) {
-                }
-                catch (IndexOutOfRangeException) {
-                }
-                finally {
-                    // We're done procesing the command. 
-                    m_state = State.Normal;
-                    if (m_commandBuffer.Count == end - 1) {
-                        // All command bytes processed, we can go back to normal handling
-                        m_commandBuffer.Clear();
-                    }
-                    else {
-                        m_commandBuffer.RemoveRange(0, end + 1);
-                    }
+            if (m_insideQuotes || IsValidParameterCharacter(_c)) {
+                if (_c == '"') {
+                    m_insideQuotes = !m_insideQuotes;
                 }
+                AddToCommandBuffer(_c);
+                return;
             }
+
+            ExecuteCommand(_c);
         }
 
-        protected void ProcessNormalInput(byte _data) {
-            //System.Console.WriteLine ( "ProcessNormalInput: {0:X2}", _data );
-            if (_data == EscapeCharacter) {
-                throw new Exception("Internal error, ProcessNormalInput was passed an escape character, please report this bug to the author.");
-            }
-            if (m_supportXonXoff) {
-                if (_data == XonCharacter || _data == XoffCharacter) {
-                    return;
-                }
+        private void AddToCommandBuffer(char _c) {
+            if (m_commandLength == m_commandBuffer.Length) {
+                Array.Resize(ref m_commandBuffer, m_commandBuffer.Length * 2);
             }
+            m_commandBuffer[m_commandLength++] = _c;
+        }
 
-            byte[] data = new byte[] { _data };
-            int charCount = m_decoder.GetCharCount(data, 0, 1);
-            char[] characters = new char[charCount];
-            m_decoder.GetChars(data, 0, 1, characters, 0);
+        private void ExecuteCommand(char _command) {
+            int start = m_commandLength > 0 && m_commandBuffer[0] == (char)LeftBracketCharacter ? 1 : 0;
+            String parameter = new String(m_commandBuffer, start, m_commandLength - start);
 
-            if (charCount > 0) {
-                OnCharacters(characters);
+            // We're done procesing the command, whatever ProcessCommand makes of it.
+            m_state = State.Normal;
+            m_commandLength = 0;
+            m_insideQuotes = false;
+
+            // Eat exceptions thrown by ProcessCommand so the decoder survives invalid/unsupported
+            // sequences and keeps processing subsequent input (per the IDecoder contract).
+            try {
+                ProcessCommand((byte)_command, parameter);
+            }
+            catch (InvalidCommandException) {
             }
-            else {
-                //System.Console.WriteLine ( "char count was zero" );
+            catch (InvalidParameterException) {
             }
+            catch (ArgumentException) {
+            }
+            catch (IndexOutOfRangeException) {
+            }
+        }
 
+        private void ProcessFlowControl(char _c) {
+            if (_c == XoffCharacter) {
+                m_xOffReceived = true;
+            }
+            else if (_c == XonCharacter) {
+                m_xOffReceived = false;
+                if (m_outBuffer.Count > 0) {
+                    foreach (byte[] output in m_outBuffer) {
+                        OnOutput(output);
+                    }
+                }
+            }
         }
 
         /// <summary>
@@ -253,36 +201,34 @@ namespace libvt100 {
         /// </summary>
         /// <param name="_data"></param>
         void IDecoder.Input(byte[] _data) {
-            /*
-            System.Console.Write ( "Input[{0}]: ", m_state );
-            foreach ( byte b in _data )
-            {
-                System.Console.Write ( "{0:X2} ", b );
-            }
-            System.Console.WriteLine ( "" );
-            */
-
             if (_data.Length == 0) {
                 throw new ArgumentException("Input can not process an empty array.");
             }
 
-            if (m_supportXonXoff) {
-                foreach (byte b in _data) {
-                    if (b == XoffCharacter) {
-                        m_xOffReceived = true;
-                    }
-                    else if (b == XonCharacter) {
-                        m_xOffReceived = false;
-                        if (m_outBuffer.Count > 0) {
-                            foreach (byte[] output in m_outBuffer) {
-                                OnOutput(output);
-                            }
-                        }
-                    }
-                }
+            (this as IDecoder).Input(new ReadOnlySpan<byte>(_data));
+        }
+
+        /// <summary>
+        /// Decodes the bytes in bulk with the (stateful) decoder for Encoding, so a character split
+        /// across calls is completed by the next one, and processes the resulting text.
+        /// </summary>
+        void IDecoder.Input(ReadOnlySpan<byte> _data) {
+            if (_data.IsEmpty) {
+                return;
             }
-            AddToCommandBuffer(_data);
-            ProcessCommandBuffer();
+
+            char[] chars = ArrayPool<char>.Shared.Rent(m_encoding.GetMaxCharCount(_data.Length));
+            try {
+                int charCount = m_decoder.GetChars(_data, chars, false);
+                ProcessInput(chars.AsSpan(0, charCount));
+            }
+            finally {
+                ArrayPool<char>.Shared.Return(chars);
+            }
+        }
+
+        void IDecoder.Input(ReadOnlySpan<char> _text) {
+            ProcessInput(_text);
         }
 
         void IDecoder.CharacterTyped(char _character) {
@@ -297,7 +243,7 @@ namespace libvt100 {
             m_commandBuffer = null;
         }
 
-        abstract protected void OnCharacters(char[] _characters);
+        abstract protected void OnCharacters(ReadOnlySpan<char> _characters);
         abstract protected void ProcessCommand(byte _command, String _parameter);
 
         virtual public event DecoderOutputDelegate Output;
@@ -130,7 +130,7 @@ namespace libvt100
    
     public interface IAnsiDecoderClient : IDisposable
     {
-        void Characters ( IAnsiDecoder _sender, char[] _chars );
+        void Characters ( IAnsiDecoder _sender, ReadOnlySpan<char> _chars );
         void SaveCursor ( IAnsiDecoder _sernder );
         void RestoreCursor ( IAnsiDecoder _sender );
         Size GetSize ( IAnsiDecoder _sender );
@@ -9,6 +9,12 @@ namespace libvt100
     {
         Encoding Encoding { get; set; }
 
+        /// <summary>
+        /// True when the input so far ends between characters and escape sequences, so nothing is
+        /// partially decoded and a new decoder could take over from here.
+        /// </summary>
+        bool IsIdle { get; }
+
         /// <summary>
         /// Tell decoder to process the given data.
         /// 
@@ -18,6 +24,17 @@ namespace libvt100
         /// to process data after an exception is thrown.
         /// </summary>
         void Input ( byte[] _data );
+
+        /// <summary>
+        /// Tell decoder to process the given data without copying it into an array first.
+        /// </summary>
+        void Input ( ReadOnlySpan<byte> _data );
+
+        /// <summary>
+        /// Tell decoder to process text that has already been decoded from Encoding
+        /// (e.g. a string held in memory). Escape sequences may span calls.
+        /// </summary>
+        void Input ( ReadOnlySpan<char> _text );
         
         event DecoderOutputDelegate Output;
 
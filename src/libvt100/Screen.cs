@@ -476,7 +476,7 @@ namespace libvt100
             return (this as IEnumerable<Screen.Character>).GetEnumerator();
         }
 
-        void IAnsiDecoderClient.Characters(IAnsiDecoder _sender, char[] _chars)
+        void IAnsiDecoderClient.Characters(IAnsiDecoder _sender, ReadOnlySpan<char> _chars)
         {
             foreach (char ch in _chars)
             {
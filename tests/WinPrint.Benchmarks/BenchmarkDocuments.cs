@@ -0,0 +1,206 @@
+using System.Globalization;
+using System.Text;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     The documents the benchmarks run against: files from the repo's <c>testfiles</c> corpus, one per
+///     content type engine, plus synthetic inputs sized to find the cliffs the corpus is too small to hit.
+///     The synthetic files are generated deterministically (fixed seed) into the temp directory the first
+///     time they are needed and reused by later benchmark processes.
+/// </summary>
+internal static class BenchmarkDocuments
+{
+    /// <summary>One million lines of log output (<c>TextCte</c>, streamed).</summary>
+    public const string MillionLineLog = "synthetic 1M lines.log";
+
+    /// <summary>A 2 MB minified script on a single line (<c>TextMateCte</c> wrapping).</summary>
+    public const string MinifiedScript = "synthetic minified.min.js";
+
+    /// <summary>Deeply nested Markdown: headings, lists, quotes, tables and code (<c>MarkdownCte</c>).</summary>
+    public const string DeepMarkdown = "synthetic deep.md";
+
+    /// <summary>An HTML table of 5,000 rows (<c>HtmlCte</c> layout).</summary>
+    public const string BigHtmlTable = "synthetic table.html";
+
+    // Bump when a generator changes so stale copies in the temp directory are not reused.
+    private const int GeneratorVersion = 1;
+
+    private static readonly string[] s_corpus =
+    [
+        "TEST.TXT", // TextCte
+        "Program.cs", // TextMateCte
+        "Test 1000 Lines.c",
+        "Fixed Pitch Alignment.c.ans", // AnsiCte
+        "demo.md", // MarkdownCte
+        "long html doc.html", // HtmlCte
+        "pull request.mhtml"
+    ];
+
+    private static readonly string[] s_synthetic = [MillionLineLog, MinifiedScript, DeepMarkdown, BigHtmlTable];
+
+    private static readonly Lock s_lock = new();
+
+    /// <summary>Every document, corpus first; the values of the benchmarks' <c>Document</c> parameter.</summary>
+    public static IEnumerable<string> Names => [.. s_corpus, .. s_synthetic];
+
+    /// <summary>Returns the full path of <paramref name="name" />, generating it first if it is synthetic.</summary>
+    public static string GetPath(string name)
+    {
+        return s_synthetic.Contains(name) ? GetSyntheticPath(name) : FindTestFile(name);
+    }
+
+    private static string FindTestFile(string name)
+    {
+        var dir = new DirectoryInfo(AppContext.BaseDirectory);
+        while (dir is not null)
+        {
+            string candidate = Path.Combine(dir.FullName, "testfiles", name);
+            if (File.Exists(candidate))
+            {
+                return candidate;
+            }
+
+            dir = dir.Parent;
+        }
+
+        throw new FileNotFoundException($"Could not locate testfiles/{name} from {AppContext.BaseDirectory}");
+    }
+
+    private static string GetSyntheticPath(string name)
+    {
+        string dir = Path.Combine(Path.GetTempPath(), "winprint-benchmarks", $"v{GeneratorVersion}");
+        string path = Path.Combine(dir, name);
+        lock (s_lock)
+        {
+            if (File.Exists(path))
+            {
+                return path;
+            }
+
+            Directory.CreateDirectory(dir);
+
+            // Write beside and move into place, so a run that is killed mid-write never leaves a
+            // truncated file behind for the next one to measure.
+            string partial = path + ".partial";
+            using (var writer = new StreamWriter(partial, false, new UTF8Encoding(false)))
+            {
+                var random = new Random(GeneratorVersion);
+                switch (name)
+                {
+                    case MillionLineLog:
+                        WriteLog(writer, random);
+                        break;
+                    case MinifiedScript:
+                        WriteMinifiedScript(writer, random);
+                        break;
+                    case DeepMarkdown:
+                        WriteDeepMarkdown(writer, random);
+                        break;
+                    default:
+                        WriteHtmlTable(writer, random);
+                        break;
+                }
+            }
+
+            File.Move(partial, path, true);
+            return path;
+        }
+    }
+
+    private static void WriteLog(TextWriter writer, Random random)
+    {
+        string[] levels = ["DEBUG", "INFO ", "INFO ", "INFO ", "WARN ", "ERROR"];
+        var time = new DateTime(2026, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+        for (int i = 0; i < 1_000_000; i++)
+        {
+            time = time.AddMilliseconds(random.Next(1, 250));
+            writer.Write(time.ToString("yyyy-MM-dd'T'HH:mm:ss.fff'Z'", CultureInfo.InvariantCulture));
+            writer.Write(' ');
+            writer.Write(levels[random.Next(levels.Length)]);
+            writer.Write(CultureInfo.InvariantCulture, $" [worker-{random.Next(16):00}] request {i} ");
+            writer.WriteLine(random.Next(20) == 0
+                ? $"failed after {random.Next(1, 30_000)} ms: upstream returned 503 (retry {random.Next(1, 4)} of 3)"
+                : $"completed in {random.Next(1, 500)} ms");
+        }
+    }
+
+    private static void WriteMinifiedScript(TextWriter writer, Random random)
+    {
+        int written = 0;
+        for (int i = 0; written < 2_000_000; i++)
+        {
+            string statement = random.Next(3) switch
+            {
+                0 => $"function f{i}(a,b){{return a.map(function(c){{return c*{random.Next(100)}+b}})}}",
+                1 => $"var v{i}=f{Math.Max(0, i - 1)}([{random.Next(1000)},{random.Next(1000)}],\"s{i}\");",
+                _ => $"if(v{i}&&v{i}.length>{random.Next(10)}){{console.log(\"n\",v{i}.join(\",\"))}}"
+            };
+            writer.Write(statement);
+            written += statement.Length;
+        }
+    }
+
+    private static void WriteDeepMarkdown(TextWriter writer, Random random)
+    {
+        const string Words = "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor";
+        string[] words = Words.Split(' ');
+
+        string Sentence()
+        {
+            return string.Join(' ',
+                Enumerable.Range(0, random.Next(6, 20)).Select(_ => words[random.Next(words.Length)]));
+        }
+
+        for (int section = 1; section <= 400; section++)
+        {
+            writer.WriteLine($"{new string('#', 1 + section % 6)} Section {section}");
+            writer.WriteLine();
+            writer.WriteLine($"{Sentence()} **{Sentence()}** `code {section}` {Sentence()}.");
+            writer.WriteLine();
+
+            // Nest lists and block quotes eight levels deep.
+            for (int depth = 0; depth < 8; depth++)
+            {
+                writer.WriteLine($"{new string(' ', depth * 2)}- {Sentence()}");
+            }
+
+            writer.WriteLine();
+            for (int depth = 1; depth <= 8; depth++)
+            {
+                writer.WriteLine($"{string.Concat(Enumerable.Repeat("> ", depth))}{Sentence()}");
+            }
+
+            writer.WriteLine();
+            writer.WriteLine("| Key | Value | Notes |");
+            writer.WriteLine("| --- | ---: | --- |");
+            for (int row = 0; row < 5; row++)
+            {
+                writer.WriteLine($"| k{row} | {random.Next(100_000)} | {Sentence()} |");
+            }
+
+            writer.WriteLine();
+            writer.WriteLine("```csharp");
+            writer.WriteLine($"int value{section} = {random.Next()};");
+            writer.WriteLine("```");
+            writer.WriteLine();
+        }
+    }
+
+    private static void WriteHtmlTable(TextWriter writer, Random random)
+    {
+        writer.WriteLine("<!DOCTYPE html>");
+        writer.WriteLine("<html><head><title>Big table</title></head><body>");
+        writer.WriteLine("<table border=\"1\"><thead><tr><th>#</th><th>Name</th><th>Amount</th>" +
+                         "<th>Status</th><th>Description</th></tr></thead><tbody>");
+        for (int row = 0; row < 5_000; row++)
+        {
+            writer.WriteLine($"<tr><td>{row}</td><td>item-{random.Next(1_000_000):x6}</td>" +
+                             $"<td align=\"right\">{random.Next(1_000_000) / 100}.{random.Next(100):00}</td>" +
+                             $"<td>{(random.Next(4) == 0 ? "<b>late</b>" : "ok")}</td>" +
+                             $"<td>Row {row} of the generated table with some wrapping text</td></tr>");
+        }
+
+        writer.WriteLine("</tbody></table></body></html>");
+    }
+}
@@ -0,0 +1,58 @@
+using WinPrint.Core;
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.Models;
+using WinPrint.Core.Services;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     Loads a document the way the headless print path does (<c>PrintPlanner</c>): default settings, the
+///     first sheet definition, Letter paper and the caller's measurement context. The user's settings file
+///     is overwritten in memory with the defaults so results do not depend on who runs the benchmarks.
+/// </summary>
+internal static class BenchmarkSheet
+{
+    /// <summary>
+    ///     Sheets painted by the PDF and page-image benchmarks. The per-sheet cost is what matters; rendering
+    ///     every sheet of the 1M-line log would take minutes an iteration without saying more.
+    /// </summary>
+    public const int MaxSheets = 10;
+
+    /// <summary>Loads <paramref name="document" /> (a <see cref="BenchmarkDocuments" /> name) unreflowed.</summary>
+    public static async Task<SheetViewModel> LoadAsync(string document, IGraphicsContext measurementContext)
+    {
+        Settings settings = Settings.CreateDefaultSettings();
+        WinPrintServices.Current.Settings.CopyPropertiesFrom(settings);
+
+        var sheet = new SheetViewModel { MeasurementContext = measurementContext };
+        sheet.SetSheet(settings.Sheets.Values.First());
+        if (!await sheet.LoadFileAsync(BenchmarkDocuments.GetPath(document)).ConfigureAwait(false))
+        {
+            throw new InvalidOperationException($"Could not load {document}.");
+        }
+
+        sheet.SetPrinterPageSettings(CreatePageSetup(sheet));
+        return sheet;
+    }
+
+    /// <summary>Loads and reflows <paramref name="document" />.</summary>
+    public static async Task<SheetViewModel> LoadAndReflowAsync(string document, IGraphicsContext measurementContext)
+    {
+        SheetViewModel sheet = await LoadAsync(document, measurementContext).ConfigureAwait(false);
+        await sheet.ReflowAsync().ConfigureAwait(false);
+        return sheet;
+    }
+
+    /// <summary>Letter paper, oriented as the sheet definition asks.</summary>
+    public static PrintPageSetup CreatePageSetup(SheetViewModel sheet)
+    {
+        return new PrintPageSetup { Landscape = sheet.Landscape };
+    }
+
+    /// <summary>The first <see cref="MaxSheets" /> sheets, as the print pipeline queues them.</summary>
+    public static IReadOnlyList<(int PageNumber, Action<IGraphicsContext, int> Render)> GetPages(SheetViewModel sheet)
+    {
+        Action<IGraphicsContext, int> render = (context, number) => sheet.PrintSheet(context, number);
+        return [.. Enumerable.Range(1, Math.Min(sheet.NumSheets, MaxSheets)).Select(n => (n, render))];
+    }
+}
@@ -0,0 +1,20 @@
+using BenchmarkDotNet.Attributes;
+using WinPrint.Core.ContentTypeEngines;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     <see cref="ContentTypeEngineBase.GetContentType" />: resolving a file name to a content type through
+///     the file type mappings, paid once per file opened or printed.
+/// </summary>
+public class ContentTypeBenchmarks
+{
+    [Params("Program.cs", "WINPRINT.C", "demo.md", "Fixed Pitch Alignment.c.ans", "notes.unknownext", "Makefile")]
+    public string FileName { get; set; } = string.Empty;
+
+    [Benchmark]
+    public string GetContentType()
+    {
+        return ContentTypeEngineBase.GetContentType(FileName);
+    }
+}
@@ -0,0 +1,51 @@
+using BenchmarkDotNet.Attributes;
+using WinPrint.Core;
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.Printing;
+using WinPrint.Core.Printing.Skia;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     <see cref="SkiaPageImageRenderer.RenderPagesAsync" /> of the first <see cref="BenchmarkSheet.MaxSheets" />
+///     sheets of each document at the default 300 DPI (the Windows print path), sequentially and with the
+///     default concurrency, so a change in either the per-page cost or the parallel speed-up shows. Like the
+///     print job, documents whose engine doesn't support concurrent painting render sequentially either way.
+/// </summary>
+public class PageImageBenchmarks
+{
+    private bool _concurrentPainting;
+    private PrintPageSetup _pageSetup = null!;
+    private IReadOnlyList<(int PageNumber, Action<IGraphicsContext, int> Render)> _pages = [];
+
+    [ParamsSource(nameof(Documents))]
+    public string Document { get; set; } = string.Empty;
+
+    [Params(1, 0)]
+    public int MaxConcurrency { get; set; }
+
+    public static IEnumerable<string> Documents => BenchmarkDocuments.Names;
+
+    [GlobalSetup]
+    public async Task SetupAsync()
+    {
+        SheetViewModel sheet =
+            await BenchmarkSheet.LoadAndReflowAsync(Document, SkiaGraphicsContext.CreateMeasurementContext());
+        _concurrentPainting = sheet.SupportsConcurrentPainting;
+        _pageSetup = BenchmarkSheet.CreatePageSetup(sheet);
+        _pages = BenchmarkSheet.GetPages(sheet);
+    }
+
+    [Benchmark]
+    public async Task<long> RenderPages()
+    {
+        long bytes = 0;
+        await foreach (byte[] png in SkiaPageImageRenderer.RenderPagesAsync(_pages, _pageSetup,
+                           maxConcurrency: _concurrentPainting ? MaxConcurrency : 1))
+        {
+            bytes += png.Length;
+        }
+
+        return bytes;
+    }
+}
@@ -0,0 +1,55 @@
+using BenchmarkDotNet.Attributes;
+using SkiaSharp;
+using WinPrint.Core;
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.Printing.Skia;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     Painting one sheet of each document onto a Skia raster canvas at screen density, the per-page cost
+///     every renderer pays on top of its own encoding. The first sheet includes the header and footer and,
+///     for the synthetic inputs, is as dense as any other.
+/// </summary>
+public class PaintBenchmarks
+{
+    private const float Dpi = 96f;
+
+    private SKBitmap _bitmap = null!;
+    private SKCanvas _canvas = null!;
+    private SheetViewModel _sheet = null!;
+
+    [ParamsSource(nameof(Documents))]
+    public string Document { get; set; } = string.Empty;
+
+    public static IEnumerable<string> Documents => BenchmarkDocuments.Names;
+
+    [GlobalSetup]
+    public async Task SetupAsync()
+    {
+        _sheet = await BenchmarkSheet.LoadAndReflowAsync(Document, SkiaGraphicsContext.CreateMeasurementContext());
+
+        // Sized like SkiaPageImageRenderer sizes its bitmaps: the full page in hundredths of an inch.
+        PrintPageSetup pageSetup = BenchmarkSheet.CreatePageSetup(_sheet);
+        int width = pageSetup.Landscape ? pageSetup.PaperHeight : pageSetup.PaperWidth;
+        int height = pageSetup.Landscape ? pageSetup.PaperWidth : pageSetup.PaperHeight;
+        _bitmap = new SKBitmap((int)Math.Ceiling(width * Dpi / 100f), (int)Math.Ceiling(height * Dpi / 100f));
+        _canvas = new SKCanvas(_bitmap);
+        _canvas.Scale(Dpi / 100f);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        _canvas.Dispose();
+        _bitmap.Dispose();
+    }
+
+    [Benchmark]
+    public void PaintSheet()
+    {
+        _canvas.Clear(SKColors.White);
+        var context = new SkiaGraphicsContext(_canvas, Dpi, Dpi);
+        _sheet.PrintSheet(context, 1);
+    }
+}
@@ -0,0 +1,38 @@
+using BenchmarkDotNet.Attributes;
+using WinPrint.Core;
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.Printing;
+using WinPrint.Core.Printing.Skia;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     <see cref="SkiaPdfRenderer" /> of the first <see cref="BenchmarkSheet.MaxSheets" /> sheets of each
+///     document (the macOS/Linux print path), streamed to <see cref="Stream.Null" /> so only painting and PDF
+///     encoding are measured.
+/// </summary>
+public class PdfRenderBenchmarks
+{
+    private PrintPageSetup _pageSetup = null!;
+    private IReadOnlyList<(int PageNumber, Action<IGraphicsContext, int> Render)> _pages = [];
+
+    [ParamsSource(nameof(Documents))]
+    public string Document { get; set; } = string.Empty;
+
+    public static IEnumerable<string> Documents => BenchmarkDocuments.Names;
+
+    [GlobalSetup]
+    public async Task SetupAsync()
+    {
+        SheetViewModel sheet =
+            await BenchmarkSheet.LoadAndReflowAsync(Document, SkiaGraphicsContext.CreateMeasurementContext());
+        _pageSetup = BenchmarkSheet.CreatePageSetup(sheet);
+        _pages = BenchmarkSheet.GetPages(sheet);
+    }
+
+    [Benchmark]
+    public void RenderPdf()
+    {
+        SkiaPdfRenderer.Render(_pages, _pageSetup, Stream.Null);
+    }
+}
@@ -0,0 +1,33 @@
+using BenchmarkDotNet.Attributes;
+using WinPrint.Core;
+using WinPrint.TUI.Graphics;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     The <c>wp</c> preview: <see cref="PageRenderer.RenderPage" /> of the first sheet of each document.
+///     Reflow measures through the renderer's ImageSharp context, as the TUI does (engine pairing), so this is
+///     the one benchmark that does not measure with Skia.
+/// </summary>
+public class PreviewRenderBenchmarks
+{
+    private readonly PageRenderer _renderer = new();
+    private SheetViewModel _sheet = null!;
+
+    [ParamsSource(nameof(Documents))]
+    public string Document { get; set; } = string.Empty;
+
+    public static IEnumerable<string> Documents => BenchmarkDocuments.Names;
+
+    [GlobalSetup]
+    public async Task SetupAsync()
+    {
+        _sheet = await BenchmarkSheet.LoadAndReflowAsync(Document, _renderer.CreateMeasurementContext());
+    }
+
+    [Benchmark]
+    public int RenderPage()
+    {
+        return _renderer.RenderPage(_sheet, 0).Length;
+    }
+}
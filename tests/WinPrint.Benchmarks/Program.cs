@@ -0,0 +1,19 @@
+// WinPrint.Benchmarks — BenchmarkDotNet suite for the content type engines and renderers. Run from the
+// repo root with
+//
+//     dotnet run -c Release --project tests/WinPrint.Benchmarks -- --filter '*'
+//
+// Every run reports allocations and writes JSON (plus GitHub Markdown) to BenchmarkDotNet.Artifacts/results,
+// so two runs can be diffed to gate a dependency upgrade. See README.md.
+
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Diagnosers;
+using BenchmarkDotNet.Exporters;
+using BenchmarkDotNet.Exporters.Json;
+using BenchmarkDotNet.Running;
+
+IConfig config = DefaultConfig.Instance
+    .AddDiagnoser(MemoryDiagnoser.Default)
+    .AddExporter(JsonExporter.Full, MarkdownExporter.GitHub);
+
+BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args, config);
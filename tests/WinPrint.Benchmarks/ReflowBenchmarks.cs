@@ -0,0 +1,42 @@
+using BenchmarkDotNet.Attributes;
+using WinPrint.Core;
+using WinPrint.Core.Printing.Skia;
+
+namespace WinPrint.Benchmarks;
+
+/// <summary>
+///     Reflow of every content type engine, measured with Skia (the headless print path's engine).
+///     <see cref="Reflow" /> is what a settings change costs once a file is open; engines cache across
+///     reflows (TextMate keeps its tokens, Markdown its decoded images), so it is the warm number.
+///     <see cref="LoadAndReflow" /> is opening the file cold.
+/// </summary>
+public class ReflowBenchmarks
+{
+    private SheetViewModel _sheet = null!;
+
+    [ParamsSource(nameof(Documents))]
+    public string Document { get; set; } = string.Empty;
+
+    public static IEnumerable<string> Documents => BenchmarkDocuments.Names;
+
+    [GlobalSetup]
+    public async Task SetupAsync()
+    {
+        _sheet = await BenchmarkSheet.LoadAsync(Document, SkiaGraphicsContext.CreateMeasurementContext());
+    }
+
+    [Benchmark]
+    public async Task<int> Reflow()
+    {
+        await _sheet.ReflowAsync();
+        return _sheet.NumSheets;
+    }
+
+    [Benchmark]
+    public async Task<int> LoadAndReflow()
+    {
+        SheetViewModel sheet = await BenchmarkSheet.LoadAndReflowAsync(Document,
+            SkiaGraphicsContext.CreateMeasurementContext());
+        return sheet.NumSheets;
+    }
+}
@@ -0,0 +1,83 @@
+using System.Text;
+using libvt100;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.Cte;
+
+/// <summary>
+///     Tests for the libvt100 <see cref="AnsiDecoder" /> input paths: text, whole byte arrays and arbitrary
+///     chunks must decode to the same screen.
+/// </summary>
+public class AnsiDecoderTests
+{
+    private const string Sample =
+        "\u001b[1mBold\u001b[0m plain \u001b[31;1mred — ünïcødé\u001b[0m\r\n" +
+        "\u001b[\"quoted;param\"z\u001b=after one-char\u001b[999Xbad\n\u001b[32mlast";
+
+    private static (DynamicScreen Screen, IAnsiDecoder Decoder) Create()
+    {
+        var screen = new DynamicScreen(80) { TabSpaces = 4 };
+        IAnsiDecoder vt100 = new AnsiDecoder();
+        vt100.Encoding = Encoding.UTF8;
+        vt100.Subscribe(screen);
+        return (screen, vt100);
+    }
+
+    private static string Describe(DynamicScreen screen)
+    {
+        return string.Join("\n", screen.Lines.Select(line => string.Join("|", line.Runs.Select(r =>
+            $"{line.Text[r.Start..(r.Start + r.Length)]}:{r.Attributes.Bold}:{r.Attributes.ForegroundColor}"))));
+    }
+
+    [Fact]
+    public void TextInput_MatchesByteInput()
+    {
+        (DynamicScreen fromBytes, IAnsiDecoder bytesDecoder) = Create();
+        bytesDecoder.Input(Encoding.UTF8.GetBytes(Sample));
+        (DynamicScreen fromText, IAnsiDecoder textDecoder) = Create();
+        textDecoder.Input(Sample.AsSpan());
+
+        Assert.Equal("Bold plain red — ünïcødé", fromText.Lines[0].Text);
+        Assert.Equal("after one-charbad", fromText.Lines[1].Text);
+        Assert.Equal(Describe(fromBytes), Describe(fromText));
+    }
+
+    [Theory]
+    [InlineData(1)]
+    [InlineData(2)]
+    [InlineData(5)]
+    public void ChunkedInput_CompletesSequencesAndCharactersSplitAcrossCalls(int chunkSize)
+    {
+        (DynamicScreen expected, IAnsiDecoder wholeDecoder) = Create();
+        wholeDecoder.Input(Sample.AsSpan());
+
+        (DynamicScreen fromBytes, IAnsiDecoder bytesDecoder) = Create();
+        byte[] bytes = Encoding.UTF8.GetBytes(Sample);
+        for (int i = 0; i < bytes.Length; i += chunkSize)
+        {
+            bytesDecoder.Input(bytes.AsSpan(i, Math.Min(chunkSize, bytes.Length - i)));
+        }
+
+        (DynamicScreen fromText, IAnsiDecoder textDecoder) = Create();
+        for (int i = 0; i < Sample.Length; i += chunkSize)
+        {
+            textDecoder.Input(Sample.AsSpan(i, Math.Min(chunkSize, Sample.Length - i)));
+        }
+
+        Assert.Equal(Describe(expected), Describe(fromBytes));
+        Assert.Equal(Describe(expected), Describe(fromText));
+    }
+
+    [Fact]
+    public void FlowControlCharacters_AreDroppedEvenInsideSequences()
+    {
+        (DynamicScreen screen, IAnsiDecoder vt100) = Create();
+
+        vt100.Input("a\u0013b\u001b[3\u00111mc\u0011".AsSpan());
+
+        DynamicScreen.Line line = screen.Lines[0];
+        Assert.Equal("abc", line.Text);
+        Assert.Equal(2, line.Runs.Count);
+        Assert.NotEqual(line.Runs[0].Attributes.ForegroundColor, line.Runs[1].Attributes.ForegroundColor);
+    }
+}
@@ -1,3 +1,4 @@
+using System.Text;
 using WinPrint.Core.Abstractions;
 using WinPrint.Core.ContentTypeEngines;
 using WinPrint.Core.Models;
@@ -138,6 +139,107 @@ public class CteRenderingTests
         Assert.NotEmpty(paint.DrawnLines);
     }
 
+    [Fact]
+    public async Task TextCte_PublishesPagesProgressively_AndPaintsFirstPageDuringReflow()
+    {
+        var measure = new RecordingGraphicsContext();
+        TextCte cte = MakeTextCte(measure, 100, 60);
+        Assert.True(await cte.SetDocumentAsync(string.Join("\n", Enumerable.Range(1, 3000).Select(i => $"l{i}"))));
+
+        // Paint page 1 from inside the progress callback, i.e. while later pages are still being wrapped.
+        var published = new List<int>();
+        var firstPage = new RecordingGraphicsContext();
+        int pages = await cte.RenderAsync(Dpi96, (_, _) =>
+        {
+            published.Add(cte.AvailablePages);
+            if (cte.AvailablePages > 0 && firstPage.DrawnStrings.Count == 0)
+            {
+                cte.PaintPage(firstPage, 1);
+            }
+        });
+
+        Assert.Equal(1000, pages);
+        Assert.Equal(0, published[0]);
+        Assert.True(published[1] is > 0 and < 1000, $"First publication was {published[1]} pages.");
+        Assert.Equal(pages, published[^1]);
+        Assert.Equal(pages, cte.AvailablePages);
+        Assert.Equal(["l1", "l2", "l3"], firstPage.DrawnStrings.Select(s => s.Text));
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task TextCte_ChunkedWrap_PaintsSameAsSingleChunk(bool lineNumbers)
+    {
+        // Form feeds pad to page boundaries and mid-line form feeds advance the line number, so both have
+        // to carry across chunk boundaries when the chunks are stitched.
+        string text = string.Join("\n", Enumerable.Range(1, 120).Select(i =>
+            i % 11 == 0 ? $"x{i}\fy{i}" : i % 7 == 0 ? new string((char)('a' + i % 26), 23) : $"l{i}"));
+        TextCte single = MakeTextCte(new RecordingGraphicsContext(), 100, 60, lineNumbers);
+        single.ContentSettings!.NewPageOnFormFeed = true;
+        await single.SetDocumentAsync(text);
+        int expectedPages = await single.RenderAsync(Dpi96, null);
+
+        TextCte chunked = MakeTextCte(new RecordingGraphicsContext(), 100, 60, lineNumbers);
+        chunked.ContentSettings!.NewPageOnFormFeed = true;
+        chunked.WrapChunkSize = 5;
+        await chunked.SetDocumentAsync(text);
+        int pages = await chunked.RenderAsync(Dpi96, null);
+
+        Assert.Equal(expectedPages, pages);
+        for (int page = 1; page <= pages; page++)
+        {
+            var expected = new RecordingGraphicsContext();
+            single.PaintPage(expected, page);
+            var actual = new RecordingGraphicsContext();
+            chunked.PaintPage(actual, page);
+
+            Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+        }
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task TextCte_AppendAsync_PaintsSameAsFullReflow(bool lineNumbers)
+    {
+        string first = string.Concat(Enumerable.Range(1, 40).Select(i => i % 7 == 0 ? $"x{i}\fy{i}\n" : $"l{i}\n"));
+        string appended = string.Concat(Enumerable.Range(41, 30).Select(i => $"{new string('a', i % 13)}{i}\n"));
+        TextCte full = MakeTextCte(new RecordingGraphicsContext(), 100, 60, lineNumbers);
+        full.ContentSettings!.NewPageOnFormFeed = true;
+        await full.SetDocumentAsync(first + appended);
+        int expectedPages = await full.RenderAsync(Dpi96, null);
+
+        TextCte followed = MakeTextCte(new RecordingGraphicsContext(), 100, 60, lineNumbers);
+        followed.ContentSettings!.NewPageOnFormFeed = true;
+        await followed.SetDocumentAsync(first);
+        await followed.RenderAsync(Dpi96, null);
+        int pages = await followed.AppendAsync(appended, null);
+
+        Assert.Equal(expectedPages, pages);
+        Assert.Equal(first + appended, followed.Document);
+        for (int page = 1; page <= pages; page++)
+        {
+            var expected = new RecordingGraphicsContext();
+            full.PaintPage(expected, page);
+            var actual = new RecordingGraphicsContext();
+            followed.PaintPage(actual, page);
+
+            Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+        }
+    }
+
+    [Fact]
+    public async Task TextCte_AppendAsync_AfterPartialLine_AsksForReload()
+    {
+        TextCte cte = MakeTextCte(new RecordingGraphicsContext(), 100, 60);
+        await cte.SetDocumentAsync("l1\nhalf a li");
+        await cte.RenderAsync(Dpi96, null);
+
+        Assert.Equal(-1, await cte.AppendAsync("ne\n", null));
+        Assert.Equal("l1\nhalf a li", cte.Document);
+    }
+
     [Fact]
     public async Task AnsiCte_DecodesAnsi_RendersTextWithoutEscapeCodes()
     {
@@ -395,6 +497,36 @@ public class CteRenderingTests
         Assert.DoesNotContain("</", all, StringComparison.Ordinal);
     }
 
+    [Fact]
+    public async Task HtmlCte_PaintPage_DrawsOnlyThatPagesSlice()
+    {
+        var cte = new HtmlCte
+        {
+            ContentSettings = new ContentSettings { Font = new Font { Family = "Arial", Size = 12 }, TabSpaces = 4 },
+            MeasurementContext = new RecordingGraphicsContext(),
+            PageSize = new System.Drawing.SizeF(400, 200)
+        };
+
+        string[] words = [.. Enumerable.Range(0, 60).Select(i => $"w{i:D3}")];
+        Assert.True(await cte.SetDocumentAsync(
+            "<html><body>" + string.Concat(words.Select(w => $"<p>{w}</p>")) + "</body></html>"));
+        int pages = await cte.RenderAsync(Dpi96, null);
+        Assert.True(pages > 5);
+
+        var seen = new List<string>();
+        for (int p = 1; p <= pages; p++)
+        {
+            var paint = new RecordingGraphicsContext();
+            cte.PaintPage(paint, p);
+
+            // Page-relative coordinates; a line straddling the boundary may start just above the page.
+            Assert.All(paint.DrawnStrings, s => Assert.InRange(s.Y, -paint.LineHeight, 200));
+            seen.AddRange(paint.DrawnStrings.Select(s => s.Text.Trim()));
+        }
+
+        Assert.Equal(words, seen.Distinct());
+    }
+
     [Fact]
     public async Task TextMateCte_RendersTokenizedText_CrossPlatform()
     {
@@ -427,6 +559,146 @@ public class CteRenderingTests
         Assert.Contains(paint.DrawnStrings, s => s.Text.Contains("world"));
     }
 
+    [Fact]
+    public async Task TextMateCte_ChunkedTokenize_ReconcilesRuleStateAcrossChunks()
+    {
+        // The block comment spans several 2-line chunks; chunks starting inside it are first tokenized as
+        // code and must be re-tokenized from the previous chunk's rule state.
+        const string source = "using System;\n/* start\n   int inComment = 1;\n   string s = \"x\";\n" +
+                              "   still comment */\nclass A\n{\n    int b = 2; // trailing\n}\n";
+        TextMateCte single = MakeCSharpTextMateCte(int.MaxValue, "Single.cs");
+        await single.SetDocumentAsync(source);
+        int expectedPages = await single.RenderAsync(Dpi96, null);
+
+        // A different file, so the chunks aren't started from the single-chunk tokens.
+        TextMateCte chunked = MakeCSharpTextMateCte(2, "Chunked.cs");
+        await chunked.SetDocumentAsync(source);
+        int pages = await chunked.RenderAsync(Dpi96, null);
+
+        Assert.Equal(expectedPages, pages);
+        for (int page = 1; page <= pages; page++)
+        {
+            var expected = new RecordingGraphicsContext();
+            single.PaintPage(expected, page);
+            var actual = new RecordingGraphicsContext();
+            chunked.PaintPage(actual, page);
+
+            Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+        }
+    }
+
+    [Fact]
+    public async Task TextMateCte_Reflow_ReusesCachedTokens()
+    {
+        var sb = new StringBuilder();
+        for (int i = 0; i < 40; i++)
+        {
+            sb.Append(i % 9 == 0 ? "/* comment\n   continued */\n" : $"int value{i} = {i}; // {i}\n");
+        }
+
+        string source = sb.ToString();
+        string file = $"Cached_{Guid.NewGuid():N}.cs";
+        TextMateCte cte = MakeCSharpTextMateCte(8, file);
+        await cte.SetDocumentAsync(source);
+        await cte.RenderAsync(Dpi96, null);
+        int sourceLines = cte.TokenizedLineCount;
+        Assert.True(sourceLines > 0);
+
+        // A geometry-only reflow re-wraps the cached tokens.
+        cte.PageSize = new System.Drawing.SizeF(250, 100);
+        int pages = await cte.RenderAsync(Dpi96, null);
+        Assert.Equal(0, cte.TokenizedLineCount);
+        await AssertPaintsSameAsUncachedAsync(cte, pages, source, 250);
+
+        // An edit re-tokenizes from the changed line until the rule state matches the cached tokens again.
+        string edited = source.Replace("int value30 = 30;", "/* opened", StringComparison.Ordinal);
+        TextMateCte reloaded = MakeCSharpTextMateCte(8, file);
+        reloaded.PageSize = new System.Drawing.SizeF(250, 100);
+        await reloaded.SetDocumentAsync(edited);
+        pages = await reloaded.RenderAsync(Dpi96, null);
+        Assert.InRange(reloaded.TokenizedLineCount, 1, sourceLines - 20);
+        await AssertPaintsSameAsUncachedAsync(reloaded, pages, edited, 250);
+    }
+
+    [Fact]
+    public async Task TextMateCte_AppendAsync_ContinuesRuleStateAndPaintsSameAsFullReflow()
+    {
+        // The appended lines start inside a block comment left open by the loaded text.
+        string first = string.Concat(Enumerable.Range(1, 20).Select(i => $"int v{i} = {i};\n")) + "/* open\n";
+        const string appended = "   still comment */\nclass A\n{\n    string s = \"x\"; // trailing\n}\n";
+        TextMateCte cte = MakeCSharpTextMateCte(4, $"Follow_{Guid.NewGuid():N}.cs");
+        await cte.SetDocumentAsync(first);
+        await cte.RenderAsync(Dpi96, null);
+
+        int pages = await cte.AppendAsync(appended, null);
+
+        Assert.True(pages > 0);
+        Assert.Equal(5, cte.TokenizedLineCount);
+        await AssertPaintsSameAsUncachedAsync(cte, pages, first + appended, 400);
+    }
+
+    [Fact]
+    public async Task TextMateCte_PaintPage_ReusesFontsAcrossPages()
+    {
+        TextMateCte cte = MakeCSharpTextMateCte(int.MaxValue, $"Paint_{Guid.NewGuid():N}.cs");
+        await cte.SetDocumentAsync(string.Concat(Enumerable.Repeat("int x = 1; // \"s\"\n", 20)));
+        int pages = await cte.RenderAsync(Dpi96, null);
+        Assert.True(pages > 1);
+
+        var first = new RecordingGraphicsContext();
+        cte.PaintPage(first, 1);
+        Assert.True(first.CreatedFontCount > 0);
+
+        // Later pages, and repaints, draw with the fonts (and run widths) from the first.
+        for (int page = 1; page <= pages; page++)
+        {
+            var again = new RecordingGraphicsContext();
+            cte.PaintPage(again, page);
+            Assert.Equal(0, again.CreatedFontCount);
+            if (page == 1)
+            {
+                Assert.Equal(first.DrawnStrings, again.DrawnStrings);
+            }
+        }
+    }
+
+    private static async Task AssertPaintsSameAsUncachedAsync(TextMateCte cte, int pages, string source,
+        float pageWidth)
+    {
+        TextMateCte fresh = MakeCSharpTextMateCte(int.MaxValue, $"Fresh_{Guid.NewGuid():N}.cs");
+        fresh.PageSize = new System.Drawing.SizeF(pageWidth, 100);
+        await fresh.SetDocumentAsync(source);
+        Assert.Equal(await fresh.RenderAsync(Dpi96, null), pages);
+        for (int page = 1; page <= pages; page++)
+        {
+            var expected = new RecordingGraphicsContext();
+            fresh.PaintPage(expected, page);
+            var actual = new RecordingGraphicsContext();
+            cte.PaintPage(actual, page);
+
+            Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+        }
+    }
+
+    private static TextMateCte MakeCSharpTextMateCte(int wrapChunkSize, string filePath = "Program.cs")
+    {
+        var cte = new TextMateCte
+        {
+            ContentSettings = new ContentSettings
+            {
+                Font = new Font { Family = "Courier New", Size = 10 },
+                LineNumbers = true,
+                TabSpaces = 4,
+                Style = "VisualStudioLight"
+            },
+            MeasurementContext = new RecordingGraphicsContext(),
+            PageSize = new System.Drawing.SizeF(400, 100),
+            WrapChunkSize = wrapChunkSize
+        };
+        cte.Configure("text/x-csharp", "C#", filePath);
+        return cte;
+    }
+
     [Fact]
     public async Task MarkdownCte_RendersRichMarkdown_Structurally()
     {
@@ -0,0 +1,107 @@
+using System.Text;
+using libvt100;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.Cte;
+
+/// <summary>
+///     Tests for the libvt100 <see cref="DynamicScreen" /> line storage that
+///     <see cref="ContentTypeEngines.AnsiCte" /> paints from: text and runs must stay consistent as
+///     characters are appended and overwritten.
+/// </summary>
+public class DynamicScreenTests
+{
+    private static DynamicScreen Decode(string text, int width = 80)
+    {
+        var screen = new DynamicScreen(width) { TabSpaces = 4 };
+        IAnsiDecoder vt100 = new AnsiDecoder();
+        vt100.Encoding = Encoding.UTF8;
+        vt100.Subscribe(screen);
+        vt100.Input(Encoding.UTF8.GetBytes(text));
+        return screen;
+    }
+
+    private static string[] RunTexts(DynamicScreen.Line line)
+    {
+        return [.. line.Runs.Select(r => line.Text[r.Start..(r.Start + r.Length)])];
+    }
+
+    [Fact]
+    public void Characters_CoalesceRunsWithTheSameAttributes()
+    {
+        DynamicScreen screen = Decode("\u001b[31mred\u001b[31m still red\u001b[0m plain\tx");
+        DynamicScreen.Line line = screen.Lines[0];
+
+        // The tab pads from column 19 to the next tab stop and gets a run of its own.
+        Assert.Equal("red still red plain x", line.Text);
+        Assert.Equal(["red still red", " plain", " ", "x"], RunTexts(line));
+        Assert.Equal(line.Text.Length, line.Runs.Sum(r => r.Length));
+    }
+
+    [Fact]
+    public void Indexer_OverwriteSplitsTheRunHoldingTheColumn()
+    {
+        DynamicScreen.Line line = Decode("\u001b[1mbold\u001b[0mplain").Lines[0];
+        Screen.Character plain = line[6];
+
+        line[1] = new Screen.Character('O') { Attributes = plain.Attributes };
+        line[4] = new Screen.Character('P') { Attributes = line[0].Attributes };
+        line[11] = new Screen.Character('!') { Attributes = plain.Attributes };
+
+        Assert.Equal("bOldPlain  !", line.Text);
+        Assert.Equal(["b", "O", "ld", "P", "lain", "  ", "!"], RunTexts(line));
+        Assert.True(line.RunFromColumn(2)!.Attributes.Bold);
+        Assert.False(line.RunFromColumn(1)!.Attributes.Bold);
+        Assert.True(line.RunFromColumn(4)!.Attributes.Bold);
+        Assert.Equal('l', line[5].Char);
+        Assert.Null(line.RunFromColumn(12));
+    }
+
+    [Fact]
+    public void LongLine_WrapsWithoutLosingCharacters()
+    {
+        var sb = new StringBuilder();
+        for (int i = 0; i < 5_000; i++)
+        {
+            sb.Append(i % 2 == 0 ? "\u001b[32m" : "\u001b[0m").Append((char)('a' + i % 26));
+        }
+
+        DynamicScreen screen = Decode(sb.ToString(), 100);
+
+        Assert.Equal(50, screen.Lines.Count);
+        Assert.All(screen.Lines, l => Assert.Equal(100, l.Text.Length));
+        Assert.All(screen.Lines, l => Assert.Equal(100, l.Runs.Count));
+        Assert.Equal('a', screen.Lines[26][0].Char);
+    }
+
+    [Fact]
+    public void Checkpoint_ResumesDecodingWithReleasedLines()
+    {
+        const string head = "one\n\u001b[1mtwo\nthree\n";
+        const string tail = "four\tx\n\u001b[0mfive";
+        var screen = new DynamicScreen(80) { TabSpaces = 4 };
+        IAnsiDecoder vt100 = new AnsiDecoder();
+        vt100.Subscribe(screen);
+        vt100.Input(head.AsSpan());
+
+        DynamicScreen.Checkpoint checkpoint = screen.CreateCheckpoint();
+        Assert.NotNull(checkpoint);
+        Assert.Equal(3, checkpoint.Line);
+        Assert.Equal(3, screen.ReleaseLines(10));
+        Assert.Equal(3, screen.FirstLine);
+        vt100.Input(tail.AsSpan());
+
+        var resumed = new DynamicScreen(80, checkpoint) { TabSpaces = 4 };
+        IAnsiDecoder resumedDecoder = new AnsiDecoder();
+        resumedDecoder.Subscribe(resumed);
+        resumedDecoder.Input(tail.AsSpan());
+
+        Assert.Equal(screen.FirstLine, resumed.FirstLine);
+        Assert.Equal(screen.Lines.Select(l => (l.Text, l.LineNumber)),
+            resumed.Lines.Select(l => (l.Text, l.LineNumber)));
+        Assert.Equal(screen.Lines.SelectMany(RunTexts), resumed.Lines.SelectMany(RunTexts));
+        Assert.True(resumed.Lines[0].Runs[0].Attributes.Bold);
+        Assert.False(resumed.Lines[1].Runs[0].Attributes.Bold);
+        Assert.Null(resumed.CreateCheckpoint());
+    }
+}
@@ -0,0 +1,89 @@
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.ContentTypeEngines;
+using WinPrint.Core.UnitTests.TestSupport;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.Cte;
+
+/// <summary>
+///     Tests for <see cref="GlyphAdvanceWrapper" />, the per-glyph advance wrap engine behind
+///     <see cref="TextCte" />. The recording context is fixed-pitch (10 units per char), so a 100-unit
+///     wide line fits exactly 10 chars.
+/// </summary>
+public class GlyphAdvanceWrapperTests
+{
+    private static GlyphAdvanceWrapper MakeWrapper(float maxWidth = 100)
+    {
+        var g = new RecordingGraphicsContext();
+        IGraphicsFont font = g.CreateFont("Courier New", 10, GraphicsFontStyle.Regular, GraphicsFontUnit.Pixel);
+        return new GlyphAdvanceWrapper(g, font, maxWidth, g.LineHeight);
+    }
+
+    [Fact]
+    public void Wrap_SplitsLongLine_FirstSegmentKeepsLineNumber()
+    {
+        GlyphAdvanceWrapper wrapper = MakeWrapper();
+        var wrapped = new List<WrappedLine>();
+
+        wrapper.Wrap(new string('a', 25), 7, wrapped);
+
+        Assert.True(wrapper.IsFixedPitch);
+        Assert.Equal(3, wrapped.Count);
+        Assert.Equal(new string('a', 10), wrapped[0].Text);
+        Assert.Equal(7, wrapped[0].NonWrappedLineNumber);
+        Assert.Equal(new string('a', 5), wrapped[2].Text);
+        Assert.Equal(0, wrapped[1].NonWrappedLineNumber);
+        Assert.Equal(0, wrapped[2].NonWrappedLineNumber);
+    }
+
+    [Fact]
+    public void Wrap_EmptyLine_AddsOneEmptyLine()
+    {
+        GlyphAdvanceWrapper wrapper = MakeWrapper();
+        var wrapped = new List<WrappedLine>();
+
+        wrapper.Wrap(string.Empty, 1, wrapped);
+
+        WrappedLine line = Assert.Single(wrapped);
+        Assert.Equal(string.Empty, line.Text);
+        Assert.Equal(1, line.NonWrappedLineNumber);
+    }
+
+    [Fact]
+    public void Wrap_NonAsciiLine_UsesPrefixScan_AndMatchesFixedPitchResult()
+    {
+        GlyphAdvanceWrapper wrapper = MakeWrapper();
+        var ascii = new List<WrappedLine>();
+        var accented = new List<WrappedLine>();
+
+        wrapper.Wrap(new string('e', 23), 1, ascii);
+        wrapper.Wrap(new string('é', 23), 1, accented);
+
+        Assert.Equal(ascii.Select(l => l.Text.Length), accented.Select(l => l.Text.Length));
+    }
+
+    [Fact]
+    public void FitChars_NeverSplitsSurrogatePair()
+    {
+        // Each emoji is two UTF-16 chars (20 units in the fixed-pitch model); 9 'a's leave 10 units,
+        // which is not enough for the pair, so the break must fall before it.
+        GlyphAdvanceWrapper wrapper = MakeWrapper();
+
+        int fit = wrapper.FitChars(new string('a', 9) + "\U0001F600", 0);
+
+        Assert.Equal(9, fit);
+    }
+
+    [Fact]
+    public void Wrap_MeasuresEachDistinctGlyphOnce()
+    {
+        GlyphAdvanceWrapper wrapper = MakeWrapper();
+        int probeGlyphs = wrapper.MeasuredGlyphCount;
+
+        var wrapped = new List<WrappedLine>();
+        wrapper.Wrap(string.Concat(Enumerable.Repeat("äöü", 10_000)), 1, wrapped);
+
+        Assert.Equal(probeGlyphs + 3, wrapper.MeasuredGlyphCount);
+        Assert.Equal(3_000, wrapped.Count);
+    }
+}
@@ -83,4 +83,26 @@ public class MarkdownCteConcurrencyTests
             Assert.True(count == 1, $"expected exactly one '{marker}', found {count}");
         }
     }
+
+    [Fact]
+    public async Task MermaidPreload_RendersDiagramsConcurrently_OncePerDistinctSource()
+    {
+        MarkdownCte cte = MakeCte();
+        var renderer = new DelayingMermaidRenderer(FakePng, 100);
+        cte.MermaidRenderer = renderer;
+
+        var sb = new System.Text.StringBuilder();
+        for (int i = 0; i < 6; i++)
+        {
+            // Each diagram appears twice; the repeat must not render again.
+            string fence = $"```mermaid\ngraph TD\n    A{i} --> B{i}\n```\n\n";
+            sb.Append(fence).Append(fence);
+        }
+
+        Assert.True(await cte.SetDocumentAsync(sb.ToString()));
+        Assert.True(await cte.RenderAsync(Dpi96, null) >= 1);
+
+        Assert.Equal(6, renderer.Calls);
+        Assert.True(renderer.MaxConcurrent > 1, $"diagrams rendered one at a time ({renderer.MaxConcurrent})");
+    }
 }
@@ -0,0 +1,67 @@
+using WinPrint.Core.ContentTypeEngines;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.Cte;
+
+public class MarkdownResourceCacheTests
+{
+    private static string UniqueKey()
+    {
+        // The cache is process-wide; keep tests from seeing each other's entries.
+        return "test:" + Guid.NewGuid().ToString("N");
+    }
+
+    [Fact]
+    public async Task GetOrLoadAsync_LoadsOnce_ThenHits()
+    {
+        string key = UniqueKey();
+        int loads = 0;
+        Task<byte[]?> Load()
+        {
+            Interlocked.Increment(ref loads);
+            return Task.FromResult<byte[]?>([1, 2, 3]);
+        }
+
+        (byte[]? first, bool firstHit) = await MarkdownResourceCache.GetOrLoadAsync(key, Load);
+        (byte[]? second, bool secondHit) = await MarkdownResourceCache.GetOrLoadAsync(key, Load);
+
+        Assert.False(firstHit);
+        Assert.True(secondHit);
+        Assert.Same(first, second);
+        Assert.Equal(1, loads);
+    }
+
+    [Fact]
+    public async Task GetOrLoadAsync_ConcurrentCallers_ShareOneLoad()
+    {
+        string key = UniqueKey();
+        int loads = 0;
+        async Task<byte[]?> Load()
+        {
+            Interlocked.Increment(ref loads);
+            await Task.Delay(50);
+            return [42];
+        }
+
+        (byte[]? Bytes, bool Hit)[] results = await Task.WhenAll(
+            Enumerable.Range(0, 8).Select(_ => Task.Run(() => MarkdownResourceCache.GetOrLoadAsync(key, Load))));
+
+        Assert.Equal(1, loads);
+        Assert.Equal(7, results.Count(r => r.Hit));
+        Assert.All(results, r => Assert.Equal([42], r.Bytes!));
+    }
+
+    [Fact]
+    public async Task GetOrLoadAsync_DoesNotKeepFailedLoads()
+    {
+        string key = UniqueKey();
+
+        (byte[]? failed, _) = await MarkdownResourceCache.GetOrLoadAsync(key, () => Task.FromResult<byte[]?>(null));
+        (byte[]? retried, bool hit) =
+            await MarkdownResourceCache.GetOrLoadAsync(key, () => Task.FromResult<byte[]?>([7]));
+
+        Assert.Null(failed);
+        Assert.False(hit);
+        Assert.Equal([7], retried!);
+    }
+}
@@ -0,0 +1,77 @@
+using System.Text;
+using WinPrint.Core.ContentTypeEngines.Html;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.Cte;
+
+/// <summary>
+///     Tests for the <see cref="MhtmlArchive" /> index: parts are decoded only when resolved, and decoded
+///     resources are cached up to the archive's capacity.
+/// </summary>
+public class MhtmlArchiveTests
+{
+    private static string Archive(params (string Location, byte[] Bytes)[] images)
+    {
+        var sb = new StringBuilder();
+        sb.Append("MIME-Version: 1.0\r\n")
+            .Append("Content-Type: multipart/related; boundary=\"B\"\r\n\r\n")
+            .Append("--B\r\n")
+            .Append("Content-Type: text/html; charset=utf-8\r\n")
+            .Append("Content-Transfer-Encoding: quoted-printable\r\n\r\n")
+            .Append("<p>Hello=20archive</p>\r\n");
+        for (int i = 0; i < images.Length; i++)
+        {
+            sb.Append("--B\r\n")
+                .Append("Content-Type: image/png\r\n")
+                .Append("Content-Transfer-Encoding: base64\r\n")
+                .Append($"Content-ID: <img{i}@test>\r\n")
+                .Append($"Content-Location: {images[i].Location}\r\n\r\n")
+                .Append(Convert.ToBase64String(images[i].Bytes, Base64FormattingOptions.InsertLineBreaks))
+                .Append("\r\n");
+        }
+
+        return sb.Append("--B--\r\n").ToString();
+    }
+
+    [Fact]
+    public void Parse_IndexesParts_AndDecodesOnlyTheRootHtml()
+    {
+        MhtmlArchive? archive = MhtmlArchive.Parse(Archive(("http://x/a.png", new byte[100])));
+
+        Assert.NotNull(archive);
+        Assert.Equal(2, archive.PartCount);
+        Assert.Equal("<p>Hello archive</p>\r\n", archive.Html);
+        Assert.Equal(0, archive.CachedBytes);
+    }
+
+    [Fact]
+    public void Resolve_DecodesByLocationOrContentId()
+    {
+        byte[] image = [.. Enumerable.Range(0, 300).Select(i => (byte)i)];
+        MhtmlArchive archive = MhtmlArchive.Parse(Archive(("http://x/a.png", image)))!;
+
+        Assert.Equal(image, archive.Resolve("http://x/a.png"));
+        Assert.Same(archive.Resolve("http://x/a.png"), archive.Resolve("cid:<img0@test>"));
+        Assert.Equal(image.Length, archive.CachedBytes);
+        Assert.Null(archive.Resolve("http://x/missing.png"));
+    }
+
+    [Fact]
+    public void Resolve_EvictsLeastRecentlyUsed_WhenOverCapacity()
+    {
+        MhtmlArchive archive = MhtmlArchive.Parse(
+            Archive(("a", new byte[400]), ("b", new byte[400]), ("c", new byte[400]), ("big", new byte[2000])),
+            cacheCapacity: 1000)!;
+
+        byte[] a = archive.Resolve("a")!;
+        archive.Resolve("b");
+        Assert.Same(a, archive.Resolve("a"));
+        archive.Resolve("c");
+
+        // "b" was least recently used; "a" stays cached. Parts larger than the cache are never cached.
+        Assert.Equal(800, archive.CachedBytes);
+        Assert.Same(a, archive.Resolve("a"));
+        Assert.Equal(2000, archive.Resolve("big")!.Length);
+        Assert.Equal(800, archive.CachedBytes);
+    }
+}
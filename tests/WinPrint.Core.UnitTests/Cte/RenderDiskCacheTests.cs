@@ -0,0 +1,106 @@
+using WinPrint.Core.ContentTypeEngines;
+using WinPrint.Core.UnitTests.TestSupport;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.Cte;
+
+public sealed class RenderDiskCacheTests : IDisposable
+{
+    private readonly string _directory =
+        Path.Combine(Path.GetTempPath(), "winprint-render-cache-" + Guid.NewGuid().ToString("N"));
+
+    public void Dispose()
+    {
+        if (Directory.Exists(_directory))
+        {
+            Directory.Delete(_directory, true);
+        }
+    }
+
+    [Fact]
+    public async Task WriteThenRead_RoundTripsDiagramsAndRemoteImages()
+    {
+        var cache = new RenderDiskCache(_directory);
+        byte[] png = [1, 2, 3, 4, 5];
+
+        await cache.WriteAsync("mermaid:builtin:ABC", png);
+        await cache.WriteAsync("url:https://example.com/a.png", [9]);
+
+        Assert.Equal(png, await cache.TryReadAsync("mermaid:builtin:ABC"));
+        Assert.Equal([9], (await cache.TryReadAsync("url:https://example.com/a.png"))!);
+        Assert.Null(await cache.TryReadAsync("mermaid:builtin:DEF"));
+        Assert.EndsWith(".png", cache.GetPath("mermaid:builtin:ABC"), StringComparison.Ordinal);
+
+        // Local images are already on disk and aren't stored again.
+        Assert.Null(cache.GetPath("file:/docs/a.png|1|2"));
+    }
+
+    [Fact]
+    public async Task TryRead_DeletesCorruptFiles()
+    {
+        var cache = new RenderDiskCache(_directory);
+        await cache.WriteAsync("mermaid:builtin:ABC", [1, 2, 3, 4, 5]);
+        string path = cache.GetPath("mermaid:builtin:ABC")!;
+        byte[] file = await File.ReadAllBytesAsync(path);
+        file[^1] ^= 0xFF;
+        await File.WriteAllBytesAsync(path, file);
+
+        Assert.Null(await cache.TryReadAsync("mermaid:builtin:ABC"));
+        Assert.False(File.Exists(path));
+    }
+
+    [Fact]
+    public async Task Write_EvictsLeastRecentlyUsed_WhenOverCapacity()
+    {
+        // Each entry is 40 bytes of header (hash and time stored) plus 100 bytes of payload; three fit.
+        var cache = new RenderDiskCache(_directory, 450);
+        await cache.WriteAsync("mermaid:1", new byte[100]);
+        File.SetLastWriteTimeUtc(cache.GetPath("mermaid:1")!, DateTime.UtcNow.AddMinutes(-3));
+        await cache.WriteAsync("mermaid:2", new byte[100]);
+        File.SetLastWriteTimeUtc(cache.GetPath("mermaid:2")!, DateTime.UtcNow.AddMinutes(-2));
+        await cache.WriteAsync("mermaid:3", new byte[100]);
+        File.SetLastWriteTimeUtc(cache.GetPath("mermaid:3")!, DateTime.UtcNow.AddMinutes(-1));
+
+        // Reading refreshes an entry, so the oldest unread one goes first.
+        Assert.NotNull(await cache.TryReadAsync("mermaid:1"));
+        await cache.WriteAsync("mermaid:4", new byte[100]);
+
+        Assert.NotNull(await cache.TryReadAsync("mermaid:1"));
+        Assert.Null(await cache.TryReadAsync("mermaid:2"));
+        Assert.NotNull(await cache.TryReadAsync("mermaid:4"));
+    }
+
+    [Fact]
+    public async Task TryRead_FetchesRemoteImagesAgain_OnceOlderThanMaxUrlAge()
+    {
+        var clock = new ManualTimeProvider(new DateTimeOffset(2026, 1, 1, 0, 0, 0, TimeSpan.Zero));
+        var cache = new RenderDiskCache(_directory, maxUrlAge: TimeSpan.FromHours(1), timeProvider: clock);
+        await cache.WriteAsync("url:https://example.com/a.png", [1]);
+        await cache.WriteAsync("mermaid:builtin:ABC", [2]);
+
+        clock.UtcNow += TimeSpan.FromMinutes(59);
+        Assert.NotNull(await cache.TryReadAsync("url:https://example.com/a.png"));
+
+        clock.UtcNow += TimeSpan.FromMinutes(2);
+        Assert.Null(await cache.TryReadAsync("url:https://example.com/a.png"));
+        Assert.False(File.Exists(cache.GetPath("url:https://example.com/a.png")));
+
+        // Diagrams are keyed by their source and renderer, so they never go stale.
+        Assert.NotNull(await cache.TryReadAsync("mermaid:builtin:ABC"));
+    }
+
+    [Fact]
+    public async Task Write_ReplacingAnEntry_DoesNotCountItTwice()
+    {
+        // Each entry is 140 bytes; rewriting one many times must not push the other out.
+        var cache = new RenderDiskCache(_directory, 300);
+        await cache.WriteAsync("mermaid:1", new byte[100]);
+        for (int i = 0; i < 5; i++)
+        {
+            await cache.WriteAsync("mermaid:2", new byte[100]);
+        }
+
+        Assert.NotNull(await cache.TryReadAsync("mermaid:1"));
+        Assert.NotNull(await cache.TryReadAsync("mermaid:2"));
+    }
+}
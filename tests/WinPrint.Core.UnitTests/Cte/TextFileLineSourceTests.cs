@@ -0,0 +1,353 @@
+using System.Text;
+using WinPrint.Core.ContentTypeEngines;
+using WinPrint.Core.Models;
+using WinPrint.Core.UnitTests.TestSupport;
+using Xunit;
+using Font = WinPrint.Core.Models.Font;
+
+namespace WinPrint.Core.UnitTests.Cte;
+
+/// <summary>
+///     Tests for <see cref="TextFileLineSource" /> (streaming large-file loading) and for
+///     <see cref="TextCte" />, <see cref="TextMateCte" /> and <see cref="AnsiCte" /> rendering from it:
+///     streamed output must match the in-memory path exactly.
+/// </summary>
+public class TextFileLineSourceTests
+{
+    private static PrintResolution Dpi96 => new() { X = 96, Y = 96 };
+
+    private static string WriteTempFile(string text, Encoding encoding)
+    {
+        string file = Path.Combine(Path.GetTempPath(), $"wp_stream_{Guid.NewGuid():N}.txt");
+        File.WriteAllText(file, text, encoding);
+        return file;
+    }
+
+    private static List<string> ReadLinesWithStringReader(string text)
+    {
+        var lines = new List<string>();
+        using var reader = new StringReader(text);
+        while (reader.ReadLine() is { } line)
+        {
+            lines.Add(line);
+        }
+
+        return lines;
+    }
+
+    [Theory]
+    [InlineData("utf-8")]
+    [InlineData("utf-16")]
+    [InlineData("utf-16BE")]
+    public void ReadLines_MatchesStringReader_ForMixedLineEndings(string encodingName)
+    {
+        string text = "one\r\ntwo\nthree\rfour\r\n\r\nsixé中\r";
+        Encoding encoding = Encoding.GetEncoding(encodingName);
+        string file = WriteTempFile(text, encoding);
+        try
+        {
+            using var source = new TextFileLineSource(file, encoding);
+
+            Assert.Equal(ReadLinesWithStringReader(text), source.ReadLines());
+            Assert.Equal(6, source.CountLines());
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    [Fact]
+    public void ReadLines_FromLine_SeeksThroughCheckpoints()
+    {
+        int count = TextFileLineSource.CheckpointInterval * 3 + 17;
+        string text = string.Join("\n", Enumerable.Range(0, count).Select(i => $"line {i}"));
+        string file = WriteTempFile(text, new UTF8Encoding(false));
+        try
+        {
+            using var source = new TextFileLineSource(file, Encoding.UTF8);
+            Assert.Equal(count, source.CountLines());
+
+            int first = TextFileLineSource.CheckpointInterval * 2 + 5;
+            Assert.Equal(["line " + first, "line " + (first + 1)], source.ReadLines(first).Take(2));
+            Assert.Empty(source.ReadLines(count));
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    [Fact]
+    public void ReadLines_LineLongerThanBuffer_IsReturnedWhole()
+    {
+        string longLine = new('x', 200_000);
+        string file = WriteTempFile($"a\r\n{longLine}\r\nb", new UTF8Encoding(false));
+        try
+        {
+            using var source = new TextFileLineSource(file, Encoding.UTF8);
+
+            Assert.Equal(["a", longLine, "b"], source.ReadLines());
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    [Fact]
+    public void ReadBytes_SkipsPreamble()
+    {
+        string file = WriteTempFile("\u001b[31mred", new UTF8Encoding(true));
+        try
+        {
+            using var source = new TextFileLineSource(file, Encoding.UTF8);
+
+            Assert.Equal(3, source.ContentStart);
+            Assert.Equal("\u001b[31mred"u8.ToArray(), source.ReadBytes(4).SelectMany(b => b));
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task TextCte_StreamedDocument_PaintsSameAsInMemory(bool lineNumbers)
+    {
+        // Long lines wrap across page boundaries and form feeds pad to the next page, so page anchors
+        // have to carry both a wrapped-line offset and the form feed padding base.
+        var sb = new StringBuilder();
+        for (int i = 0; i < 200; i++)
+        {
+            sb.Append(i % 7 == 0 ? new string((char)('a' + i % 26), 35) : $"line {i}");
+            sb.Append(i % 31 == 0 ? "\fafter\n" : "\n");
+        }
+
+        string text = sb.ToString();
+        string file = WriteTempFile(text, new UTF8Encoding(false));
+        try
+        {
+            TextCte inMemory = MakeTextCte(lineNumbers);
+            await inMemory.SetDocumentAsync(text);
+            int expectedPages = await inMemory.RenderAsync(Dpi96, null);
+
+            using var source = new TextFileLineSource(file, Encoding.UTF8);
+            TextCte streamed = MakeTextCte(lineNumbers);
+            await streamed.SetDocumentSourceAsync(source);
+            Assert.Null(streamed.Document);
+            int pages = await streamed.RenderAsync(Dpi96, null);
+
+            Assert.Equal(expectedPages, pages);
+            for (int page = pages; page >= 1; page--)
+            {
+                var expected = new RecordingGraphicsContext();
+                inMemory.PaintPage(expected, page);
+                var actual = new RecordingGraphicsContext();
+                streamed.PaintPage(actual, page);
+
+                Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+            }
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    [Fact]
+    public async Task TextMateCte_StreamedDocument_PaintsSameAsInMemory()
+    {
+        // Block comments span page boundaries, so a page re-tokenized from its anchor has to start in the
+        // rule state the reflow had there; long lines wrap across pages and form feeds pad to the next one.
+        var sb = new StringBuilder();
+        for (int i = 0; i < 200; i++)
+        {
+            sb.Append(i % 13 == 0 ? "/* comment\n   continued\n   still */ " : string.Empty);
+            sb.Append(i % 7 == 0 ? $"string s{i} = \"{new string((char)('a' + i % 26), 60)}\";" : $"int v{i} = {i};");
+            sb.Append(i % 31 == 0 ? "\fint after = 0;\n" : "\n");
+        }
+
+        string text = sb.ToString();
+        string file = WriteTempFile(text, new UTF8Encoding(false));
+        try
+        {
+            TextMateCte inMemory = MakeCSharpTextMateCte($"Memory_{Guid.NewGuid():N}.cs");
+            await inMemory.SetDocumentAsync(text);
+            int expectedPages = await inMemory.RenderAsync(Dpi96, null);
+
+            using var source = new TextFileLineSource(file, Encoding.UTF8);
+            TextMateCte streamed = MakeCSharpTextMateCte(file);
+            await streamed.SetDocumentSourceAsync(source);
+            int pages = await streamed.RenderAsync(Dpi96, null);
+
+            Assert.Equal(expectedPages, pages);
+            for (int page = pages; page >= 1; page--)
+            {
+                var expected = new RecordingGraphicsContext();
+                inMemory.PaintPage(expected, page);
+                var actual = new RecordingGraphicsContext();
+                streamed.PaintPage(actual, page);
+
+                Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+            }
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    private static TextMateCte MakeCSharpTextMateCte(string filePath)
+    {
+        var cte = new TextMateCte
+        {
+            ContentSettings = new ContentSettings
+            {
+                Font = new Font { Family = "Courier New", Size = 10 },
+                LineNumbers = true,
+                NewPageOnFormFeed = true,
+                TabSpaces = 4,
+                Style = "VisualStudioLight"
+            },
+            MeasurementContext = new RecordingGraphicsContext(),
+            PageSize = new System.Drawing.SizeF(400, 100),
+            WrapChunkSize = 8
+        };
+        cte.Configure("text/x-csharp", "C#", filePath);
+        return cte;
+    }
+
+    [Theory]
+    [InlineData(37)]
+    [InlineData(64 * 1024)]
+    public async Task AnsiCte_StreamedDocument_PaintsSameAsInMemory(int decodeChunkSize)
+    {
+        // Colors carry across line breaks and long lines wrap, so pages re-decoded from a checkpoint have to
+        // resume with the right attributes and line numbers.
+        var sb = new StringBuilder();
+        for (int i = 0; i < 150; i++)
+        {
+            sb.Append(i % 5 == 0 ? $"\u001b[3{i % 8}m" : string.Empty);
+            sb.Append(i % 9 == 0 ? new string((char)('a' + i % 26), 40) : $"line\t{i} é");
+            sb.Append(i % 11 == 0 ? "\u001b[0m\n" : "\n");
+        }
+
+        string text = sb.ToString();
+        string file = WriteTempFile(text, new UTF8Encoding(false));
+        try
+        {
+            AnsiCte inMemory = MakeAnsiCte(decodeChunkSize);
+            await inMemory.SetDocumentAsync(text);
+            int expectedPages = await inMemory.RenderAsync(Dpi96, null);
+
+            using var source = new TextFileLineSource(file, Encoding.UTF8);
+            AnsiCte streamed = MakeAnsiCte(decodeChunkSize);
+            await streamed.SetDocumentSourceAsync(source);
+            int pages = await streamed.RenderAsync(Dpi96, null);
+
+            Assert.Equal(expectedPages, pages);
+            Assert.Equal(pages, streamed.AvailablePages);
+
+            // In order (as printing does, continuing one decode), then backwards (restarting at checkpoints).
+            foreach (int page in Enumerable.Range(1, pages).Concat(Enumerable.Range(1, pages).Reverse()))
+            {
+                var expected = new RecordingGraphicsContext();
+                inMemory.PaintPage(expected, page);
+                var actual = new RecordingGraphicsContext();
+                streamed.PaintPage(actual, page);
+
+                Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+            }
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    [Theory]
+    [InlineData(37)]
+    [InlineData(64 * 1024)]
+    public async Task AnsiCte_StreamedDocument_CursorMovesUp_PaintsSameAsInMemory(int decodeChunkSize)
+    {
+        // Moving up to overwrite earlier lines reaches above chunk boundaries (and the checkpoints recorded at
+        // them), so a page decode can't simply start at the nearest checkpoint.
+        var sb = new StringBuilder();
+        for (int i = 0; i < 150; i++)
+        {
+            sb.Append($"row {i}\n");
+            if (i % 7 == 3)
+            {
+                sb.Append($"\u001b[2A\u001b[10C\u001b[3{i % 8}mup {i}\u001b[0m\u001b[2B\r");
+            }
+            else if (i % 13 == 5)
+            {
+                sb.Append($"\u001b[s\u001b[1A\u001b[12Csaved {i}\u001b[u");
+            }
+        }
+
+        string text = sb.ToString();
+        string file = WriteTempFile(text, new UTF8Encoding(false));
+        try
+        {
+            AnsiCte inMemory = MakeAnsiCte(decodeChunkSize);
+            await inMemory.SetDocumentAsync(text);
+            int expectedPages = await inMemory.RenderAsync(Dpi96, null);
+
+            using var source = new TextFileLineSource(file, Encoding.UTF8);
+            AnsiCte streamed = MakeAnsiCte(decodeChunkSize);
+            await streamed.SetDocumentSourceAsync(source);
+            int pages = await streamed.RenderAsync(Dpi96, null);
+
+            Assert.Equal(expectedPages, pages);
+            foreach (int page in Enumerable.Range(1, pages).Concat(Enumerable.Range(1, pages).Reverse()))
+            {
+                var expected = new RecordingGraphicsContext();
+                inMemory.PaintPage(expected, page);
+                var actual = new RecordingGraphicsContext();
+                streamed.PaintPage(actual, page);
+
+                Assert.Equal(expected.DrawnStrings, actual.DrawnStrings);
+            }
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
+    private static AnsiCte MakeAnsiCte(int decodeChunkSize)
+    {
+        return new AnsiCte
+        {
+            ContentSettings = new ContentSettings
+            {
+                Font = new Font { Family = "Courier New", Size = 10 },
+                LineNumbers = true,
+                TabSpaces = 4
+            },
+            MeasurementContext = new RecordingGraphicsContext(),
+            PageSize = new System.Drawing.SizeF(200, 100),
+            DecodeChunkSize = decodeChunkSize
+        };
+    }
+
+    private static TextCte MakeTextCte(bool lineNumbers)
+    {
+        return new TextCte
+        {
+            ContentSettings = new ContentSettings
+            {
+                Font = new Font { Family = "Courier New", Size = 10 },
+                LineNumbers = lineNumbers,
+                NewPageOnFormFeed = true,
+                TabSpaces = 4
+            },
+            MeasurementContext = new RecordingGraphicsContext(),
+            PageSize = new System.Drawing.SizeF(200, 100)
+        };
+    }
+}
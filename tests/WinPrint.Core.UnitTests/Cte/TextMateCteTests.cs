@@ -3,7 +3,9 @@ using Serilog.Sinks.XUnit;
 using System.Drawing;
 using System.Drawing.Printing;
 using System.Reflection;
+using TextMateSharp.Grammars;
 using TextMateSharp.Internal.Grammars;
+using TextMateSharp.Registry;
 using TextMateFontStyle = TextMateSharp.Themes.FontStyle;
 using ModelFont = WinPrint.Core.Models.Font;
 using WinPrint.Core.Abstractions;
@@ -141,4 +143,44 @@ public class TextMateCteTests
 
         Assert.Equal(ColorTranslator.FromHtml("#123456").ToArgb(), color.ToArgb());
     }
+
+    [Fact]
+    public void RegistryCacheReusesGrammarsAcrossDocumentsTest()
+    {
+        // The cache is process-wide; test classes run one at a time (xunit.runner.json), so nothing else
+        // returns a grammar to the pool while this runs.
+        TextMateRegistryCache.Clear();
+        const string scope = "source.cs";
+        (Registry? Registry, IGrammar? Grammar) first = TextMateRegistryCache.Rent(ThemeName.DarkPlus, scope);
+        Assert.NotNull(first.Grammar);
+        TextMateRegistryCache.Return(ThemeName.DarkPlus, scope, first);
+
+        Assert.Same(first.Grammar, TextMateRegistryCache.Rent(ThemeName.DarkPlus, scope).Grammar);
+
+        // Every registry of a theme reads grammars through the same options, so each is parsed once.
+        WinPrintRegistryOptions options = TextMateRegistryCache.GetOptions(ThemeName.DarkPlus);
+        Assert.Same(options, TextMateRegistryCache.GetOptions(ThemeName.DarkPlus));
+        Assert.Same(options.GetGrammar(scope), options.GetGrammar(scope));
+    }
+
+    [Fact]
+    public async Task WarmUpGrammarsLoadsOnlyGrammarsThisEngineRendersTest()
+    {
+        var settings = Settings.CreateDefaultSettings();
+        WinPrintServices.Current.Settings.CopyPropertiesFrom(settings);
+        TextMateRegistryCache.Clear();
+        List<string> contentTypes = [];
+
+        List<string> scopes = await TextMateCte.WarmUpGrammarsAsync(
+            ["a.cs", "b.cs", "notes.md", "page.html", "art.ans"],
+            contentType =>
+            {
+                contentTypes.Add(contentType);
+                return "DarkPlus";
+            });
+
+        // Markdown, HTML and ANSI files have engines of their own.
+        Assert.Equal(["source.cs"], scopes);
+        Assert.Equal(["text/x-csharp"], contentTypes);
+    }
 }
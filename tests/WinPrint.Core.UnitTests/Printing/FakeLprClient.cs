@@ -13,6 +13,7 @@ public sealed class FakeLprClient : ILprClient
     public string? SubmittedPrinter { get; private set; }
     public string? SubmittedDocument { get; private set; }
     public int SubmittedSheetCount { get; private set; }
+    public long SubmittedBytes { get; private set; }
     public int SubmitCallCount { get; private set; }
     public int ResolveCallCount { get; private set; }
 
@@ -39,13 +40,14 @@ public sealed class FakeLprClient : ILprClient
             Printers.Select(p => p.Name).ToList());
     }
 
-    public Task<PrintJobResult> SubmitAsync(byte[] pdf, string printerName, string documentName,
-        int sheetCount, CancellationToken cancellationToken = default)
+    public Task<PrintJobResult> SubmitAsync(Func<Stream, (int Sheets, long Bytes)> writePdf, string printerName,
+        string documentName, CancellationToken cancellationToken = default)
     {
-        SubmittedPdf = pdf;
+        using var stdin = new MemoryStream();
+        (SubmittedSheetCount, SubmittedBytes) = writePdf(stdin);
+        SubmittedPdf = stdin.ToArray();
         SubmittedPrinter = printerName;
         SubmittedDocument = documentName;
-        SubmittedSheetCount = sheetCount;
         SubmitCallCount++;
         return Task.FromResult(Result);
     }
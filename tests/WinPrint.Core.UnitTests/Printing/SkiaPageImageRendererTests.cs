@@ -0,0 +1,123 @@
+using SkiaSharp;
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.ContentTypeEngines;
+using WinPrint.Core.Models;
+using WinPrint.Core.Printing;
+using WinPrint.Core.Printing.Skia;
+using Xunit;
+using Font = WinPrint.Core.Models.Font;
+
+namespace WinPrint.Core.UnitTests.Printing;
+
+/// <summary>
+///     Verifies that <see cref="SkiaPageImageRenderer" /> yields pages in order, and identical to a sequential
+///     render, however many are rasterized at once (bitmaps are reused from page to page).
+/// </summary>
+public class SkiaPageImageRendererTests
+{
+    [Fact]
+    public async Task RenderPagesAsync_Concurrent_MatchesSequentialInPageOrder()
+    {
+        var setup = new PrintPageSetup { PaperWidth = 200, PaperHeight = 100 };
+        List<(int PageNumber, Action<IGraphicsContext, int> Render)> pages =
+        [
+            .. Enumerable.Range(1, 9).Select(n => (n, (Action<IGraphicsContext, int>)DrawPage))
+        ];
+
+        List<byte[]> sequential = await RenderAsync(pages, setup, 1);
+        List<byte[]> concurrent = await RenderAsync(pages, setup, 3);
+
+        Assert.Equal(9, sequential.Count);
+        Assert.Equal(sequential, concurrent);
+        for (int i = 0; i < sequential.Count; i++)
+        {
+            // Each page's bar is as wide as its number, so order (and stale pixels) would show.
+            using SKBitmap bitmap = SKBitmap.Decode(concurrent[i]);
+            Assert.Equal(new SKColor(0, 0, 0), bitmap.GetPixel((i + 1) * 10 - 5, 10));
+            Assert.Equal(SKColors.White, bitmap.GetPixel((i + 1) * 10 + 5, 10));
+        }
+    }
+
+    [Fact]
+    public async Task RenderPagesAsync_Html_ConcurrencyAsPrinted_MatchesSequential()
+    {
+        // HtmlCte paints through one shared graphics adapter, so it must not ask for concurrent painting and the
+        // renderer's default must be sequential; painting it the way a print job would matches a plain loop.
+        string html = "<html><body>" +
+                      string.Concat(Enumerable.Range(1, 120).Select(n => $"<p>Paragraph <b>{n}</b> of the test.</p>")) +
+                      "</body></html>";
+        var cte = new HtmlCte
+        {
+            ContentSettings = new ContentSettings { Font = new Font { Family = "Arial", Size = 12 } },
+            MeasurementContext = SkiaGraphicsContext.CreateMeasurementContext(),
+            PageSize = new System.Drawing.SizeF(400, 300)
+        };
+        Assert.True(await cte.SetDocumentAsync(html));
+        int pageCount = await cte.RenderAsync(new PrintResolution { X = 96, Y = 96 }, null);
+        Assert.True(pageCount > 3, $"expected several pages, got {pageCount}");
+        Assert.False(cte.SupportsConcurrentPainting);
+
+        var setup = new PrintPageSetup { PaperWidth = 400, PaperHeight = 300 };
+        List<(int PageNumber, Action<IGraphicsContext, int> Render)> pages =
+        [
+            .. Enumerable.Range(1, pageCount).Select(n => (n, (Action<IGraphicsContext, int>)cte.PaintPage))
+        ];
+
+        List<byte[]> sequential = await RenderAsync(pages, setup, 1);
+        List<byte[]> printed = [];
+        await foreach (byte[] png in SkiaPageImageRenderer.RenderPagesAsync(pages, setup, 100f))
+        {
+            printed.Add(png);
+        }
+
+        Assert.Equal(pageCount, sequential.Count);
+        Assert.Equal(sequential, printed);
+    }
+
+    [Fact]
+    public async Task RenderPagesAsync_InMemoryText_ConcurrentPainting_MatchesSequential()
+    {
+        var cte = new TextCte
+        {
+            ContentSettings = new ContentSettings
+            {
+                Font = new Font { Family = "Courier New", Size = 10 },
+                LineNumbers = true,
+                TabSpaces = 4
+            },
+            MeasurementContext = SkiaGraphicsContext.CreateMeasurementContext(),
+            PageSize = new System.Drawing.SizeF(400, 300)
+        };
+        Assert.True(await cte.SetDocumentAsync(
+            string.Join('\n', Enumerable.Range(1, 300).Select(n => $"line {n}\twith a tab and some text"))));
+        int pageCount = await cte.RenderAsync(new PrintResolution { X = 96, Y = 96 }, null);
+        Assert.True(pageCount > 3, $"expected several pages, got {pageCount}");
+        Assert.True(cte.SupportsConcurrentPainting);
+
+        var setup = new PrintPageSetup { PaperWidth = 400, PaperHeight = 300 };
+        List<(int PageNumber, Action<IGraphicsContext, int> Render)> pages =
+        [
+            .. Enumerable.Range(1, pageCount).Select(n => (n, (Action<IGraphicsContext, int>)cte.PaintPage))
+        ];
+
+        Assert.Equal(await RenderAsync(pages, setup, 1), await RenderAsync(pages, setup, 4));
+    }
+
+    private static void DrawPage(IGraphicsContext g, int pageNumber)
+    {
+        using IGraphicsBrush black = g.CreateSolidBrush(GraphicsColor.FromRgb(0, 0, 0));
+        g.FillRectangle(black, 0, 0, pageNumber * 10, 20);
+    }
+
+    private static async Task<List<byte[]>> RenderAsync(
+        List<(int PageNumber, Action<IGraphicsContext, int> Render)> pages, PrintPageSetup setup, int concurrency)
+    {
+        List<byte[]> images = [];
+        await foreach (byte[] png in SkiaPageImageRenderer.RenderPagesAsync(pages, setup, 100f, concurrency))
+        {
+            images.Add(png);
+        }
+
+        return images;
+    }
+}
@@ -37,11 +37,64 @@ public class UnixPrintBackendTests
         Assert.Equal(1, lpr.SubmitCallCount);
         Assert.Equal("Office", lpr.SubmittedPrinter);
         Assert.Equal("report.txt", lpr.SubmittedDocument);
-        Assert.Equal(2, lpr.SubmittedSheetCount);
+        Assert.Equal(2, result.SheetsPrinted);
         Assert.NotNull(lpr.SubmittedPdf);
         Assert.Equal("%PDF-", Encoding.ASCII.GetString(lpr.SubmittedPdf!, 0, 5));
     }
 
+    [Fact]
+    public async Task UnixPrintJob_PaintsPagesAsTheyAreQueued_AndRecordsStats()
+    {
+        var lpr = new FakeLprClient { DefaultPrinter = "Office" };
+        var job = new UnixPrintJob(LetterSetup("Office"), "report.txt", lpr);
+        using var firstPainted = new ManualResetEventSlim();
+
+        job.Begin();
+        job.PrintPage(1, (ctx, _) =>
+        {
+            ctx.DrawLine(ctx.BlackPen, 0, 0, 100, 100);
+            firstPainted.Set();
+        });
+
+        // The first page is painted while the job is still open for more pages.
+        Assert.True(firstPainted.Wait(TimeSpan.FromSeconds(30)));
+        job.PrintPage(2, (ctx, _) => ctx.DrawLine(ctx.BlackPen, 0, 0, 50, 50));
+
+        PrintJobResult result = await job.EndAsync();
+
+        Assert.True(result.Success, result.Error);
+        Assert.Equal(2, result.SheetsPrinted);
+        PrintSpoolStats stats = Assert.NotNull(job.Stats);
+        Assert.Equal(2, stats.Pages);
+        Assert.Equal(lpr.SubmittedPdf!.Length, stats.Bytes);
+        Assert.InRange(stats.TimeToFirstByte, TimeSpan.Zero, stats.Elapsed);
+
+        // lpr was started with one page queued; the spool is tagged with what was finally written.
+        Assert.Equal(2, lpr.SubmittedSheetCount);
+        Assert.Equal(lpr.SubmittedPdf.Length, lpr.SubmittedBytes);
+    }
+
+    [Fact]
+    public void PrintSpoolStream_DestinationFailure_IsRethrownToTheWriter()
+    {
+        using var closed = new MemoryStream();
+        closed.Close();
+        using var spool = new PrintSpoolStream(closed, 1, System.Diagnostics.Stopwatch.GetTimestamp());
+
+        // The first chunk is accepted into the queue; the copy then fails and later writes surface it.
+        Assert.Throws<ObjectDisposedException>(() =>
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                spool.Write(new byte[PrintSpoolStream.ChunkSize]);
+            }
+
+            spool.Complete();
+        });
+        Assert.Equal(0, spool.BytesWritten);
+        Assert.Null(spool.TimeToFirstByte);
+    }
+
     [Fact]
     public async Task UnixPrintJob_WithNoPages_SucceedsWithoutSubmitting()
     {
@@ -157,6 +210,44 @@ public class UnixPrintBackendTests
         Assert.Equal("%PDF-", Encoding.ASCII.GetString(pdf, 0, 5));
     }
 
+    [Fact]
+    public void SkiaPdfRenderer_StreamsPagesBeforeTheLastIsPainted()
+    {
+        using var output = new MemoryStream();
+        long writtenBeforeLastPage = -1;
+        var pages = new List<(int, Action<IGraphicsContext, int>)>();
+        for (int i = 1; i <= 20; i++)
+        {
+            pages.Add((i, (ctx, n) =>
+            {
+                if (n == 20)
+                {
+                    writtenBeforeLastPage = output.Length;
+                }
+
+                ctx.FillRectangle(ctx.GrayBrush, n, n, 50, 50);
+            }));
+        }
+
+        SkiaPdfRenderer.Render(pages, LetterSetup(), output);
+
+        Assert.True(writtenBeforeLastPage > 0);
+        Assert.Equal("%PDF-", Encoding.ASCII.GetString(output.GetBuffer(), 0, 5));
+    }
+
+    [Fact]
+    public void SkiaPdfRenderer_OutputWriteFailure_IsRethrown()
+    {
+        var pages = new List<(int, Action<IGraphicsContext, int>)>
+        {
+            (1, (ctx, _) => ctx.DrawLine(ctx.BlackPen, 0, 0, 100, 100)),
+        };
+        using var closed = new MemoryStream();
+        closed.Close();
+
+        Assert.Throws<ObjectDisposedException>(() => SkiaPdfRenderer.Render(pages, LetterSetup(), closed));
+    }
+
     [Fact]
     public void ResolveFromInputs_SystemDefault_WithNoQueues_FailsWithActionableMessage()
     {
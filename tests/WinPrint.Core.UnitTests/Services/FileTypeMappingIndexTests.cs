@@ -0,0 +1,97 @@
+using System.Globalization;
+using WinPrint.Core.Models;
+using WinPrint.Core.Services;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace WinPrint.Core.UnitTests.Services;
+
+public class FileTypeMappingIndexTests : TestServicesBase
+{
+    public FileTypeMappingIndexTests(ITestOutputHelper output) : base(output)
+    {
+    }
+
+    private static FileTypeMapping SampleMapping()
+    {
+        return new FileTypeMapping
+        {
+            FilesAssociations = new Dictionary<string, string>
+            {
+                { "*.myphp", "text/x-PHP" },
+                { "*.orphan", "text/x-unknown" },
+                { "*Jenkinsfile", "text/x-groovy" },
+            },
+            ContentTypes =
+            [
+                new ContentType { Id = "text/x-php", Extensions = ["*.php", ".php3"] },
+                new ContentType { Id = "text/x-make", Extensions = ["Makefile", "*.mk"] },
+                new ContentType { Id = "text/x-shadow", Extensions = [".PHP", "GNUmakefile"] },
+            ]
+        };
+    }
+
+    [Fact]
+    public void FindByExtension_MatchesEitherPatternForm_IgnoringCase()
+    {
+        FileTypeMappingIndex index = FileTypeMappingIndex.Create(SampleMapping());
+
+        Assert.Equal("text/x-php", index.FindByExtension(".php"));
+        Assert.Equal("text/x-php", index.FindByExtension(".PHP3"));
+        Assert.Equal("text/x-make", index.FindByExtension(".mk"));
+        Assert.Null(index.FindByExtension(".xyz"));
+
+        // A FilesAssociations entry wins, resolves to the id as listed, and must name a known type.
+        Assert.Equal("text/x-php", index.FindByExtension(".MyPhp"));
+        Assert.Null(index.FindByExtension(".orphan"));
+    }
+
+    [Fact]
+    public void FindByFileName_UsesAssociationsThenExtensionEntries()
+    {
+        FileTypeMappingIndex index = FileTypeMappingIndex.Create(SampleMapping());
+
+        Assert.Equal("text/x-groovy", index.FindByFileName("Jenkinsfile"));
+        Assert.Equal("text/x-make", index.FindByFileName("makefile"));
+        Assert.Equal("text/x-shadow", index.FindByFileName("GNUmakefile"));
+        Assert.Null(index.FindByFileName("config"));
+    }
+
+    [Fact]
+    public void IsBuiltFrom_TracksReplacedCollections()
+    {
+        FileTypeMapping mapping = SampleMapping();
+        FileTypeMappingIndex index = FileTypeMappingIndex.Create(mapping);
+        Assert.True(index.IsBuiltFrom(mapping));
+
+        mapping.CopyPropertiesFrom(SampleMapping());
+
+        Assert.False(index.IsBuiltFrom(mapping));
+    }
+
+    [Fact]
+    public void FindByExtension_AgreesWithScanOfBundledMapping()
+    {
+        WinPrintServices.Current.Settings.CopyPropertiesFrom(Settings.CreateDefaultSettings());
+        FileTypeMapping mapping = WinPrintServices.Current.FileTypeMappingService.Load();
+        FileTypeMappingIndex index = FileTypeMappingIndex.Create(mapping);
+
+        IEnumerable<string> extensions = mapping.ContentTypes
+            .SelectMany(ct => ct.Extensions)
+            .Select(e => e.TrimStart('*'))
+            .Where(e => e.StartsWith('.') && e.Length > 1)
+            .Distinct();
+        foreach (string ext in extensions)
+        {
+            // The scan GetContentType did before the index (first content type listing the extension).
+            string? expected = mapping.FilesAssociations.TryGetValue("*" + ext.ToLowerInvariant(), out string? ct)
+                ? mapping.ContentTypes.FirstOrDefault(l => l.Id.Equals(ct, StringComparison.OrdinalIgnoreCase))?.Id
+                : mapping.ContentTypes.FirstOrDefault(l => l.Extensions.Any(i =>
+                    CultureInfo.InvariantCulture.CompareInfo.Compare(i, "*" + ext, CompareOptions.IgnoreCase) == 0 ||
+                    CultureInfo.InvariantCulture.CompareInfo.Compare(i, ext, CompareOptions.IgnoreCase) == 0))?.Id;
+
+            Assert.Equal(expected, index.FindByExtension(ext));
+            Assert.Equal(expected, index.FindByExtension(ext.ToUpperInvariant()));
+        }
+    }
+}
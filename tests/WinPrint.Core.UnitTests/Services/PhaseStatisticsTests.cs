@@ -0,0 +1,69 @@
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using WinPrint.Core.Services;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.Services;
+
+/// <summary>
+///     Tests for the <see cref="WinPrintDiagnostics" /> phase instrumentation and the
+///     <see cref="PhaseStatistics" /> breakdown behind <c>wp print --stats</c>. Other tests may record phases
+///     concurrently, so counts are lower bounds.
+/// </summary>
+public class PhaseStatisticsTests
+{
+    [Fact]
+    public void Snapshot_ReportsMeasuredPhasesInPipelineOrder()
+    {
+        using var stats = new PhaseStatistics();
+
+        using (WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.PaintPhase))
+        {
+        }
+
+        using (WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.ReflowPhase).SetContentType("text/plain"))
+        {
+            Thread.Sleep(10);
+        }
+
+        var snapshot = stats.Snapshot();
+        string[] phases = [.. snapshot.Select(s => s.Phase)];
+        Assert.True(Array.IndexOf(phases, WinPrintDiagnostics.ReflowPhase) <
+                    Array.IndexOf(phases, WinPrintDiagnostics.PaintPhase));
+
+        var reflow = snapshot.Single(s => s.Phase == WinPrintDiagnostics.ReflowPhase);
+        Assert.True(reflow.Count >= 1);
+        Assert.True(reflow.Max > TimeSpan.Zero && reflow.Total >= reflow.Max);
+        Assert.Contains(WinPrintDiagnostics.ReflowPhase, stats.Format());
+    }
+
+    [Fact]
+    public void StartPhase_TagsActivity()
+    {
+        string contentType = $"text/x-test-{Guid.NewGuid():N}";
+        var stopped = new ConcurrentBag<Activity>();
+        using var listener = new ActivityListener
+        {
+            ShouldListenTo = source => source.Name == WinPrintDiagnostics.SourceName,
+            Sample = (ref ActivityCreationOptions<ActivityContext> _) => ActivitySamplingResult.AllDataAndRecorded,
+            ActivityStopped = stopped.Add
+        };
+        ActivitySource.AddActivityListener(listener);
+
+        using (WinPrintDiagnostics.StartPhase(WinPrintDiagnostics.LoadPhase).SetContentType(contentType)
+                   .SetPages(3).SetBytes(1234))
+        {
+        }
+
+        Activity activity = stopped.Single(a => Equals(a.GetTagItem(WinPrintDiagnostics.ContentTypeTag), contentType));
+        Assert.Equal("winprint.load", activity.OperationName);
+        Assert.Equal(3, activity.GetTagItem(WinPrintDiagnostics.PagesTag));
+        Assert.Equal(1234L, activity.GetTagItem(WinPrintDiagnostics.BytesTag));
+    }
+
+    [Fact]
+    public void StartPhase_RejectsUnknownPhase()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() => WinPrintDiagnostics.StartPhase("typeset"));
+    }
+}
@@ -48,4 +48,15 @@ public class SheetResolutionTests
 
         Assert.Equal(Uuid.DefaultSheet1Up, sheet);
     }
+
+    [Fact]
+    public void FindSheet_ByKeyOrName_ReturnsSheet()
+    {
+        var settings = Settings.CreateDefaultSettings();
+        SheetSettings expected = settings.Sheets[Uuid.DefaultSheet1Up.ToString()];
+
+        Assert.Same(expected, SheetResolution.FindSheet(settings, Uuid.DefaultSheet1Up.ToString().ToUpperInvariant()));
+        Assert.Same(expected, SheetResolution.FindSheet(settings, "default 1-up"));
+        Assert.Null(SheetResolution.FindSheet(settings, "No Such Sheet"));
+    }
 }
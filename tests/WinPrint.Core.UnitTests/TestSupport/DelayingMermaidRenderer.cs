@@ -6,13 +6,35 @@ namespace WinPrint.Core.UnitTests.TestSupport;
 ///     <see cref="IMermaidRenderer" /> double that awaits a real delay before returning, forcing
 ///     <c>MarkdownCte.RenderAsync</c> to yield mid-build the way a network-backed renderer does.
 ///     Concurrency tests use this to open the window in which a second render can start while the
-///     first is still building.
+///     first is still building. Records how many renders ran and how many overlapped.
 /// </summary>
 public sealed class DelayingMermaidRenderer(byte[]? bytes, int delayMs) : IMermaidRenderer
 {
+    private int _active;
+    private int _calls;
+    private int _maxConcurrent;
+
+    public int Calls => _calls;
+
+    public int MaxConcurrent => _maxConcurrent;
+
     public async Task<byte[]?> RenderAsync(string diagram)
     {
-        await Task.Delay(delayMs);
-        return bytes;
+        Interlocked.Increment(ref _calls);
+        int active = Interlocked.Increment(ref _active);
+        int max;
+        while (active > (max = _maxConcurrent) && Interlocked.CompareExchange(ref _maxConcurrent, active, max) != max)
+        {
+        }
+
+        try
+        {
+            await Task.Delay(delayMs);
+            return bytes;
+        }
+        finally
+        {
+            Interlocked.Decrement(ref _active);
+        }
     }
 }
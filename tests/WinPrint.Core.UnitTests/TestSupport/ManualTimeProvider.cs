@@ -0,0 +1,15 @@
+namespace WinPrint.Core.UnitTests.TestSupport;
+
+/// <summary>
+///     <see cref="TimeProvider" /> double whose clock only moves when a test sets <see cref="UtcNow" />, so
+///     time-based expiry can be tested without waiting.
+/// </summary>
+public sealed class ManualTimeProvider(DateTimeOffset utcNow) : TimeProvider
+{
+    public DateTimeOffset UtcNow { get; set; } = utcNow;
+
+    public override DateTimeOffset GetUtcNow()
+    {
+        return UtcNow;
+    }
+}
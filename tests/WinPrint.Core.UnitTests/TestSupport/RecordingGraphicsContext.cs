@@ -40,6 +40,9 @@ public sealed class RecordingGraphicsContext : IGraphicsContext
     public List<RecordedRect> FilledRectangles { get; } = [];
     public List<RecordedImage> DrawnImages { get; } = [];
 
+    /// <summary>Number of <see cref="CreateFont" /> calls, for asserting font reuse.</summary>
+    public int CreatedFontCount { get; private set; }
+
     public float DpiX { get; }
     public float DpiY { get; }
     public bool IsDisplayUnit => true;
@@ -86,6 +89,7 @@ public sealed class RecordingGraphicsContext : IGraphicsContext
 
     public IGraphicsFont CreateFont(string family, float size, GraphicsFontStyle style, GraphicsFontUnit unit)
     {
+        CreatedFontCount++;
         return new RecordingGraphicsFont(family, size, style, unit, CharWidth, LineHeight);
     }
 
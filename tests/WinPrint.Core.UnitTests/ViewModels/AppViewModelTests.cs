@@ -160,6 +160,40 @@ public class AppViewModelTests : TestServicesBase
         }
     }
 
+    [Fact]
+    public async Task SettingsBurst_LoadedFile_CoalescesIntoOneReflow()
+    {
+        string file = Path.Combine(Path.GetTempPath(), $"wp_reflow_burst_{Guid.NewGuid():N}.txt");
+        await File.WriteAllTextAsync(file, "hello\nworld\n");
+
+        try
+        {
+            AppViewModel vm = CreateVm();
+            vm.LoadSheets();
+            vm.SetLandscape(false);
+            vm.SheetViewModel!.MeasurementContext = new RecordingGraphicsContext();
+            Assert.True(await vm.LoadFileAsync(file));
+
+            int completed = 0;
+            vm.ReflowCompleted += (_, _) => Interlocked.Increment(ref completed);
+
+            // Each paper size change starts a reflow that cancels the one before it; only the newest, the
+            // explicit reflow of the final settings, is laid out and published.
+            vm.SetPaperSize("Legal");
+            vm.SetPaperSize("Letter");
+            vm.SetPaperSize("Legal");
+            await vm.ReflowAsync().WaitAsync(TimeSpan.FromSeconds(5));
+
+            Assert.Equal(1, completed);
+            Assert.Equal(1400, vm.SheetViewModel.Bounds.Height);
+            Assert.False(vm.IsBusy);
+        }
+        finally
+        {
+            File.Delete(file);
+        }
+    }
+
     [Fact]
     public void SelectSheetByIndex_HooksLiveSettingsReference()
     {
@@ -0,0 +1,76 @@
+// Copyright Kindel, LLC - http://www.kindel.com
+// Published under the MIT License at https://github.com/tig/winprint
+
+using WinPrint.Core.ViewModels;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.ViewModels;
+
+public class ReflowSchedulerTests
+{
+    [Fact]
+    public async Task RunAsync_CancelsRunningReflow_AndStartsAfterItUnwinds()
+    {
+        var scheduler = new ReflowScheduler();
+        var started = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        bool firstUnwound = false;
+        Task<bool> first = scheduler.RunAsync(async token =>
+        {
+            started.SetResult();
+            try
+            {
+                await Task.Delay(Timeout.Infinite, token);
+            }
+            finally
+            {
+                firstUnwound = true;
+            }
+        }, TimeSpan.Zero);
+        await started.Task;
+
+        bool secondSawFirstUnwound = false;
+        Task<bool> second = scheduler.RunAsync(_ =>
+        {
+            secondSawFirstUnwound = firstUnwound;
+            return Task.CompletedTask;
+        }, TimeSpan.Zero);
+
+        Assert.False(await first.WaitAsync(TimeSpan.FromSeconds(5)));
+        Assert.True(await second.WaitAsync(TimeSpan.FromSeconds(5)));
+        Assert.True(secondSawFirstUnwound);
+    }
+
+    [Fact]
+    public async Task RunAsync_RequestsWithinTheDelay_RunOnce()
+    {
+        var scheduler = new ReflowScheduler();
+        int runs = 0;
+
+        Task<bool>[] requests = [.. Enumerable.Range(0, 5).Select(_ => scheduler.RunAsync(_ =>
+        {
+            Interlocked.Increment(ref runs);
+            return Task.CompletedTask;
+        }, TimeSpan.FromMilliseconds(50)))];
+        bool[] ran = await Task.WhenAll(requests).WaitAsync(TimeSpan.FromSeconds(5));
+
+        Assert.Equal(1, runs);
+        Assert.Equal([false, false, false, false, true], ran);
+    }
+
+    [Fact]
+    public async Task Cancel_SupersedesPendingReflow()
+    {
+        var scheduler = new ReflowScheduler();
+        bool ran = false;
+        Task<bool> pending = scheduler.RunAsync(_ =>
+        {
+            ran = true;
+            return Task.CompletedTask;
+        }, TimeSpan.FromSeconds(5));
+
+        scheduler.Cancel();
+
+        Assert.False(await pending.WaitAsync(TimeSpan.FromSeconds(5)));
+        Assert.False(ran);
+    }
+}
@@ -0,0 +1,118 @@
+using System.Text;
+using WinPrint.Core.Models;
+using WinPrint.Core.Services;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.ViewModels;
+
+/// <summary>
+///     Verifies the encoding detection in <see cref="SheetViewModel.LoadFileAsync" />, which examines only the
+///     first <see cref="Settings.EncodingDetectionBytes" /> of a file: byte order marks, UTF-8 whose prefix
+///     ends partway through a character, and files that aren't text at all.
+/// </summary>
+public sealed class SheetViewModelEncodingTests : IDisposable
+{
+    // The process-wide settings (and their EncodingDetectionBytes) as they were before the test replaced them.
+    private readonly Settings _savedSettings = new();
+
+    public SheetViewModelEncodingTests()
+    {
+        _savedSettings.CopyPropertiesFrom(WinPrintServices.Current.Settings);
+    }
+
+    public void Dispose()
+    {
+        WinPrintServices.Current.Settings.CopyPropertiesFrom(_savedSettings);
+    }
+
+    private static SheetViewModel CreateSheet()
+    {
+        Settings settings = Settings.CreateDefaultSettings();
+        WinPrintServices.Current.Settings.CopyPropertiesFrom(settings);
+
+        var sheet = new SheetViewModel();
+        sheet.SetSheet(settings.Sheets.Values.First());
+        return sheet;
+    }
+
+    private static async Task<SheetViewModel> LoadAsync(string path)
+    {
+        SheetViewModel sheet = CreateSheet();
+        Assert.True(await sheet.LoadFileAsync(path));
+        return sheet;
+    }
+
+    [Theory]
+    [InlineData("utf-8")]
+    [InlineData("utf-16")]
+    [InlineData("utf-16BE")]
+    [InlineData("utf-32")]
+    public async Task LoadFileAsync_ByteOrderMark_SelectsEncoding(string encodingName)
+    {
+        var encoding = Encoding.GetEncoding(encodingName);
+        const string text = "Grüße, 世界\nsecond line\n";
+        string path = Path.Combine(Path.GetTempPath(), $"wp-encoding-{Guid.NewGuid():N}.txt");
+        await File.WriteAllBytesAsync(path, [.. encoding.Preamble, .. encoding.GetBytes(text)]);
+        try
+        {
+            SheetViewModel sheet = await LoadAsync(path);
+
+            Assert.Equal(encoding.WebName, sheet.Encoding!.WebName);
+            Assert.Equal(text, sheet.ContentEngine!.Document);
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public async Task LoadFileAsync_Utf8CharacterAcrossDetectionPrefix_DecodesAsUtf8()
+    {
+        // The two-byte 'é' straddles the end of the examined prefix.
+        int prefix = Settings.CreateDefaultSettings().EncodingDetectionBytes;
+        string text = new string('a', prefix - 1) + "é\nafter the prefix: 世界\n";
+        string path = Path.Combine(Path.GetTempPath(), $"wp-encoding-{Guid.NewGuid():N}.txt");
+        await File.WriteAllTextAsync(path, text, new UTF8Encoding(false));
+        try
+        {
+            SheetViewModel sheet = await LoadAsync(path);
+
+            Assert.Equal(Encoding.UTF8.WebName, sheet.Encoding!.WebName);
+            Assert.Equal(text, sheet.ContentEngine!.Document);
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public async Task LoadFileAsync_BinaryFile_IsRejected()
+    {
+        // No byte order mark, NULs (so not UTF-8), bytes Latin-1 doesn't use, and no ANSI escapes.
+        byte[] bytes = new byte[8 * 1024];
+        new Random(1).NextBytes(bytes);
+        for (int i = 0; i < bytes.Length; i++)
+        {
+            bytes[i] = bytes[i] == 0x1B ? (byte)0 : bytes[i];
+        }
+
+        bytes[0] = 0x81;
+        bytes[1] = 0x00;
+        string path = Path.Combine(Path.GetTempPath(), $"wp-encoding-{Guid.NewGuid():N}.bin");
+        await File.WriteAllBytesAsync(path, bytes);
+        try
+        {
+            SheetViewModel sheet = CreateSheet();
+
+            InvalidOperationException ex =
+                await Assert.ThrowsAsync<InvalidOperationException>(() => sheet.LoadFileAsync(path));
+            Assert.Contains("could not determine the file encoding", ex.Message);
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.Models;
+using WinPrint.Core.Services;
+using WinPrint.Core.UnitTests.TestSupport;
+using WinPrint.Core.ViewModels;
+using Xunit;
+
+namespace WinPrint.Core.UnitTests.ViewModels;
+
+/// <summary>
+///     Verifies <see cref="SheetViewModel.FollowAsync" />, which tails a growing file: complete lines appended
+///     since the load are laid out after the existing pages, a partly written line waits until it is finished,
+///     a file that was truncated or rewritten is reported as such, and a document that can't be extended in
+///     place asks for a reload only once it has grown.
+/// </summary>
+public class SheetViewModelFollowTests
+{
+    private static async Task<SheetViewModel> LoadAsync(string path, long? streamingThresholdBytes = null)
+    {
+        Settings settings = Settings.CreateDefaultSettings();
+        if (streamingThresholdBytes is { } threshold)
+        {
+            settings.StreamingThresholdBytes = threshold;
+        }
+
+        WinPrintServices.Current.Settings.CopyPropertiesFrom(settings);
+
+        var sheet = new SheetViewModel { MeasurementContext = new RecordingGraphicsContext() };
+        sheet.SetSheet(settings.Sheets.Values.First());
+        Assert.True(await sheet.LoadFileAsync(path));
+        sheet.SetPrinterPageSettings(new PrintPageSetup());
+        await sheet.ReflowAsync();
+        return sheet;
+    }
+
+    [Fact]
+    public async Task FollowAsync_AppendsCompleteLines_AndWaitsForPartialOnes()
+    {
+        string path = Path.Combine(Path.GetTempPath(), $"wp-follow-{Guid.NewGuid():N}.log");
+        await File.WriteAllTextAsync(path, "first\nsecond\n");
+        try
+        {
+            SheetViewModel sheet = await LoadAsync(path);
+            Assert.Equal(FollowResult.Unchanged, await sheet.FollowAsync());
+
+            await File.AppendAllTextAsync(path, "third\nfour");
+            Assert.Equal(FollowResult.Appended, await sheet.FollowAsync());
+            Assert.Equal("first\nsecond\nthird\n", sheet.ContentEngine!.Document);
+
+            await File.AppendAllTextAsync(path, "th\n");
+            Assert.Equal(FollowResult.Appended, await sheet.FollowAsync());
+            Assert.Equal("first\nsecond\nthird\nfourth\n", sheet.ContentEngine.Document);
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public async Task FollowAsync_TruncatedOrRewrittenFile_IsTruncated()
+    {
+        string path = Path.Combine(Path.GetTempPath(), $"wp-follow-{Guid.NewGuid():N}.log");
+        await File.WriteAllTextAsync(path, "first\nsecond\n");
+        try
+        {
+            SheetViewModel sheet = await LoadAsync(path);
+
+            await File.WriteAllTextAsync(path, "rotated\n");
+            Assert.Equal(FollowResult.Truncated, await sheet.FollowAsync());
+
+            // Same length or longer, but not the text that was loaded.
+            await File.WriteAllTextAsync(path, "FIRST\nSECOND\nthird\n");
+            Assert.Equal(FollowResult.Truncated, await sheet.FollowAsync());
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Theory]
+    [InlineData(".log", 1L)]
+    [InlineData(".ans", 0L)]
+    public async Task FollowAsync_DocumentThatCantBeExtendedInPlace_AsksForReloadOnceItGrows(string extension,
+        long streamingThresholdBytes)
+    {
+        // Streamed from disk (over the threshold), or laid out by an engine that can't append (ANSI).
+        string path = Path.Combine(Path.GetTempPath(), $"wp-follow-{Guid.NewGuid():N}{extension}");
+        await File.WriteAllTextAsync(path, "first\nsecond\n");
+        try
+        {
+            SheetViewModel sheet = await LoadAsync(path, streamingThresholdBytes);
+            Assert.Equal(FollowResult.Unchanged, await sheet.FollowAsync());
+
+            await File.AppendAllTextAsync(path, "third\n");
+            Assert.Equal(FollowResult.ReloadRequired, await sheet.FollowAsync());
+
+            await File.WriteAllTextAsync(path, "rotated\n");
+            Assert.Equal(FollowResult.Truncated, await sheet.FollowAsync());
+        }
+        finally
+        {
+            File.Delete(path);
+            WinPrintServices.Current.Settings.CopyPropertiesFrom(Settings.CreateDefaultSettings());
+        }
+    }
+}
@@ -0,0 +1,48 @@
+using WinPrint.TUI.Graphics;
+using Xunit;
+using TgColor = Terminal.Gui.Drawing.Color;
+
+namespace WinPrint.TUI.UnitTests;
+
+public class PageRasterCacheTests
+{
+    private static PageRasterKey Key(int sheet, int version = 1)
+    {
+        return new PageRasterKey(sheet, 100, 100, 1f, version);
+    }
+
+    [Fact]
+    public void TryGet_MatchesTheWholeKey()
+    {
+        var cache = new PageRasterCache();
+        var pixels = new TgColor[10, 10];
+        cache.Add(Key(3), pixels);
+
+        Assert.True(cache.TryGet(Key(3), out TgColor[,] hit));
+        Assert.Same(pixels, hit);
+        Assert.False(cache.TryGet(Key(3, 2), out _));
+        Assert.False(cache.TryGet(Key(3) with { Scale = 2f }, out _));
+        Assert.False(cache.TryGet(Key(4), out _));
+    }
+
+    [Fact]
+    public void Add_EvictsLeastRecentlyUsed_ByPixels()
+    {
+        var cache = new PageRasterCache(300);
+        cache.Add(Key(0), new TgColor[10, 10]);
+        cache.Add(Key(1), new TgColor[10, 10]);
+        cache.Add(Key(2), new TgColor[10, 10]);
+        Assert.True(cache.TryGet(Key(0), out _));
+
+        cache.Add(Key(3), new TgColor[10, 10]);
+
+        Assert.Equal(3, cache.Count);
+        Assert.True(cache.TryGet(Key(0), out _));
+        Assert.False(cache.TryGet(Key(1), out _));
+
+        // A raster bigger than the budget isn't cached, and doesn't evict anything.
+        cache.Add(Key(4), new TgColor[20, 20]);
+        Assert.False(cache.TryGet(Key(4), out _));
+        Assert.Equal(3, cache.Count);
+    }
+}
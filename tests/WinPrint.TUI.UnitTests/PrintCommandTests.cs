@@ -1,4 +1,10 @@
+using System.Globalization;
+using System.Text;
+using System.Text.RegularExpressions;
 using Terminal.Gui.Cli;
+using WinPrint.Core.Abstractions;
+using WinPrint.Core.Models;
+using WinPrint.Core.Services;
 using WinPrint.TUI;
 using Xunit;
 
@@ -7,9 +13,9 @@ namespace WinPrint.TUI.UnitTests;
 /// <summary>
 ///     Verifies the headless <see cref="PrintCommand" /> (<c>wp print</c>): its CLI surface, the
 ///     no-file usage error, the <c>--what-if</c> path that counts sheets without touching a
-///     printer, and the <c>--pdf</c> validation rules (mutually exclusive with <c>--printer</c>,
-///     single input file). <c>--what-if</c> and the validation paths run cross-platform without
-///     print hardware; the real <c>--pdf</c> write is covered by
+///     printer, and the <c>--pdf</c> and <c>--watch</c> validation rules (mutually exclusive with
+///     <c>--printer</c> / <c>--what-if</c>, single input file), and that <c>--watch</c> prints each sheet of a
+///     growing file once. <c>--what-if</c> and the validation paths run cross-platform without print hardware; the real <c>--pdf</c> write is covered by
 ///     <c>PdfFilePrintJobTests</c> and by the Linux cups-pdf verification in issue #244.
 /// </summary>
 public class PrintCommandTests
@@ -34,6 +40,10 @@ public class PrintCommandTests
         Assert.Contains(command.Options, o => o.Name == "sheet");
         Assert.Contains(command.Options, o => o is { Name: "what-if", ShortName: "w" });
         Assert.Contains(command.Options, o => o.Name == "pdf");
+        Assert.Contains(command.Options, o => o.Name == "parallel");
+        Assert.Contains(command.Options, o => o.Name == "no-render-cache");
+        Assert.Contains(command.Options, o => o.Name == "stats");
+        Assert.Contains(command.Options, o => o.Name == "watch");
     }
 
     [Fact]
@@ -65,6 +75,124 @@ public class PrintCommandTests
         }
     }
 
+    [Fact]
+    public async Task Parallel_WhatIf_ReportsFilesInArgumentOrder()
+    {
+        // Differently sized files finish reflowing out of order; the report must not.
+        string[] paths =
+        [
+            .. Enumerable.Range(0, 4).Select(_ => Path.Combine(Path.GetTempPath(), $"wp-print-{Guid.NewGuid():N}.cs"))
+        ];
+        for (int i = 0; i < paths.Length; i++)
+        {
+            await File.WriteAllLinesAsync(paths[i],
+                Enumerable.Range(0, (paths.Length - i) * 200).Select(n => $"// line {n}"));
+        }
+
+        try
+        {
+            CommandResult result = await new PrintCommand()
+                .RunAsync(null!, null, Run(paths, ("what-if", "true"), ("parallel", "4")), CancellationToken.None);
+
+            Assert.Equal(CommandStatus.Ok, result.Status);
+            string[] lines = (result.Value as string)!.Split('\n', StringSplitOptions.TrimEntries);
+            Assert.Equal(paths.Length + 1, lines.Length);
+            for (int i = 0; i < paths.Length; i++)
+            {
+                Assert.StartsWith($"{paths[i]}: ", lines[i]);
+            }
+
+            Assert.StartsWith("4 file(s) would print", lines[^1]);
+        }
+        finally
+        {
+            foreach (string path in paths)
+            {
+                File.Delete(path);
+            }
+        }
+    }
+
+    [Fact]
+    public async Task Parallel_MixedFileTypes_MatchSequential_AndLeaveSharedSheetsAlone()
+    {
+        // Each file selects the sheet for its content type and applies --landscape to it; files prepared at the
+        // same time must not edit each other's sheets, or the shared definitions.
+        string[] paths =
+        [
+            .. Enumerable.Range(0, 4).Select(i =>
+                Path.Combine(Path.GetTempPath(), $"wp-print-{Guid.NewGuid():N}{(i % 2 == 0 ? ".cs" : ".md")}"))
+        ];
+        for (int i = 0; i < paths.Length; i++)
+        {
+            await File.WriteAllLinesAsync(paths[i], Enumerable.Range(0, 400).Select(n => i % 2 == 0
+                ? $"int Field{n} = {n}; // a line of code that is long enough to wrap in portrait, not landscape"
+                : $"## Heading {n}\n\nA paragraph of *markdown* text under heading {n}, long enough to wrap."));
+        }
+
+        Settings shared = WinPrintServices.Current.Settings;
+        Dictionary<string, bool> landscape = shared.Sheets.ToDictionary(s => s.Key, s => s.Value.Landscape);
+        try
+        {
+            CommandResult sequential = await new PrintCommand().RunAsync(null!, null,
+                Run(paths, ("what-if", "true"), ("landscape", "true")), CancellationToken.None);
+            CommandResult parallel = await new PrintCommand().RunAsync(null!, null,
+                Run(paths, ("what-if", "true"), ("landscape", "true"), ("parallel", "4")), CancellationToken.None);
+
+            Assert.Equal(CommandStatus.Ok, sequential.Status);
+            Assert.Equal(sequential.Value, parallel.Value);
+            Assert.Equal(landscape, shared.Sheets.ToDictionary(s => s.Key, s => s.Value.Landscape));
+        }
+        finally
+        {
+            foreach (string path in paths)
+            {
+                File.Delete(path);
+            }
+        }
+    }
+
+    [Fact]
+    public async Task Parallel_FileThatFailsToLoad_CancelsTheFilesBeingPrepared()
+    {
+        // The second file can't be opened, which fails long before the first has been reflowed; the first must
+        // be cancelled rather than reported, and the second file's failure is the one returned.
+        string large = Path.Combine(Path.GetTempPath(), $"wp-print-{Guid.NewGuid():N}.cs");
+        string locked = Path.Combine(Path.GetTempPath(), $"wp-print-{Guid.NewGuid():N}.cs");
+        await File.WriteAllLinesAsync(large, Enumerable.Range(0, 50_000).Select(n => $"int Field{n} = {n};"));
+        await File.WriteAllTextAsync(locked, "class Locked {}\n");
+        try
+        {
+            CommandResult result;
+            await using (new FileStream(locked, FileMode.Open, FileAccess.ReadWrite, FileShare.None))
+            {
+                result = await new PrintCommand().RunAsync(null!, null,
+                    Run([large, locked], ("what-if", "true"), ("parallel", "2")), CancellationToken.None);
+            }
+
+            Assert.Equal(CommandStatus.Error, result.Status);
+            Assert.Equal(nameof(IOException), result.ErrorCode);
+            Assert.DoesNotContain(large, result.Value as string ?? string.Empty);
+        }
+        finally
+        {
+            File.Delete(large);
+            File.Delete(locked);
+        }
+    }
+
+    [Theory]
+    [InlineData("-1")]
+    [InlineData("0")]
+    public async Task Parallel_LessThanOne_IsRejected(string parallel)
+    {
+        CommandResult result = await new PrintCommand()
+            .RunAsync(null!, null, Run(["a.cs"], ("parallel", parallel)), CancellationToken.None);
+
+        Assert.Equal(CommandStatus.Error, result.Status);
+        Assert.Equal("BadOption", result.ErrorCode);
+    }
+
     [Fact]
     public async Task Pdf_AndPrinter_AreMutuallyExclusive()
     {
@@ -107,4 +235,101 @@ public class PrintCommandTests
             File.Delete(b);
         }
     }
+
+    [Fact]
+    public async Task Watch_AndWhatIf_AreMutuallyExclusive()
+    {
+        CommandResult result = await new PrintCommand()
+            .RunAsync(null!, null, Run(["a.log"], ("watch", "true"), ("what-if", "true")), CancellationToken.None);
+
+        Assert.Equal(CommandStatus.Error, result.Status);
+        Assert.Equal("WatchOutput", result.ErrorCode);
+    }
+
+    [Fact]
+    public async Task Watch_RequiresExactlyOneInputFile()
+    {
+        string a = Path.Combine(Path.GetTempPath(), $"wp-print-{Guid.NewGuid():N}.log");
+        string b = Path.Combine(Path.GetTempPath(), $"wp-print-{Guid.NewGuid():N}.log");
+        await File.WriteAllTextAsync(a, "one\n");
+        await File.WriteAllTextAsync(b, "two\n");
+        try
+        {
+            CommandResult result = await new PrintCommand()
+                .RunAsync(null!, null, Run([a, b], ("watch", "true")), CancellationToken.None);
+
+            Assert.Equal(CommandStatus.Error, result.Status);
+            Assert.Equal("WatchOneFile", result.ErrorCode);
+        }
+        finally
+        {
+            File.Delete(a);
+            File.Delete(b);
+        }
+    }
+
+    [Theory]
+    [InlineData(".log", 1L)]
+    [InlineData(".ans", 0L)]
+    public async Task Watch_FileThatCantBeExtendedInPlace_PrintsOnlyTheNewSheets(string extension,
+        long streamingThresholdBytes)
+    {
+        // A file streamed from disk (over the threshold) and an ANSI file are loaded again as they grow; the
+        // sheets already printed must not print again.
+        string path = Path.Combine(Path.GetTempPath(), $"wp-print-{Guid.NewGuid():N}{extension}");
+        await File.WriteAllLinesAsync(path, Enumerable.Range(0, 300).Select(n => $"line {n}"));
+        var service = new FakePrintService("Test Printer");
+        var context = SettingsContext.Create(new Options { Files = [path], Printer = "Test Printer" }, service);
+        Settings settings = WinPrintServices.Current.Settings;
+        long threshold = settings.StreamingThresholdBytes;
+        settings.StreamingThresholdBytes = streamingThresholdBytes;
+        try
+        {
+            Assert.True(await context.App.LoadFileAsync(path));
+            (PrintRequest? request, PrintPlan plan) = await PrintOrchestrator.PrepareAsync(service, context);
+            Assert.NotNull(request);
+
+            // Each wait for a change appends more lines; the third stops the command.
+            using var stop = new CancellationTokenSource();
+            int appends = 0;
+            var output = new StringBuilder();
+            int printed = await PrintCommand.FollowAndPrintAsync(service, request, plan, path, async token =>
+            {
+                if (++appends > 2)
+                {
+                    await stop.CancelAsync();
+                    token.ThrowIfCancellationRequested();
+                }
+
+                await File.AppendAllLinesAsync(path, Enumerable.Range(0, 300).Select(n => $"more {appends}.{n}"),
+                    token);
+            }, output, stop.Token);
+
+            // Every sheet printed exactly once and in order: each job starts after the previous one.
+            int[][] ranges =
+            [
+                .. Regex.Matches(output.ToString(), @"printed sheet\(s\) (\d+)-(\d+)").Select(m => new[]
+                {
+                    int.Parse(m.Groups[1].Value, CultureInfo.InvariantCulture),
+                    int.Parse(m.Groups[2].Value, CultureInfo.InvariantCulture)
+                })
+            ];
+            Assert.True(ranges.Length > 1, output.ToString());
+            int next = 1;
+            foreach (int[] range in ranges)
+            {
+                Assert.Equal(next, range[0]);
+                next = range[1] + 1;
+            }
+
+            Assert.Equal(request.SheetViewModel.NumSheets, next - 1);
+            Assert.Equal(next - 1, printed);
+            Assert.DoesNotContain("truncated", output.ToString(), StringComparison.Ordinal);
+        }
+        finally
+        {
+            settings.StreamingThresholdBytes = threshold;
+            File.Delete(path);
+        }
+    }
 }